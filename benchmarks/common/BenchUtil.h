@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAS_RDTSC 1
+#endif
+
+// ===========================
+// 基准测试公共工具
+// ===========================
+// 所有 bench_* 程序共享的小工具，刻意保持 header-only 且不依赖第三方库：
+// 1）ReadCycles()      ：读取时间戳计数器（x86 上为 rdtsc，其余平台退化为纳秒）
+// 2）DoNotOptimize()   ：阻止编译器把被测调用当成死代码消除
+// 3）SpinBarrier       ：让所有线程在同一时刻开始，制造真正的并发竞争
+// 4）RunThroughput()   ：N 线程在固定时长内反复调用被测函数，统计吞吐
+// 5）Percentile()      ：计算 p50/p99 等延迟分位数
+// 6）Options           ：解析 --threads=N --ms=M 等简单命令行参数
+//
+// 注意：rdtsc 读到的是“参考周期”（TSC 频率恒定），并非核心实际频率下的周期数，
+// 但用于横向对比同一台机器上的不同实现已经足够。
+namespace bench {
+
+// 读取周期计数器
+inline std::uint64_t ReadCycles() {
+#if defined(BENCH_HAS_RDTSC)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+// 标定：每纳秒多少个计数器周期（只标定一次）
+inline double CyclesPerNs() {
+    static const double ratio = [] {
+        auto t0 = std::chrono::steady_clock::now();
+        std::uint64_t c0 = ReadCycles();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::uint64_t c1 = ReadCycles();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        return ns > 0 ? static_cast<double>(c1 - c0) / ns : 1.0;
+    }();
+    return ratio;
+}
+
+// 阻止编译器优化掉被测表达式的结果
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    static volatile const void* sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+inline void ClobberMemory() {
+#if !defined(_MSC_VER)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// 禁止内联：用于导出可以单独反汇编、单独计时的访问函数
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+// 自旋屏障：C++17 没有 std::barrier，这里用原子计数 + 代数实现一次性同步点
+class SpinBarrier {
+public:
+    explicit SpinBarrier(unsigned count) : count_(count), waiting_(0), generation_(0) {}
+
+    void ArriveAndWait() {
+        unsigned gen = generation_.load(std::memory_order_acquire);
+        if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+            waiting_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        while (generation_.load(std::memory_order_acquire) == gen) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    const unsigned count_;
+    std::atomic<unsigned> waiting_;
+    std::atomic<unsigned> generation_;
+};
+
+// 计算分位数（会对输入排序）
+inline double Percentile(std::vector<std::uint64_t>& samples, double pct) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::size_t idx = static_cast<std::size_t>(pct / 100.0 * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(idx),
+                     samples.end());
+    return static_cast<double>(samples[idx]);
+}
+
+inline unsigned HardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// 1, 2, 4, ... 直到 max（max 本身一定包含在内）
+inline std::vector<unsigned> ThreadCounts(unsigned max_threads) {
+    std::vector<unsigned> counts;
+    for (unsigned n = 1; n < max_threads; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// 吞吐测试结果
+struct ThroughputResult {
+    unsigned threads = 0;
+    std::uint64_t total_ops = 0;
+    double seconds = 0.0;
+    double cycles_per_op = 0.0;  // 各线程“周期/次”的平均值
+
+    double OpsPerSecond() const { return seconds > 0 ? static_cast<double>(total_ops) / seconds : 0; }
+};
+
+// N 个线程同时开始，在 duration 内反复执行 op()，每 kBatch 次检查一次停止标志
+template <typename Op>
+ThroughputResult RunThroughput(unsigned threads, std::chrono::milliseconds duration, Op op) {
+    constexpr int kBatch = 256;
+    std::atomic<bool> stop{false};
+    SpinBarrier barrier(threads + 1);
+    std::vector<std::uint64_t> ops(threads, 0);
+    std::vector<std::uint64_t> cycles(threads, 0);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::uint64_t local = 0;
+            barrier.ArriveAndWait();
+            std::uint64_t c0 = ReadCycles();
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < kBatch; ++i) {
+                    op();
+                }
+                local += kBatch;
+            }
+            cycles[t] = ReadCycles() - c0;
+            ops[t] = local;
+        });
+    }
+
+    barrier.ArriveAndWait();
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    ThroughputResult result;
+    result.threads = threads;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    double cpo_sum = 0.0;
+    for (unsigned t = 0; t < threads; ++t) {
+        result.total_ops += ops[t];
+        cpo_sum += ops[t] ? static_cast<double>(cycles[t]) / static_cast<double>(ops[t]) : 0.0;
+    }
+    result.cycles_per_op = cpo_sum / threads;
+    return result;
+}
+
+// 计时器自身开销（两次 ReadCycles 之间的最小差值），用于从单次延迟中扣除
+inline std::uint64_t TimerOverhead() {
+    static const std::uint64_t overhead = [] {
+        std::uint64_t best = ~std::uint64_t{0};
+        for (int i = 0; i < 10000; ++i) {
+            std::uint64_t a = ReadCycles();
+            std::uint64_t b = ReadCycles();
+            best = std::min(best, b - a);
+        }
+        return best;
+    }();
+    return overhead;
+}
+
+// N 个线程同时对 op() 逐次计时，每线程 samples_per_thread 次，返回合并后的样本（周期）
+template <typename Op>
+std::vector<std::uint64_t> RunLatency(unsigned threads, std::size_t samples_per_thread, Op op) {
+    const std::uint64_t overhead = TimerOverhead();
+    SpinBarrier barrier(threads);
+    std::vector<std::vector<std::uint64_t>> per_thread(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto& out = per_thread[t];
+            out.resize(samples_per_thread);
+            barrier.ArriveAndWait();
+            for (std::size_t i = 0; i < samples_per_thread; ++i) {
+                std::uint64_t c0 = ReadCycles();
+                op();
+                std::uint64_t c1 = ReadCycles();
+                std::uint64_t d = c1 - c0;
+                out[i] = d > overhead ? d - overhead : 0;
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    std::vector<std::uint64_t> merged;
+    merged.reserve(threads * samples_per_thread);
+    for (auto& v : per_thread) {
+        merged.insert(merged.end(), v.begin(), v.end());
+    }
+    return merged;
+}
+
+// 简单的命令行参数：--threads=N --ms=M --samples=S，其余参数原样保留给具体程序
+struct Options {
+    unsigned max_threads = HardwareThreads();
+    int duration_ms = 200;
+    std::size_t samples = 20000;
+    std::vector<std::string> positional;
+
+    static Options Parse(int argc, char** argv) {
+        Options opt;
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strncmp(arg, "--threads=", 10) == 0) {
+                opt.max_threads = static_cast<unsigned>(std::max(1, std::atoi(arg + 10)));
+            } else if (std::strncmp(arg, "--ms=", 5) == 0) {
+                opt.duration_ms = std::max(1, std::atoi(arg + 5));
+            } else if (std::strncmp(arg, "--samples=", 10) == 0) {
+                opt.samples = static_cast<std::size_t>(std::max(1, std::atoi(arg + 10)));
+            } else {
+                opt.positional.emplace_back(arg);
+            }
+        }
+        return opt;
+    }
+};
+
+}  // namespace bench
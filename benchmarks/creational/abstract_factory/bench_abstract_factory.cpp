@@ -0,0 +1,113 @@
+#include "../../../src/creational/abstract_factory/AbstractFactory.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+// 抽象工厂基准：虚接口 GUIFactory vs 编译期产品族 RenderUI<Family>
+// ----------------------------------
+// 每个数据点连续绘制 n 套控件（按钮 + 复选框），重复若干次取中位数，报告每套控件的周期数 / 纳秒数。
+// 1）绘制：Paint() 照常写 std::cout，但 std::cout 被换成一个丢弃所有输出的缓冲区，
+//    测到的是“创建 + 分派 + 格式化输出”本身，而不是终端或管道的速度：
+//    - RenderUI(const GUIFactory&)：工厂在运行时选出（编译器看不到具体类型），
+//      2 次虚创建 + 2 次堆分配 + 2 次虚 Paint()；
+//    - RenderUI<Family>()：控件在栈上，Paint() 直接调用；
+//    - SelectRenderUI("windows")：启动时选出的函数指针，每套控件一次间接调用。
+// 2）只创建（不 Paint）：单独比较创建一套控件的开销（堆分配 vs 栈上构造）。
+// 输出只在单线程下测量：自定义的丢弃缓冲区不是线程安全的。
+//
+// 用法：bench_abstract_factory [--n=N] [--samples=S]
+
+namespace {
+
+// 丢弃所有输出的流缓冲区
+class NullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// 重复执行 op（每次绘制 n 套控件），返回每套控件耗时（周期）的中位数
+template <typename Op>
+double MedianCyclesPerSet(std::size_t reps, std::size_t n, Op op) {
+    std::vector<std::uint64_t> samples;
+    samples.reserve(reps);
+    for (std::size_t r = 0; r < reps; ++r) {
+        std::uint64_t c0 = bench::ReadCycles();
+        for (std::size_t i = 0; i < n; ++i) {
+            op();
+        }
+        std::uint64_t c1 = bench::ReadCycles();
+        samples.push_back(c1 - c0);
+    }
+    return bench::Percentile(samples, 50) / static_cast<double>(n);
+}
+
+void PrintRow(const char* name, double cycles_per_set) {
+    std::printf("%-36s %12.1f %10.1f\n", name, cycles_per_set, cycles_per_set / bench::CyclesPerNs());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 1000000;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 4)));
+        }
+    }
+    const std::size_t reps = std::max<std::size_t>(3, opt.samples / 4000);
+    std::printf("bench_abstract_factory: %zu widget sets per run, %zu runs per row (median)\n", n,
+                reps);
+
+    // 运行时选出的工厂：经 volatile 下标取得，编译器无法推断具体类型
+    const WindowsFactory windows_factory;
+    const MacFactory mac_factory;
+    const GUIFactory* factories[2] = {&windows_factory, &mac_factory};
+    volatile int windows_index = 0;
+    volatile int mac_index = 1;
+    const GUIFactory& windows = *factories[windows_index];
+    const GUIFactory& mac = *factories[mac_index];
+    const RenderUIFunction selected = SelectRenderUI("windows");
+
+    NullBuffer null_buffer;
+    std::streambuf* const console = std::cout.rdbuf(&null_buffer);
+
+    const double virtual_windows = MedianCyclesPerSet(reps, n, [&] { RenderUI(windows); });
+    const double virtual_mac = MedianCyclesPerSet(reps, n, [&] { RenderUI(mac); });
+    const double static_windows = MedianCyclesPerSet(reps, n, [] { RenderUI<WindowsFamily>(); });
+    const double static_mac = MedianCyclesPerSet(reps, n, [] { RenderUI<MacFamily>(); });
+    const double startup_selected = MedianCyclesPerSet(reps, n, [selected] { selected(); });
+
+    std::cout.rdbuf(console);
+
+    std::printf("\n== render one widget set (Paint() output discarded) ==\n");
+    std::printf("%-36s %12s %10s\n", "variant", "cycles/set", "ns/set");
+    PrintRow("RenderUI(GUIFactory&) Windows", virtual_windows);
+    PrintRow("RenderUI(GUIFactory&) Mac", virtual_mac);
+    PrintRow("RenderUI<WindowsFamily>()", static_windows);
+    PrintRow("RenderUI<MacFamily>()", static_mac);
+    PrintRow("SelectRenderUI(\"windows\") pointer", startup_selected);
+
+    std::printf("\n== create one widget set (no Paint) ==\n");
+    std::printf("%-36s %12s %10s\n", "variant", "cycles/set", "ns/set");
+    PrintRow("GUIFactory (virtual + heap)", MedianCyclesPerSet(reps, n, [&] {
+        auto button = windows.CreateButton();
+        auto checkbox = windows.CreateCheckbox();
+        bench::DoNotOptimize(button.get());
+        bench::DoNotOptimize(checkbox.get());
+    }));
+    PrintRow("WindowsFamily (static, stack)", MedianCyclesPerSet(reps, n, [] {
+        auto button = WindowsFamily::CreateButton();
+        auto checkbox = WindowsFamily::CreateCheckbox();
+        bench::DoNotOptimize(&button);
+        bench::DoNotOptimize(&checkbox);
+    }));
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "../../../src/creational/abstract_factory/KernelFactory.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// 按指令集选择的内核族：各产品族在本机上的吞吐
+// ----------------------------------
+// 对每个主机支持的产品族（scalar / sse4.2 / avx2 / avx512），分别测四个内核处理一个缓冲区的吞吐（GB/s）：
+// - copy   ：拷贝（scalar 族直接调用 glibc memcpy，它本身也按 CPU 选择实现）；
+// - sum    ：uint32 数组求和；
+// - search ：查找一个不存在的字节（必须扫描整个缓冲区）；
+// - crc32c ：CRC32C（scalar 族查表，其余族使用 SSE4.2 的 crc32 指令）。
+// 缓冲区大小分别落在 L1、L2 与内存中（4 KiB / 256 KiB / 64 MiB）。每个数据点处理约 --mb 兆字节，
+// 重复 5 次取中位数。每个产品族先用 VerifyKernelFamily() 与标量族比对结果，结果列在 verified 列。
+//
+// 用法：bench_kernel_factory [--mb=M]
+
+namespace {
+
+constexpr KernelIsa kFamilies[] = {KernelIsa::kScalar, KernelIsa::kSse42, KernelIsa::kAvx2,
+                                   KernelIsa::kAvx512};
+
+// 反复对 size 字节执行 op，直到处理约 total 字节；返回 5 次中位数对应的 GB/s
+template <typename Op>
+double MedianGBps(std::size_t size, std::size_t total, Op op) {
+    const std::size_t iterations = std::max<std::size_t>(1, total / size);
+    std::vector<std::uint64_t> samples;
+    for (int r = 0; r < 5; ++r) {
+        std::uint64_t c0 = bench::ReadCycles();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        std::uint64_t c1 = bench::ReadCycles();
+        samples.push_back(c1 - c0);
+    }
+    const double ns = bench::Percentile(samples, 50) / bench::CyclesPerNs();
+    return static_cast<double>(size * iterations) / ns;  // 字节/纳秒 = GB/s
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t total_mb = 128;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 5, "--mb=") == 0) {
+            total_mb = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 5)));
+        }
+    }
+    const std::size_t total = total_mb << 20;
+
+    const CpuFeatures& cpu = CpuFeatures::Host();
+    std::printf("bench_kernel_factory: ~%zu MiB per point, median of 5\n", total_mb);
+    std::printf("host: sse4.2=%d avx2=%d avx512(f+bw)=%d, SelectKernelFactory() -> %s\n", cpu.sse42,
+                cpu.avx2, cpu.avx512bw, SelectKernelFactory().Name());
+
+    constexpr std::size_t kSizes[] = {4u << 10, 256u << 10, 64u << 20};
+    const std::size_t max_size = kSizes[sizeof(kSizes) / sizeof(kSizes[0]) - 1];
+    std::vector<std::uint8_t> src(max_size);
+    std::vector<std::uint8_t> dst(max_size);
+    std::vector<std::uint32_t> words(max_size / sizeof(std::uint32_t));
+    std::uint32_t seed = 12345;
+    for (auto& b : src) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<std::uint8_t>((seed >> 24) % 251);  // 不含 255：search 找不到，扫描全部
+    }
+    for (auto& w : words) {
+        seed = seed * 1664525u + 1013904223u;
+        w = seed;
+    }
+
+    for (std::size_t size : kSizes) {
+        std::printf("\n== buffer %zu KiB (GB/s) ==\n", size >> 10);
+        std::printf("%-8s %10s %10s %10s %10s %10s\n", "family", "copy", "sum", "search", "crc32c",
+                    "verified");
+        for (KernelIsa isa : kFamilies) {
+            const KernelFactory* factory = KernelFactoryFor(isa);
+            if (factory == nullptr) {
+                std::printf("%-8s   (not supported on this host)\n", KernelIsaName(isa));
+                continue;
+            }
+            auto copy = factory->CreateCopy();
+            auto sum = factory->CreateSum();
+            auto search = factory->CreateSearch();
+            auto checksum = factory->CreateChecksum();
+            const std::size_t count = size / sizeof(std::uint32_t);
+
+            double copy_gbps = MedianGBps(size, total, [&] {
+                copy->Copy(dst.data(), src.data(), size);
+                bench::ClobberMemory();
+            });
+            double sum_gbps = MedianGBps(size, total, [&] {
+                bench::DoNotOptimize(sum->Sum(words.data(), count));
+            });
+            double search_gbps = MedianGBps(size, total, [&] {
+                bench::DoNotOptimize(search->Find(src.data(), size, 255));
+            });
+            double crc_gbps = MedianGBps(size, total, [&] {
+                bench::DoNotOptimize(checksum->Crc32c(src.data(), size));
+            });
+            std::printf("%-8s %10.2f %10.2f %10.2f %10.2f %10s\n", factory->Name(), copy_gbps,
+                        sum_gbps, search_gbps, crc_gbps, VerifyKernelFamily(*factory) ? "yes" : "NO");
+        }
+    }
+    return 0;
+}
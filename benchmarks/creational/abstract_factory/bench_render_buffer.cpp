@@ -0,0 +1,139 @@
+#include "../../../src/creational/abstract_factory/AbstractFactory.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define BENCH_HAS_DUP2 1
+#endif
+
+// 批量绘制基准：逐个 Paint()（每个控件一次 std::endl 刷新）vs 渲染命令缓冲区 + 一次 Flush()
+// ----------------------------------
+// 每一帧绘制 n 个控件（n/2 套，Windows 与 Mac 产品族交替），n = 1k / 100k / 10M。
+// 测量期间把标准输出（文件描述符 1）重定向到 --out 指定的文件（默认 /dev/null），
+// 因此两种方式都真实地执行写系统调用，差别只在调用次数与每次写入的数据量：
+// - per-widget：RenderUI(const GUIFactory&)，每个控件一次 write；
+// - batched   ：RenderUI(const GUIFactory&, RenderCommandBuffer&) 记录，帧末 Flush() 按输出行
+//               分组，以少量 writev 写出（计时包含记录与提交；缓冲区跨帧复用，不含首次扩容）。
+// 报告每秒绘制的控件数、每帧写系统调用次数，小规模取多次的中位数。
+// /dev/null 的写入几乎不花时间，测到的是系统调用本身的开销；换成普通文件或管道时差距更大。
+//
+// 用法：bench_render_buffer [--max=N] [--out=PATH]
+
+namespace {
+
+struct Result {
+    double widgets_per_second = 0;
+    std::size_t writes = 0;  // 每帧写系统调用次数
+};
+
+// 重复执行 frame（每次绘制 n 个控件），返回中位数对应的控件/秒
+template <typename Frame>
+double MedianWidgetsPerSecond(std::size_t n, std::size_t reps, Frame frame) {
+    std::vector<std::uint64_t> samples;
+    samples.reserve(reps);
+    for (std::size_t r = 0; r < reps; ++r) {
+        std::uint64_t c0 = bench::ReadCycles();
+        frame();
+        std::uint64_t c1 = bench::ReadCycles();
+        samples.push_back(c1 - c0);
+    }
+    const double ns = bench::Percentile(samples, 50) / bench::CyclesPerNs();
+    return static_cast<double>(n) / ns * 1e9;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t max_widgets = 10000000;
+    std::string out_path = "/dev/null";
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 6, "--max=") == 0) {
+            max_widgets = static_cast<std::size_t>(std::max(2L, std::atol(arg.c_str() + 6)));
+        } else if (arg.compare(0, 6, "--out=") == 0) {
+            out_path = arg.substr(6);
+        }
+    }
+
+#if defined(BENCH_HAS_DUP2)
+    const int target = open(out_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (target < 0) {
+        std::printf("cannot open %s\n", out_path.c_str());
+        return 1;
+    }
+    std::printf("bench_render_buffer: stdout redirected to %s while measuring\n", out_path.c_str());
+    std::fflush(stdout);
+    const int console = dup(STDOUT_FILENO);
+
+    const WindowsFactory windows_factory;
+    const MacFactory mac_factory;
+    const GUIFactory* factories[2] = {&windows_factory, &mac_factory};
+
+    constexpr std::size_t kSizes[] = {1000, 100000, 10000000};
+    std::vector<std::size_t> sizes;
+    std::vector<Result> per_widget;
+    std::vector<Result> batched;
+    RenderCommandBuffer commands;
+    for (std::size_t n : kSizes) {
+        if (n > max_widgets) {
+            continue;
+        }
+        const std::size_t sets = n / 2;
+        const std::size_t reps = std::clamp<std::size_t>(1000000 / n, 1, 101);
+        commands.Reserve(n);
+        // 每个规模开始前截断：输出到普通文件时不会越写越大
+        if (ftruncate(target, 0) != 0 && out_path != "/dev/null") {
+            std::fprintf(stderr, "cannot truncate %s\n", out_path.c_str());
+        }
+        dup2(target, STDOUT_FILENO);
+
+        Result direct;
+        direct.writes = n;  // 每个控件一次 std::endl 刷新
+        direct.widgets_per_second = MedianWidgetsPerSecond(n, reps, [&] {
+            for (std::size_t i = 0; i < sets; ++i) {
+                RenderUI(*factories[i & 1]);
+            }
+        });
+
+        Result buffered;
+        buffered.widgets_per_second = MedianWidgetsPerSecond(n, reps, [&] {
+            for (std::size_t i = 0; i < sets; ++i) {
+                RenderUI(*factories[i & 1], commands);
+            }
+            buffered.writes = commands.Flush().writes;
+        });
+
+        std::cout.flush();
+        dup2(console, STDOUT_FILENO);
+        sizes.push_back(n);
+        per_widget.push_back(direct);
+        batched.push_back(buffered);
+    }
+    close(console);
+    close(target);
+
+    std::printf("\n== paint n widgets per frame ==\n");
+    std::printf("%-12s %-12s %16s %14s %10s\n", "widgets", "variant", "Mwidgets/s", "writes/frame",
+                "speedup");
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        std::printf("%-12zu %-12s %16.2f %14zu %10s\n", sizes[i], "per-widget",
+                    per_widget[i].widgets_per_second / 1e6, per_widget[i].writes, "1.0x");
+        std::printf("%-12zu %-12s %16.2f %14zu %9.1fx\n", sizes[i], "batched",
+                    batched[i].widgets_per_second / 1e6, batched[i].writes,
+                    batched[i].widgets_per_second / per_widget[i].widgets_per_second);
+    }
+#else
+    (void)max_widgets;
+    std::printf("bench_render_buffer: stdout redirection not supported on this platform\n");
+#endif
+    return 0;
+}
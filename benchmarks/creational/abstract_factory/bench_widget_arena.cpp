@@ -0,0 +1,159 @@
+#include "../../../src/creational/abstract_factory/AbstractFactory.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// 按帧分配基准：每帧重建整屏控件，堆分配 vs arena
+// ----------------------------------
+// 每一帧用 GUIFactory 创建 sets 套控件（按钮 + 复选框，Windows 与 Mac 交替），保存在容器里，
+// 然后整体拆除；sets = 100 / 1k / 10k（即 200 / 2k / 20k 个控件）。
+// - heap         ：CreateButton() / CreateCheckbox()，std::vector<std::unique_ptr<...>>，逐个 delete；
+// - arena(grow)  ：BuildUI() + monotonic_buffer_resource（无初始缓冲区，按几何级数向堆申请大块），
+//                  帧末销毁控件树后 release()；
+// - arena(reused)：同上，但 arena 使用一块跨帧复用的初始缓冲区，稳定状态下不再向堆申请。
+// 报告每帧耗时（中位数）、每个控件的纳秒数、每帧的堆分配次数（替换全局 operator new 计数）。
+//
+// 用法：bench_widget_arena [--frames=F]
+
+namespace {
+
+std::atomic<std::size_t> g_heap_allocations{0};
+
+struct FrameResult {
+    double frame_us = 0;
+    double allocations = 0;  // 每帧堆分配次数
+};
+
+// 执行 frames 帧，返回每帧耗时中位数与平均堆分配次数
+template <typename Frame>
+FrameResult RunFrames(std::size_t frames, Frame frame) {
+    frame();  // 预热：让容器与 arena 的初始状态稳定
+    std::vector<std::uint64_t> samples;
+    samples.reserve(frames);
+    const std::size_t allocations0 = g_heap_allocations.load(std::memory_order_relaxed);
+    for (std::size_t f = 0; f < frames; ++f) {
+        std::uint64_t c0 = bench::ReadCycles();
+        frame();
+        std::uint64_t c1 = bench::ReadCycles();
+        samples.push_back(c1 - c0);
+    }
+    const std::size_t allocations1 = g_heap_allocations.load(std::memory_order_relaxed);
+    FrameResult result;
+    result.frame_us = bench::Percentile(samples, 50) / bench::CyclesPerNs() / 1000.0;
+    result.allocations = static_cast<double>(allocations1 - allocations0) / frames;
+    return result;
+}
+
+void PrintRow(std::size_t sets, const char* name, const FrameResult& r, const FrameResult& heap) {
+    std::printf("%-8zu %-16s %12.2f %12.1f %14.1f %9.1fx\n", sets * 2, name, r.frame_us,
+                r.frame_us * 1000.0 / static_cast<double>(sets * 2), r.allocations,
+                heap.frame_us / r.frame_us);
+}
+
+}  // namespace
+
+// 统计堆分配次数（std::pmr::new_delete_resource 也经由这里）
+void* operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t frames = 200;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 9, "--frames=") == 0) {
+            frames = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 9)));
+        }
+    }
+    std::printf("bench_widget_arena: %zu frames per row (median frame time)\n", frames);
+
+    const WindowsFactory windows_factory;
+    const MacFactory mac_factory;
+    const GUIFactory* factories[2] = {&windows_factory, &mac_factory};
+    volatile int platform = 0;  // 运行时选择产品族，编译器无法推断具体类型
+
+    std::printf("\n== rebuild the whole widget tree every frame ==\n");
+    std::printf("%-8s %-16s %12s %12s %14s %10s\n", "widgets", "variant", "frame(us)", "ns/widget",
+                "heap allocs", "speedup");
+    constexpr std::size_t kSets[] = {100, 1000, 10000};
+    for (std::size_t sets : kSets) {
+        // heap：每个控件一次堆分配，容器自身也在堆上
+        FrameResult heap = RunFrames(frames, [&] {
+            std::vector<std::unique_ptr<Button>> buttons;
+            std::vector<std::unique_ptr<Checkbox>> checkboxes;
+            buttons.reserve(sets);
+            checkboxes.reserve(sets);
+            for (std::size_t i = 0; i < sets; ++i) {
+                const GUIFactory& factory = *factories[(platform + i) & 1];
+                buttons.push_back(factory.CreateButton());
+                checkboxes.push_back(factory.CreateCheckbox());
+            }
+            bench::DoNotOptimize(buttons.data());
+            bench::DoNotOptimize(checkboxes.data());
+        });
+        PrintRow(sets, "heap", heap, heap);
+
+        // arena(grow)：每帧一个新的 monotonic_buffer_resource，大块内存向堆申请
+        FrameResult grow = RunFrames(frames, [&] {
+            std::pmr::monotonic_buffer_resource arena;
+            {
+                ArenaUI ui(arena);
+                ui.buttons.reserve(sets);
+                ui.checkboxes.reserve(sets);
+                for (std::size_t i = 0; i < sets; ++i) {
+                    const GUIFactory& factory = *factories[(platform + i) & 1];
+                    ui.buttons.push_back(factory.CreateButtonIn(arena));
+                    ui.checkboxes.push_back(factory.CreateCheckboxIn(arena));
+                }
+                bench::DoNotOptimize(ui.buttons.data());
+            }
+        });
+        PrintRow(sets, "arena(grow)", grow, heap);
+
+        // arena(reused)：初始缓冲区跨帧复用，release() 后从头开始
+        std::vector<unsigned char> storage(sets * 96);  // 每套：两个控件 + 两个 ArenaPtr
+        std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size());
+        FrameResult reused = RunFrames(frames, [&] {
+            {
+                ArenaUI ui(arena);
+                ui.buttons.reserve(sets);
+                ui.checkboxes.reserve(sets);
+                for (std::size_t i = 0; i < sets; ++i) {
+                    const GUIFactory& factory = *factories[(platform + i) & 1];
+                    ui.buttons.push_back(factory.CreateButtonIn(arena));
+                    ui.checkboxes.push_back(factory.CreateCheckboxIn(arena));
+                }
+                bench::DoNotOptimize(ui.buttons.data());
+            }
+            arena.release();
+        });
+        PrintRow(sets, "arena(reused)", reused, heap);
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "../../../src/creational/builder/Builder.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// 建造者基准：批量生成电脑配置，Director::Construct vs 紧凑产品 + 驻留组件
+// ----------------------------------
+// 每轮生成 n 台电脑（游戏 / 办公交替，或各占一半），保存在容器中；重复 5 轮取中位数。
+// - Director::Construct       ：每台一个 GamingComputerBuilder / OfficeComputerBuilder，
+//                               make_unique<Computer> + 4 次字符串赋值，保存 unique_ptr；
+// - CompactDirector::Construct：同样逐台构建，写入预先分配的 std::vector<CompactComputer>；
+// - CompactDirector::ConstructMany：每种配置只构建一台，其余按值复制；
+// - CompactDirector::ConstructInArena：同上，存储来自 monotonic_buffer_resource。
+// 报告每秒构建的台数，以及每台的字节数 = 本轮堆上申请的总字节数 / n
+// （包括容器与产品本身；替换全局 operator new 统计，不含 malloc 自身的管理开销）。
+// 计时只包含构建，不包含拆除。
+//
+// 用法：bench_builder [--n=N]
+
+namespace {
+
+std::atomic<std::size_t> g_heap_bytes{0};
+
+struct Result {
+    double objects_per_second = 0;
+    double bytes_per_object = 0;
+};
+
+// 执行 5 轮 build（每轮返回需要在计时之后销毁的结果），返回中位数
+template <typename Build>
+Result Measure(std::size_t n, Build build) {
+    std::vector<std::uint64_t> samples;
+    std::size_t bytes = 0;
+    for (int r = 0; r < 5; ++r) {
+        const std::size_t bytes0 = g_heap_bytes.load(std::memory_order_relaxed);
+        std::uint64_t c0 = bench::ReadCycles();
+        auto built = build();
+        std::uint64_t c1 = bench::ReadCycles();
+        bytes = g_heap_bytes.load(std::memory_order_relaxed) - bytes0;
+        bench::DoNotOptimize(&built);
+        samples.push_back(c1 - c0);
+    }
+    Result result;
+    const double ns = bench::Percentile(samples, 50) / bench::CyclesPerNs();
+    result.objects_per_second = static_cast<double>(n) / ns * 1e9;
+    result.bytes_per_object = static_cast<double>(bytes) / static_cast<double>(n);
+    return result;
+}
+
+void PrintRow(const char* name, const Result& r, const Result& baseline) {
+    std::printf("%-36s %14.2f %14.1f %9.1fx\n", name, r.objects_per_second / 1e6, r.bytes_per_object,
+                r.objects_per_second / baseline.objects_per_second);
+}
+
+}  // namespace
+
+// 统计堆上申请的字节数（std::pmr::new_delete_resource 也经由这里）
+void* operator new(std::size_t size) {
+    g_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 1000000;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(2L, std::atol(arg.c_str() + 4)));
+        }
+    }
+    std::printf("bench_builder: %zu computers per run, median of 5 runs\n", n);
+    std::printf("sizeof(Computer) = %zu, sizeof(CompactComputer) = %zu\n", sizeof(Computer),
+                sizeof(CompactComputer));
+
+    Director director;
+    CompactDirector compact_director;
+    const CompactGamingComputerBuilder compact_gaming;
+    const CompactOfficeComputerBuilder compact_office;
+    const CompactComputerBuilder* compact_builders[2] = {&compact_gaming, &compact_office};
+
+    std::printf("\n== build n computers ==\n");
+    std::printf("%-36s %14s %14s %10s\n", "path", "Mobjects/s", "bytes/object", "speedup");
+
+    Result baseline = Measure(n, [&] {
+        std::vector<std::unique_ptr<Computer>> computers;
+        computers.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i & 1) {
+                OfficeComputerBuilder builder;
+                director.Construct(builder);
+                computers.push_back(builder.GetResult());
+            } else {
+                GamingComputerBuilder builder;
+                director.Construct(builder);
+                computers.push_back(builder.GetResult());
+            }
+        }
+        return computers;
+    });
+    PrintRow("Director::Construct", baseline, baseline);
+
+    PrintRow("CompactDirector::Construct", Measure(n, [&] {
+                 std::vector<CompactComputer> computers(n);
+                 for (std::size_t i = 0; i < n; ++i) {
+                     compact_director.Construct(*compact_builders[i & 1], computers[i]);
+                 }
+                 return computers;
+             }),
+             baseline);
+
+    PrintRow("CompactDirector::ConstructMany", Measure(n, [&] {
+                 std::vector<CompactComputer> computers(n);
+                 compact_director.ConstructMany(compact_gaming, computers.data(), n / 2);
+                 compact_director.ConstructMany(compact_office, computers.data() + n / 2,
+                                                n - n / 2);
+                 return computers;
+             }),
+             baseline);
+
+    PrintRow("CompactDirector::ConstructInArena", Measure(n, [&] {
+                 auto arena = std::make_unique<std::pmr::monotonic_buffer_resource>();
+                 CompactComputer* gaming = compact_director.ConstructInArena(compact_gaming, n / 2, *arena);
+                 CompactComputer* office =
+                     compact_director.ConstructInArena(compact_office, n - n / 2, *arena);
+                 bench::DoNotOptimize(gaming);
+                 bench::DoNotOptimize(office);
+                 return arena;
+             }),
+             baseline);
+    return 0;
+}
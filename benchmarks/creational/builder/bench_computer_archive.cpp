@@ -0,0 +1,194 @@
+#include "../../../src/creational/builder/ComputerArchive.h"
+#include "../../../src/creational/builder/ParallelDirector.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 二进制存档基准：启动时载入 n 条电脑配置（默认 1000 万条）
+// ----------------------------------
+// 目录中每个字段从 64 个组件名中随机选取，先分别写成文本文件（每行四个字段，以 Tab 分隔）与
+// 二进制存档（ComputerArchiveWriter），再比较各种“得到 n 台电脑”的方式，每行取 3 次的中位数：
+// - Director::Construct            ：用原有建造者逐台构建（游戏 / 办公交替），不读文件；
+// - CompactDirector (specs)        ：SpecComputerBuilder 从内存中的规格构建 CompactComputer；
+// - text: parse into Computer      ：逐行读取文本文件并拆分字段，构建 std::vector<Computer>；
+// - archive: Open                  ：mmap 存档并校验文件头（不访问记录）；
+// - archive: Open + scan views     ：打开后遍历全部 ComputerView（只读 string_view，不复制）；
+// - archive: Open + Materialize    ：打开后把每条视图复制成 Computer。
+// 文件刚写完，位于页缓存中（测的是热启动；冷启动还要加上从磁盘读取需要访问的页）。
+// 计时不包含结果的析构。
+//
+// 用法：bench_computer_archive [--n=N] [--dir=DIR]
+
+namespace {
+
+// 执行 3 次 load（返回值在计时之后析构），返回中位数（毫秒）
+template <typename Load>
+double MedianMs(Load load) {
+    std::vector<std::uint64_t> samples;
+    for (int r = 0; r < 3; ++r) {
+        std::uint64_t c0 = bench::ReadCycles();
+        auto loaded = load();
+        std::uint64_t c1 = bench::ReadCycles();
+        bench::DoNotOptimize(&loaded);
+        samples.push_back(c1 - c0);
+    }
+    return bench::Percentile(samples, 50) / bench::CyclesPerNs() / 1e6;
+}
+
+// n 为 0 表示这一行不逐条访问记录，不计算每条的耗时
+void PrintRow(const char* name, double ms, std::size_t n) {
+    if (n == 0) {
+        std::printf("%-34s %12.3f %12s %14s\n", name, ms, "-", "-");
+        return;
+    }
+    std::printf("%-34s %12.3f %12.1f %14.2f\n", name, ms, ms * 1e6 / static_cast<double>(n),
+                static_cast<double>(n) / ms / 1e3);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 10000000;
+    std::string dir = "/tmp";
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(1L, std::atol(arg.c_str() + 4)));
+        } else if (arg.compare(0, 6, "--dir=") == 0) {
+            dir = arg.substr(6);
+        }
+    }
+    const std::string text_path = dir + "/bench_computer_archive.txt";
+    const std::string archive_path = dir + "/bench_computer_archive.bin";
+
+    std::vector<ComputerSpec> specs(n);
+    std::uint32_t seed = 12345;
+    auto pick = [&seed](const char* prefix) {
+        seed = seed * 1664525u + 1013904223u;
+        return std::string(prefix) + std::to_string((seed >> 16) % 64);
+    };
+    for (ComputerSpec& spec : specs) {
+        spec.cpu = pick("Catalog CPU ");
+        spec.gpu = pick("Catalog GPU ");
+        spec.ram = pick("RAM ");
+        spec.storage = pick("Storage ");
+    }
+    {
+        std::ofstream text(text_path, std::ios::binary | std::ios::trunc);
+        ComputerArchiveWriter writer;
+        writer.Reserve(n);
+        for (const ComputerSpec& spec : specs) {
+            text << spec.cpu << '\t' << spec.gpu << '\t' << spec.ram << '\t' << spec.storage << '\n';
+            writer.Add(Computer{spec.cpu, spec.gpu, spec.ram, spec.storage});
+        }
+        if (!text || !writer.WriteFile(archive_path)) {
+            std::printf("cannot write %s or %s\n", text_path.c_str(), archive_path.c_str());
+            return 1;
+        }
+    }
+    std::ifstream text_size(text_path, std::ios::binary | std::ios::ate);
+    std::ifstream archive_size(archive_path, std::ios::binary | std::ios::ate);
+    std::printf("bench_computer_archive: %zu records, median of 3, warm page cache\n", n);
+    std::printf("text file: %.1f MiB, archive: %.1f MiB\n",
+                static_cast<double>(text_size.tellg()) / (1 << 20),
+                static_cast<double>(archive_size.tellg()) / (1 << 20));
+
+    std::printf("\n== load n computers ==\n");
+    std::printf("%-34s %12s %12s %14s\n", "path", "total(ms)", "ns/record", "Mrecords/s");
+
+    PrintRow("Director::Construct", MedianMs([&] {
+                 Director director;
+                 std::vector<std::unique_ptr<Computer>> computers;
+                 computers.reserve(n);
+                 for (std::size_t i = 0; i < n; ++i) {
+                     if (i & 1) {
+                         OfficeComputerBuilder builder;
+                         director.Construct(builder);
+                         computers.push_back(builder.GetResult());
+                     } else {
+                         GamingComputerBuilder builder;
+                         director.Construct(builder);
+                         computers.push_back(builder.GetResult());
+                     }
+                 }
+                 return computers;
+             }),
+             n);
+
+    PrintRow("CompactDirector (specs)", MedianMs([&] {
+                 CompactDirector director;
+                 SpecComputerBuilder builder;
+                 std::vector<CompactComputer> computers(n);
+                 for (std::size_t i = 0; i < n; ++i) {
+                     builder.Reset(specs[i]);
+                     director.Construct(builder, computers[i]);
+                 }
+                 return computers;
+             }),
+             n);
+
+    PrintRow("text: parse into Computer", MedianMs([&] {
+                 std::vector<Computer> computers;
+                 computers.reserve(n);
+                 std::ifstream file(text_path, std::ios::binary);
+                 std::string line;
+                 while (std::getline(file, line)) {
+                     Computer computer;
+                     std::size_t a = line.find('\t');
+                     std::size_t b = line.find('\t', a + 1);
+                     std::size_t c = line.find('\t', b + 1);
+                     computer.cpu.assign(line, 0, a);
+                     computer.gpu.assign(line, a + 1, b - a - 1);
+                     computer.ram.assign(line, b + 1, c - b - 1);
+                     computer.storage.assign(line, c + 1, std::string::npos);
+                     computers.push_back(std::move(computer));
+                 }
+                 return computers;
+             }),
+             n);
+
+    PrintRow("archive: Open", MedianMs([&] {
+                 auto archive = std::make_unique<ComputerArchive>();
+                 if (!archive->Open(archive_path)) {
+                     std::printf("open failed: %s\n", archive->Error().c_str());
+                 }
+                 return archive;
+             }),
+             0);
+
+    PrintRow("archive: Open + scan views", MedianMs([&] {
+                 auto archive = std::make_unique<ComputerArchive>();
+                 archive->Open(archive_path);
+                 std::size_t bytes = 0;
+                 for (std::size_t i = 0; i < archive->Size(); ++i) {
+                     ComputerView view = (*archive)[i];
+                     bytes += view.cpu.size() + view.gpu.size() + view.ram.size() + view.storage.size();
+                 }
+                 bench::DoNotOptimize(bytes);
+                 return archive;
+             }),
+             n);
+
+    PrintRow("archive: Open + Materialize", MedianMs([&] {
+                 ComputerArchive archive;
+                 archive.Open(archive_path);
+                 std::vector<Computer> computers;
+                 computers.reserve(archive.Size());
+                 for (std::size_t i = 0; i < archive.Size(); ++i) {
+                     computers.push_back(archive[i].Materialize());
+                 }
+                 return computers;
+             }),
+             n);
+
+    std::remove(text_path.c_str());
+    std::remove(archive_path.c_str());
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "../../../src/creational/builder/ParallelDirector.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// 并行指挥者基准：把一份配置目录物化成 CompactComputer，1 个线程到全部核心
+// ----------------------------------
+// 目录有 n 条规格（默认 100 万），每个字段从 64 个不同的组件名中随机选取。每个数据点重复 5 次取中位数。
+// - sequential, builder per spec：单线程，每条规格新建一个 SpecComputerBuilder（缓存不复用，
+//                                 每个组件都要查全局驻留表）；
+// - sequential, reused builder   ：单线程，一个建造者处理全部规格；
+// - ParallelDirector(t)          ：t 个线程（含调用线程），每个线程复用自己的建造者，工作窃取分配下标。
+// 报告每秒构建的台数、相对 1 个线程的加速比、并行效率（加速比 / 线程数）与窃取次数。
+//
+// 用法：bench_parallel_director [--threads=N] [--n=N]
+
+namespace {
+
+// 执行 5 次 op，返回中位数对应的台/秒
+template <typename Op>
+double MedianObjectsPerSecond(std::size_t n, Op op) {
+    std::vector<std::uint64_t> samples;
+    for (int r = 0; r < 5; ++r) {
+        std::uint64_t c0 = bench::ReadCycles();
+        op();
+        std::uint64_t c1 = bench::ReadCycles();
+        samples.push_back(c1 - c0);
+    }
+    const double ns = bench::Percentile(samples, 50) / bench::CyclesPerNs();
+    return static_cast<double>(n) / ns * 1e9;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 1000000;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(1L, std::atol(arg.c_str() + 4)));
+        }
+    }
+    std::printf("bench_parallel_director: %zu specs, max threads = %u, median of 5\n", n,
+                opt.max_threads);
+
+    std::vector<ComputerSpec> specs(n);
+    std::uint32_t seed = 12345;
+    auto pick = [&seed](const char* prefix) {
+        seed = seed * 1664525u + 1013904223u;
+        return std::string(prefix) + std::to_string((seed >> 16) % 64);
+    };
+    for (ComputerSpec& spec : specs) {
+        spec.cpu = pick("Catalog CPU ");
+        spec.gpu = pick("Catalog GPU ");
+        spec.ram = pick("RAM ");
+        spec.storage = pick("Storage ");
+    }
+    std::vector<CompactComputer> out(n);
+    const CompactDirector director;
+
+    std::printf("\n== materialize the catalog ==\n");
+    std::printf("%-32s %12s %10s %11s %10s\n", "path", "Mobjects/s", "speedup", "efficiency",
+                "steals");
+
+    const double fresh = MedianObjectsPerSecond(n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            SpecComputerBuilder builder;
+            builder.Reset(specs[i]);
+            director.Construct(builder, out[i]);
+        }
+        bench::ClobberMemory();
+    });
+    std::printf("%-32s %12.2f %10s %11s %10s\n", "sequential, builder per spec", fresh / 1e6, "-",
+                "-", "-");
+
+    const double reused = MedianObjectsPerSecond(n, [&] {
+        SpecComputerBuilder builder;
+        for (std::size_t i = 0; i < n; ++i) {
+            builder.Reset(specs[i]);
+            director.Construct(builder, out[i]);
+        }
+        bench::ClobberMemory();
+    });
+    std::printf("%-32s %12.2f %10s %11s %10s\n", "sequential, reused builder", reused / 1e6, "-",
+                "-", "-");
+
+    double single = 0;
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        ParallelDirector parallel(threads);
+        std::size_t steals = 0;
+        const double rate = MedianObjectsPerSecond(n, [&] {
+            steals = parallel.Construct(specs.data(), n, out.data()).steals;
+        });
+        if (threads == 1) {
+            single = rate;
+        }
+        char name[64];
+        std::snprintf(name, sizeof(name), "ParallelDirector(%u)", threads);
+        std::printf("%-32s %12.2f %9.2fx %10.0f%% %10zu\n", name, rate / 1e6, rate / single,
+                    rate / single / threads * 100.0, steals);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "../../../src/creational/factory_method/FactoryMethod.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+// 批量创建基准：逐个 CreateProduct() vs CreateBatch(n)（连续存储）
+// ----------------------------------
+// 被测产品带 48 字节负载，Use() 只递增一个计数器，衡量的是创建与遍历本身的开销。
+// 1）创建 + 销毁 n 个产品（每行报告平均每个产品的周期数）：
+//    - make_unique 循环：n 次全局分配；
+//    - CreateProduct() 循环：n 次虚函数调用 + 对象池分配；
+//    - CreateBatch(n)：一次分配，连续构造。
+// 2）遍历 n 个已创建的产品并调用 Use()：
+//    - 分散：逐个 make_unique，期间穿插大小随机的其他分配并打乱顺序，模拟长时间运行后碎片化的堆；
+//    - 连续 + 虚调用：range-for 遍历批次，每个元素一次虚函数调用；
+//    - 连续 + UseAll()：已知具体类型，直接调用 T::Use()，编译器可以内联并展开循环。
+//
+// 用法：bench_product_batch [--samples=S] [--n=N]
+
+namespace {
+
+class CounterProduct final : public Product {
+public:
+    void Use() override { ++uses; }
+
+    std::uint64_t uses = 0;
+    char payload[48] = {};
+};
+
+class CounterCreator : public Creator {
+public:
+    ProductPtr CreateProduct() const override { return MakePooledProduct<CounterProduct>(); }
+
+    ProductBatch CreateBatch(std::size_t n) const override {
+        return ProductBatch::Create<CounterProduct>(n);
+    }
+};
+
+// 重复执行 op，返回每次耗时（周期）的中位数除以 n
+template <typename Op>
+double MedianCyclesPerItem(std::size_t reps, std::size_t n, Op op) {
+    std::vector<std::uint64_t> samples;
+    samples.reserve(reps);
+    for (std::size_t r = 0; r < reps; ++r) {
+        std::uint64_t c0 = bench::ReadCycles();
+        op();
+        std::uint64_t c1 = bench::ReadCycles();
+        samples.push_back(c1 - c0);
+    }
+    return bench::Percentile(samples, 50) / static_cast<double>(n);
+}
+
+void PrintRow(const char* name, double cycles_per_item) {
+    std::printf("%-34s %14.2f %12.2f\n", name, cycles_per_item,
+                cycles_per_item / bench::CyclesPerNs());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 4096;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 4)));
+        }
+    }
+    const std::size_t reps = std::max<std::size_t>(16, opt.samples / 100);
+    std::printf("bench_product_batch: %zu products per batch, %zu repetitions per row (median)\n",
+                n, reps);
+
+    const CounterCreator creator;
+    const Creator& base = creator;
+
+    std::printf("\n== create + destroy %zu products ==\n", n);
+    std::printf("%-34s %14s %12s\n", "method", "cycles/product", "ns/product");
+    PrintRow("make_unique loop", MedianCyclesPerItem(reps, n, [&] {
+        std::vector<std::unique_ptr<Product>> products;
+        products.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            products.push_back(std::make_unique<CounterProduct>());
+        }
+        bench::DoNotOptimize(products.data());
+    }));
+    PrintRow("CreateProduct() loop (pooled)", MedianCyclesPerItem(reps, n, [&] {
+        std::vector<ProductPtr> products;
+        products.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            products.push_back(base.CreateProduct());
+        }
+        bench::DoNotOptimize(products.data());
+    }));
+    PrintRow("CreateBatch(n)", MedianCyclesPerItem(reps, n, [&] {
+        ProductBatch batch = base.CreateBatch(n);
+        bench::DoNotOptimize(&batch);
+    }));
+
+    // 分散的产品：穿插随机大小的分配后打乱顺序
+    std::mt19937 rng(42);
+    std::vector<std::unique_ptr<Product>> scattered;
+    std::vector<std::unique_ptr<char[]>> filler;
+    for (std::size_t i = 0; i < n; ++i) {
+        scattered.push_back(std::make_unique<CounterProduct>());
+        filler.push_back(std::make_unique<char[]>(16 + rng() % 512));
+    }
+    std::shuffle(scattered.begin(), scattered.end(), rng);
+    ProductBatch batch = base.CreateBatch(n);
+
+    std::printf("\n== call Use() on %zu products ==\n", n);
+    std::printf("%-34s %14s %12s\n", "layout", "cycles/product", "ns/product");
+    PrintRow("scattered, virtual Use()", MedianCyclesPerItem(reps, n, [&] {
+        for (auto& product : scattered) {
+            product->Use();
+        }
+        bench::ClobberMemory();
+    }));
+    PrintRow("contiguous, virtual Use()", MedianCyclesPerItem(reps, n, [&] {
+        for (Product& product : batch) {
+            product.Use();
+        }
+        bench::ClobberMemory();
+    }));
+    PrintRow("contiguous, UseAll()", MedianCyclesPerItem(reps, n, [&] {
+        batch.UseAll();
+        bench::ClobberMemory();
+    }));
+    return 0;
+}
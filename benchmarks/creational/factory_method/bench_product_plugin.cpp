@@ -0,0 +1,169 @@
+#include "../../../src/creational/factory_method/ProductPlugin.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCH_HAS_FORK 1
+#endif
+
+// 插件延迟加载基准：启动阶段注册耗时、首次创建耗时、稳定后的创建开销
+// ----------------------------------
+// 插件 factory_method_plugin 在加载时由静态构造函数填充一张约 2 MiB 的表，模拟真实插件的
+// 代码与静态数据。
+// 1）冷启动（每次一个 fork 出来的新进程，插件尚未加载，取 --runs 次的中位数）：
+//    - eager：启动时 LoadProductPlugin() —— dlopen + 静态初始化 + 注册全部类型；
+//    - lazy ：启动时 RegisterProductPlugin() —— 只插入占位条目；
+//    以及随后第一次 Create("plugin.D") 的耗时（lazy 时包含 dlopen）。
+// 2）热路径（注册表已冻结，插件已解析）：内置类型与延迟注册的插件类型按句柄 / TypeKey 创建。
+//    占位条目在首次创建后已换成直接的工厂函数，查表部分完全相同；剩下的少量差别来自插件内部的
+//    位置无关代码（对象池单例经 GOT 访问、工厂通过函数指针调用，无法内联）。
+//
+// 用法：bench_product_plugin [--threads=N] [--ms=M] [--samples=S] [--runs=R]
+
+namespace {
+
+const char* const kPluginPath = FACTORY_METHOD_PLUGIN_PATH;
+
+struct ColdResult {
+    double startup = 0;       // 周期
+    double first_create = 0;  // 周期
+};
+
+#if defined(BENCH_HAS_FORK)
+// 在子进程中执行一次“启动 + 首次创建”，结果通过管道传回
+bool RunCold(bool lazy, ColdResult& out) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        InitProductRegistry();
+        ColdResult r;
+        std::uint64_t c0 = bench::ReadCycles();
+        if (lazy) {
+            RegisterProductPlugin("plugin.C", kPluginPath);
+            RegisterProductPlugin("plugin.D", kPluginPath);
+        } else {
+            LoadProductPlugin(kPluginPath);
+        }
+        ProductRegistry::Freeze();
+        std::uint64_t c1 = bench::ReadCycles();
+        ProductPtr product = ProductRegistry::Create("plugin.D");
+        std::uint64_t c2 = bench::ReadCycles();
+        bench::DoNotOptimize(product.get());
+        r.startup = static_cast<double>(c1 - c0);
+        r.first_create = static_cast<double>(c2 - c1);
+        ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(product != nullptr && written == static_cast<ssize_t>(sizeof(r)) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], &out, sizeof(out));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return got == static_cast<ssize_t>(sizeof(out)) && WIFEXITED(status) &&
+           WEXITSTATUS(status) == 0;
+}
+#endif
+
+void BenchCold(const char* name, bool lazy, int runs) {
+#if defined(BENCH_HAS_FORK)
+    const double cpn = bench::CyclesPerNs();
+    std::vector<std::uint64_t> startup;
+    std::vector<std::uint64_t> first_create;
+    for (int i = 0; i < runs; ++i) {
+        ColdResult r;
+        if (!RunCold(lazy, r)) {
+            std::printf("%-28s   (fork or plugin load failed)\n", name);
+            return;
+        }
+        startup.push_back(static_cast<std::uint64_t>(r.startup));
+        first_create.push_back(static_cast<std::uint64_t>(r.first_create));
+    }
+    std::printf("%-28s %14.1f %18.1f\n", name, bench::Percentile(startup, 50) / cpn / 1000.0,
+                bench::Percentile(first_create, 50) / cpn / 1000.0);
+#else
+    (void)lazy;
+    (void)runs;
+    std::printf("%-28s   (fork not supported on this platform)\n", name);
+#endif
+}
+
+template <typename Op>
+void Bench(const char* name, const bench::Options& opt, Op op) {
+    double cpn = bench::CyclesPerNs();
+    double single = 0;
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+        auto samples = bench::RunLatency(threads, opt.samples, op);
+        if (threads == 1) {
+            single = tp.OpsPerSecond();
+        }
+        double scaling = single > 0 ? tp.OpsPerSecond() / (threads * single) : 0;
+        std::printf("%-28s %7u %12.2f %12.1f %9.0f %9.0f %9.0f%%\n", name, threads,
+                    tp.OpsPerSecond() / 1e6, tp.cycles_per_op, bench::Percentile(samples, 50) / cpn,
+                    bench::Percentile(samples, 99) / cpn, scaling * 100.0);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    int runs = 15;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 7, "--runs=") == 0) {
+            runs = std::max(1, std::atoi(arg.c_str() + 7));
+        }
+    }
+    std::printf("bench_product_plugin: max threads = %u, duration = %d ms/point, %zu samples/thread\n",
+                opt.max_threads, opt.duration_ms, opt.samples);
+    std::printf("plugin: %s\n", kPluginPath);
+
+    // 冷启动必须最先跑：父进程一旦加载了插件，fork 出来的子进程就不再“冷”
+    std::printf("\n== startup (fresh process per run, median of %d) ==\n", runs);
+    std::printf("%-28s %14s %18s\n", "mode", "startup(us)", "first create(us)");
+    BenchCold("eager: LoadProductPlugin", false, runs);
+    BenchCold("lazy: RegisterProductPlugin", true, runs);
+
+    InitProductRegistry();
+    const ProductHandle builtin = ProductRegistry::Lookup("B");
+    const ProductHandle plugin = RegisterProductPlugin("plugin.D", kPluginPath);
+    ProductRegistry::Freeze();
+    if (ProductRegistry::Create(plugin) == nullptr) {
+        std::printf("failed to load %s: %s\n", kPluginPath,
+                    PluginLibrary::Get(kPluginPath).Error().c_str());
+        return 1;
+    }
+
+    std::printf("\n== steady state (frozen registry, plugin resolved) ==\n");
+    std::printf("%-28s %7s %12s %12s %9s %9s %10s\n", "path", "threads", "Mcreates/s", "cycles/op",
+                "p50(ns)", "p99(ns)", "scaling");
+    Bench("Create(handle) built-in", opt,
+          [builtin] { bench::DoNotOptimize(ProductRegistry::Create(builtin).get()); });
+    Bench("Create(handle) plugin", opt,
+          [plugin] { bench::DoNotOptimize(ProductRegistry::Create(plugin).get()); });
+    // 名字长度不同，运行期求哈希的代价也不同；用预先算好哈希的 TypeKey 只比较查表本身
+    static constexpr TypeKey kBuiltin{"B"};
+    static constexpr TypeKey kPlugin{"plugin.D"};
+    Bench("Create(TypeKey) built-in", opt,
+          [] { bench::DoNotOptimize(ProductRegistry::Create(kBuiltin).get()); });
+    Bench("Create(TypeKey) plugin", opt,
+          [] { bench::DoNotOptimize(ProductRegistry::Create(kPlugin).get()); });
+    return 0;
+}
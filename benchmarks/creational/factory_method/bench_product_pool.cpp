@@ -0,0 +1,93 @@
+#include "../../../src/creational/factory_method/FactoryMethod.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// 产品分配基准：make_unique（全局分配器） vs ObjectPool（MakePooledProduct）
+// ----------------------------------
+// 每次操作创建一个产品并销毁一个产品，两种负载：
+// 1）立即销毁：创建后马上析构，分配器的最佳情况（同一块内存反复使用）；
+// 2）滑动窗口：每个线程持有 --live=N 个存活产品（默认 256），每次操作替换最旧的一个，
+//    模拟“大量短命对象同时存活”的 churn 负载。
+// 另外测量经由虚函数 Creator::CreateProduct（池化）的开销，最后打印池的统计信息。
+//
+// 用法：bench_product_pool [--threads=N] [--ms=M] [--samples=S] [--live=N]
+
+namespace {
+
+template <typename Op>
+void Bench(const char* name, const bench::Options& opt, Op op) {
+    double cpn = bench::CyclesPerNs();
+    double single = 0;
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+        auto samples = bench::RunLatency(threads, opt.samples, op);
+        if (threads == 1) {
+            single = tp.OpsPerSecond();
+        }
+        double scaling = single > 0 ? tp.OpsPerSecond() / (threads * single) : 0;
+        std::printf("%-32s %7u %12.2f %12.1f %9.0f %9.0f %9.0f%%\n", name, threads,
+                    tp.OpsPerSecond() / 1e6, tp.cycles_per_op, bench::Percentile(samples, 50) / cpn,
+                    bench::Percentile(samples, 99) / cpn, scaling * 100.0);
+    }
+}
+
+void PrintHeader(const char* title) {
+    std::printf("\n== %s ==\n", title);
+    std::printf("%-32s %7s %12s %12s %9s %9s %10s\n", "allocation", "threads", "Mops/s",
+                "cycles/op", "p50(ns)", "p99(ns)", "scaling");
+}
+
+// 每个线程一个环形窗口，替换最旧的产品
+template <typename Ptr, typename Make>
+auto Window(std::size_t live, Make make) {
+    return [live, make] {
+        thread_local std::vector<Ptr> ring(live);
+        thread_local std::size_t next = 0;
+        ring[next] = make();
+        bench::DoNotOptimize(ring[next].get());
+        next = next + 1 == live ? 0 : next + 1;
+    };
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t live = 256;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 7, "--live=") == 0) {
+            live = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 7)));
+        }
+    }
+    std::printf("bench_product_pool: max threads = %u, duration = %d ms/point, %zu samples/thread, "
+                "window = %zu live products/thread\n",
+                opt.max_threads, opt.duration_ms, opt.samples, live);
+
+    auto make_plain = [] { return std::make_unique<ConcreteProductA>(); };
+    auto make_pooled = [] { return MakePooledProduct<ConcreteProductA>(); };
+
+    PrintHeader("create + destroy immediately");
+    Bench("make_unique", opt, [&] { bench::DoNotOptimize(make_plain().get()); });
+    Bench("MakePooledProduct", opt, [&] { bench::DoNotOptimize(make_pooled().get()); });
+    const PooledCreator<ConcreteProductA> creator;
+    const Creator& base = creator;
+    Bench("Creator::CreateProduct (pooled)", opt,
+          [&base] { bench::DoNotOptimize(base.CreateProduct().get()); });
+
+    PrintHeader("sliding window of live products");
+    Bench("make_unique", opt, Window<std::unique_ptr<Product>>(live, make_plain));
+    Bench("MakePooledProduct", opt, Window<ProductPtr>(live, make_pooled));
+
+    PoolStats stats = ObjectPool<ConcreteProductA>::Instance().Stats();
+    std::printf("\nObjectPool<ConcreteProductA>: hits = %llu, misses = %llu, hit rate = %.4f%%, "
+                "owned = %zu blocks, high water = %zu blocks\n",
+                static_cast<unsigned long long>(stats.hits),
+                static_cast<unsigned long long>(stats.misses), stats.HitRate() * 100.0, stats.owned,
+                stats.high_water);
+    return 0;
+}
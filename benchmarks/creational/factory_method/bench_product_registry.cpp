@@ -0,0 +1,132 @@
+#include "../../../src/creational/factory_method/FactoryMethod.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ProductRegistry::Create 基准
+// ----------------------------------
+// 1）锁：同一个注册表先在未冻结状态下测量（每次 Create 都加全局 std::mutex），
+//    然后调用 Freeze()，再测量无锁读取快照的路径。每次操作创建一个产品并立即销毁，
+//    两条路径的分配/析构开销相同，差别只在查找是否加锁。
+// 2）键：注册表中额外注册 --types=N 个合成类型（工厂函数返回空指针，不分配内存），
+//    在 N 个类型之间轮转查找，对比各种键的查找开销：
+//    - unordered_map<std::string> + 临时 std::string：原来的键类型（不加锁，只比较查找本身）
+//    - string_view / TypeKey（预先算好哈希）/ ProductHandle（整数下标）
+//    - 线性探测快照 vs Freeze(KeyIndex::kPerfectHash) 构建的完美哈希快照
+// 最后测量冻结状态下的一次迟到注册（写时复制发布新快照）的耗时。
+//
+// 用法：bench_product_registry [--threads=N] [--ms=M] [--samples=S] [--types=N]
+
+namespace {
+
+template <typename Op>
+void Bench(const char* name, const bench::Options& opt, Op op) {
+    double cpn = bench::CyclesPerNs();
+    double single = 0;
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+        auto samples = bench::RunLatency(threads, opt.samples, op);
+        if (threads == 1) {
+            single = tp.OpsPerSecond();
+        }
+        double scaling = single > 0 ? tp.OpsPerSecond() / (threads * single) : 0;
+        std::printf("%-34s %7u %12.2f %12.1f %9.0f %9.0f %9.0f%%\n", name, threads,
+                    tp.OpsPerSecond() / 1e6, tp.cycles_per_op, bench::Percentile(samples, 50) / cpn,
+                    bench::Percentile(samples, 99) / cpn, scaling * 100.0);
+    }
+}
+
+void PrintHeader(const char* title) {
+    std::printf("\n== %s ==\n", title);
+    std::printf("%-34s %7s %12s %12s %9s %9s %10s\n", "registry", "threads", "Mcreates/s",
+                "cycles/op", "p50(ns)", "p99(ns)", "scaling");
+}
+
+// 轮转使用的下标（每个线程独立）
+std::size_t NextIndex(std::size_t count) {
+    thread_local std::size_t i = 0;
+    i = i + 1 == count ? 0 : i + 1;
+    return i;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t types = 4096;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 8, "--types=") == 0) {
+            types = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 8)));
+        }
+    }
+    std::printf("bench_product_registry: max threads = %u, duration = %d ms/point, %zu samples/thread, "
+                "%zu synthetic types\n",
+                opt.max_threads, opt.duration_ms, opt.samples, types);
+
+    // 合成类型必须在冻结前注册：冻结后的每次注册都会复制整张快照
+    ProductRegistry::RegisterType<ConcreteProductA>("A");
+    ProductRegistry::RegisterType<ConcreteProductB>("B");
+    std::vector<std::string> names;
+    std::vector<TypeKey> keys;
+    std::vector<ProductHandle> handles;
+    std::unordered_map<std::string, ProductRegistry::FactoryFunction> string_map;
+    auto null_factory = []() -> std::unique_ptr<Product> { return nullptr; };
+    names.reserve(types);
+    for (std::size_t i = 0; i < types; ++i) {
+        names.push_back("synthetic.product." + std::to_string(i));
+    }
+    for (const auto& name : names) {
+        keys.emplace_back(name);
+        handles.push_back(ProductRegistry::Register(name, null_factory));
+        string_map.emplace(name, null_factory);
+    }
+
+    const std::string ab[2] = {"A", "B"};
+    auto create_ab = [&ab] {
+        thread_local unsigned i = 0;
+        auto product = ProductRegistry::Create(ab[++i & 1]);
+        bench::DoNotOptimize(product.get());
+    };
+    PrintHeader("Create(\"A\"/\"B\"): global mutex vs frozen snapshot");
+    Bench("ProductRegistry (mutex)", opt, create_ab);
+    ProductRegistry::Freeze();
+    Bench("ProductRegistry (frozen)", opt, create_ab);
+
+    PrintHeader("key lookup over synthetic types (frozen, factory returns nullptr)");
+    Bench("unordered_map + temp std::string", opt, [&] {
+        const std::string& name = names[NextIndex(types)];
+        auto it = string_map.find(std::string(name.c_str()));
+        bench::DoNotOptimize(it->second());
+    });
+    auto by_view = [&] {
+        std::string_view name = names[NextIndex(types)];
+        bench::DoNotOptimize(ProductRegistry::Create(name));
+    };
+    auto by_key = [&] { bench::DoNotOptimize(ProductRegistry::Create(keys[NextIndex(types)])); };
+    auto by_handle = [&] {
+        bench::DoNotOptimize(ProductRegistry::Create(handles[NextIndex(types)]));
+    };
+    Bench("string_view (linear probing)", opt, by_view);
+    Bench("TypeKey (linear probing)", opt, by_key);
+    Bench("ProductHandle", opt, by_handle);
+    ProductRegistry::Freeze(ProductRegistry::KeyIndex::kPerfectHash);
+    if (!ProductRegistry::UsesPerfectHash()) {
+        std::printf("(perfect hash construction failed, rows below use linear probing)\n");
+    }
+    Bench("string_view (perfect hash)", opt, by_view);
+    Bench("TypeKey (perfect hash)", opt, by_key);
+
+    auto c0 = bench::ReadCycles();
+    ProductRegistry::Register("Late", []() -> std::unique_ptr<Product> {
+        return std::make_unique<ConcreteProductA>();
+    });
+    auto c1 = bench::ReadCycles();
+    std::printf("\nlate Register() after Freeze() (copy-on-write publish of %zu entries): %.0f us\n",
+                types + 3, static_cast<double>(c1 - c0) / bench::CyclesPerNs() / 1000.0);
+    return 0;
+}
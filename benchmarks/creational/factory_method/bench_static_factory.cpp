@@ -0,0 +1,124 @@
+#include "../../../src/creational/factory_method/StaticFactory.h"
+#include "../../common/BenchUtil.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+// 创建 + 使用：Creator（虚函数 + 堆/对象池） vs ProductRegistry vs StaticFactory（std::variant）
+// ----------------------------------
+// 每次操作按一个预先生成的随机序列在两种产品之间选择，创建一个产品、调用一次 Use()、销毁。
+// 被测产品的 Use() 只递增成员计数，衡量的是创建与分派本身：
+// - Creator：virtual CreateProduct() + virtual Use()，分别测 make_unique 与对象池两种分配；
+// - ProductRegistry（已冻结）：按句柄 / 按名字查找工厂函数，std::function 调用 + virtual Use()；
+// - StaticFactory：产品按值构造在 variant 中（无堆分配），std::visit 分派到非虚的 P::Use()，
+//   分别按类型标签、下标、名字创建。
+//
+// 用法：bench_static_factory [--threads=N] [--ms=M] [--samples=S]
+
+namespace {
+
+class CheapA : public Product {
+public:
+    static constexpr std::string_view kTypeName = "cheap.A";
+    void Use() override { ++uses; }
+    std::uint64_t uses = 0;
+};
+
+class CheapB : public Product {
+public:
+    static constexpr std::string_view kTypeName = "cheap.B";
+    void Use() override { uses += 2; }
+    std::uint64_t uses = 0;
+};
+
+template <typename P>
+class HeapCreator : public Creator {
+public:
+    ProductPtr CreateProduct() const override { return std::make_unique<P>(); }
+};
+
+using CheapFactory = StaticFactory<CheapA, CheapB>;
+
+constexpr std::size_t kPicks = 4096;  // 2 的幂
+
+// 每个线程在随机序列上独立前进
+unsigned NextPick(const std::vector<unsigned char>& picks) {
+    thread_local std::size_t i = 0;
+    i = (i + 1) & (kPicks - 1);
+    return picks[i];
+}
+
+template <typename Op>
+void Bench(const char* name, const bench::Options& opt, Op op) {
+    double cpn = bench::CyclesPerNs();
+    double single = 0;
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+        auto samples = bench::RunLatency(threads, opt.samples, op);
+        if (threads == 1) {
+            single = tp.OpsPerSecond();
+        }
+        double scaling = single > 0 ? tp.OpsPerSecond() / (threads * single) : 0;
+        std::printf("%-34s %7u %12.2f %12.1f %9.0f %9.0f %9.0f%%\n", name, threads,
+                    tp.OpsPerSecond() / 1e6, tp.cycles_per_op, bench::Percentile(samples, 50) / cpn,
+                    bench::Percentile(samples, 99) / cpn, scaling * 100.0);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::printf("bench_static_factory: max threads = %u, duration = %d ms/point, %zu samples/thread\n",
+                opt.max_threads, opt.duration_ms, opt.samples);
+
+    std::vector<unsigned char> picks(kPicks);
+    std::mt19937 rng(7);
+    for (auto& pick : picks) {
+        pick = static_cast<unsigned char>(rng() & 1);
+    }
+    const std::string_view names[2] = {CheapA::kTypeName, CheapB::kTypeName};
+
+    const HeapCreator<CheapA> heap_a;
+    const HeapCreator<CheapB> heap_b;
+    const Creator* heap[2] = {&heap_a, &heap_b};
+    const PooledCreator<CheapA> pooled_a;
+    const PooledCreator<CheapB> pooled_b;
+    const Creator* pooled[2] = {&pooled_a, &pooled_b};
+
+    const ProductHandle handles[2] = {ProductRegistry::RegisterType<CheapA>(names[0]),
+                                      ProductRegistry::RegisterType<CheapB>(names[1])};
+    ProductRegistry::Freeze();
+
+    auto use_product = [](ProductPtr product) {
+        product->Use();
+        bench::DoNotOptimize(product.get());
+    };
+    auto use_variant = [](CheapFactory::Variant product) {
+        CheapFactory::Use(product);
+        bench::DoNotOptimize(&product);
+    };
+
+    std::printf("\n%-34s %7s %12s %12s %9s %9s %10s\n", "factory", "threads", "Mops/s", "cycles/op",
+                "p50(ns)", "p99(ns)", "scaling");
+    Bench("Creator (make_unique)", opt,
+          [&] { use_product(heap[NextPick(picks)]->CreateProduct()); });
+    Bench("Creator (pooled)", opt, [&] { use_product(pooled[NextPick(picks)]->CreateProduct()); });
+    Bench("ProductRegistry::Create(handle)", opt,
+          [&] { use_product(ProductRegistry::Create(handles[NextPick(picks)])); });
+    Bench("ProductRegistry::Create(name)", opt,
+          [&] { use_product(ProductRegistry::Create(names[NextPick(picks)])); });
+    Bench("StaticFactory::Create<P>()", opt, [&] {
+        use_variant(NextPick(picks) != 0 ? CheapFactory::Create<CheapB>()
+                                         : CheapFactory::Create<CheapA>());
+    });
+    Bench("StaticFactory::Create(index)", opt,
+          [&] { use_variant(CheapFactory::Create(std::size_t{NextPick(picks)})); });
+    Bench("StaticFactory::Create(name)", opt,
+          [&] { use_variant(CheapFactory::Create(names[NextPick(picks)])); });
+    return 0;
+}
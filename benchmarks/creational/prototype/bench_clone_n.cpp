@@ -0,0 +1,180 @@
+#include "../../../src/creational/prototype/Prototype.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// 批量克隆基准：逐个 Clone() 与 CloneN / CloneInto 的对比，小原型与大原型
+// ----------------------------------
+// 三种原型：
+// - small ：TrivialPrototype，载荷 24 字节（对象 32 字节），可平凡复制，构造空壳后逐个 memcpy 载荷；
+// - large ：TrivialPrototype，载荷 1 KiB，同上；
+// - string：ConcretePrototype，name 长 64 字符（超过 SSO），拷贝可能抛出，走带回滚的路径。
+// 每种原型比较三种克隆 n 次的方式（都通过 Prototype* 调用）：
+// - Clone() x n        ：n 次虚调用、n 次分配，结果放进预先 reserve 的 std::vector<std::unique_ptr<Prototype>>；
+// - CloneN(n)          ：一次虚调用、一次分配，克隆连续存放；
+// - CloneInto (reused) ：调用方复用同一块存储，克隆过程不分配（载荷自身的分配除外）。
+// 每行取 5 次的中位数；计时不包含结果的析构。分配次数通过替换全局 operator new 统计。
+//
+// 用法：bench_clone_n [--n=N] [--large-n=N]
+
+namespace {
+
+std::atomic<std::size_t> g_heap_allocations{0};
+
+struct SmallPayload {
+    double x;
+    double y;
+    std::uint32_t color;
+    std::uint32_t flags;
+};
+
+struct LargePayload {
+    float samples[256];
+};
+
+class SmallPrototype final : public TrivialPrototype<SmallPrototype, SmallPayload> {
+public:
+    using TrivialPrototype::TrivialPrototype;
+    explicit SmallPrototype(const SmallPayload& payload) : TrivialPrototype(payload) {}
+    void Show() const override {}
+};
+
+class LargePrototype final : public TrivialPrototype<LargePrototype, LargePayload> {
+public:
+    using TrivialPrototype::TrivialPrototype;
+    explicit LargePrototype(const LargePayload& payload) : TrivialPrototype(payload) {}
+    void Show() const override {}
+};
+
+struct Row {
+    double ns_per_clone = 0;
+    std::size_t allocations = 0;
+};
+
+// 执行 5 次：setup() 准备（不计时），op() 计时，teardown() 清理（不计时）
+template <typename Setup, typename Op, typename Teardown>
+Row Measure(std::size_t n, Setup setup, Op op, Teardown teardown) {
+    std::vector<std::uint64_t> samples;
+    std::size_t allocations = 0;
+    for (int r = 0; r < 5; ++r) {
+        setup();
+        const std::size_t a0 = g_heap_allocations.load(std::memory_order_relaxed);
+        std::uint64_t c0 = bench::ReadCycles();
+        op();
+        std::uint64_t c1 = bench::ReadCycles();
+        allocations = g_heap_allocations.load(std::memory_order_relaxed) - a0;
+        bench::ClobberMemory();
+        teardown();
+        samples.push_back(c1 - c0);
+    }
+    Row row;
+    row.ns_per_clone = bench::Percentile(samples, 50) / bench::CyclesPerNs() / static_cast<double>(n);
+    row.allocations = allocations;
+    return row;
+}
+
+void PrintRow(const char* kind, const char* path, const Row& row, std::size_t object_size) {
+    std::printf("%-8s %-20s %12.2f %12.2f %14zu\n", kind, path, row.ns_per_clone,
+                static_cast<double>(object_size) / row.ns_per_clone, row.allocations);
+}
+
+void Run(const char* kind, const Prototype& prototype, std::size_t n) {
+    std::vector<std::unique_ptr<Prototype>> clones;
+    PrintRow(kind, "Clone() x n",
+             Measure(
+                 n, [&] { clones.reserve(n); },
+                 [&] {
+                     for (std::size_t i = 0; i < n; ++i) {
+                         clones.push_back(prototype.Clone());
+                     }
+                 },
+                 [&] { clones.clear(); }),
+             prototype.CloneSize());
+
+    PrototypeBatch batch;
+    PrintRow(kind, "CloneN(n)",
+             Measure(
+                 n, [] {}, [&] { batch = prototype.CloneN(n); }, [&] { batch.Reset(); }),
+             prototype.CloneSize());
+
+    const std::size_t stride = prototype.CloneSize();
+    const std::align_val_t align{prototype.CloneAlign()};
+    auto* storage = static_cast<unsigned char*>(::operator new(n * stride, align));
+    Prototype* first = nullptr;
+    PrintRow(kind, "CloneInto (reused)",
+             Measure(
+                 n, [] {}, [&] { first = prototype.CloneInto(storage, n); },
+                 [&] {
+                     const std::size_t offset = reinterpret_cast<unsigned char*>(first) - storage;
+                     for (std::size_t i = 0; i < n; ++i) {
+                         reinterpret_cast<Prototype*>(storage + i * stride + offset)->~Prototype();
+                     }
+                 }),
+             prototype.CloneSize());
+    ::operator delete(storage, align);
+}
+
+}  // namespace
+
+// 统计堆分配次数。new / delete 都不内联：否则 GCC 在内联后把 malloc 与 operator delete、
+// operator new 与 free 配对，误报 -Wmismatched-new-delete
+BENCH_NOINLINE void* operator new(std::size_t size) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, rounded)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 1000000;
+    std::size_t large_n = 100000;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(1L, std::atol(arg.c_str() + 4)));
+        } else if (arg.compare(0, 10, "--large-n=") == 0) {
+            large_n = static_cast<std::size_t>(std::max(1L, std::atol(arg.c_str() + 10)));
+        }
+    }
+    std::printf("bench_clone_n: %zu small / string clones, %zu large clones, median of 5\n", n,
+                large_n);
+
+    SmallPrototype small(SmallPayload{1.0, 2.0, 0xff00ffu, 3});
+    LargePayload large_payload{};
+    for (int i = 0; i < 256; ++i) {
+        large_payload.samples[i] = static_cast<float>(i) * 0.5f;
+    }
+    LargePrototype large(large_payload);
+    ConcretePrototype text(std::string(64, 's'), 42);
+
+    std::printf("\n== clone n times through Prototype* ==\n");
+    std::printf("%-8s %-20s %12s %12s %14s\n", "kind", "path", "ns/clone", "GB/s", "allocations");
+    Run("small", small, n);
+    Run("large", large, large_n);
+    Run("string", text, n);
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "../../../src/creational/prototype/Prototype.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// 写时复制原型基准：克隆 n 个对象（默认 1000 万），其中 1% 被修改
+// ----------------------------------
+// 原型的 name 长 --name-len 个字符（默认 64，超过 SSO 长度）。每个变体依次执行：
+// 1）clone ：通过 Prototype* 调用 Clone() n 次，克隆保存在 std::vector<std::unique_ptr<Prototype>>；
+// 2）mutate：每 100 个克隆中修改 1 个的 value（--mutate-every 可调）；
+// 3）read  ：读取全部克隆的 name 长度与 value；
+// 比较深拷贝的 ConcretePrototype 与写时复制的 CowConcretePrototype。
+// 内存 = 各阶段堆上申请的字节数（替换全局 operator new 统计；克隆在测量期间全部存活，
+// 因此就是内存的增长量，不含 malloc 自身的管理开销）。单次运行，计时不含析构。
+//
+// 用法：bench_cow_prototype [--n=N] [--name-len=L] [--mutate-every=K]
+
+namespace {
+
+std::atomic<std::size_t> g_heap_bytes{0};
+
+struct PhaseResult {
+    double ms = 0;
+    std::size_t bytes = 0;
+};
+
+template <typename Phase>
+PhaseResult Measure(Phase phase) {
+    const std::size_t bytes0 = g_heap_bytes.load(std::memory_order_relaxed);
+    std::uint64_t c0 = bench::ReadCycles();
+    phase();
+    std::uint64_t c1 = bench::ReadCycles();
+    PhaseResult result;
+    result.ms = static_cast<double>(c1 - c0) / bench::CyclesPerNs() / 1e6;
+    result.bytes = g_heap_bytes.load(std::memory_order_relaxed) - bytes0;
+    return result;
+}
+
+template <typename Concrete>
+void Run(const char* name, std::size_t n, std::size_t name_len, std::size_t mutate_every) {
+    std::unique_ptr<Prototype> prototype =
+        std::make_unique<Concrete>(std::string(name_len, 'p'), 42);
+    std::vector<std::unique_ptr<Prototype>> clones;
+    clones.reserve(n);  // 容器本身不计入各阶段
+
+    PhaseResult clone = Measure([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            clones.push_back(prototype->Clone());
+        }
+    });
+    PhaseResult mutate = Measure([&] {
+        for (std::size_t i = 0; i < n; i += mutate_every) {
+            static_cast<Concrete&>(*clones[i]).SetValue(static_cast<int>(i));
+        }
+    });
+    std::size_t checksum = 0;
+    PhaseResult read = Measure([&] {
+        for (const auto& object : clones) {
+            const auto& concrete = static_cast<const Concrete&>(*object);
+            checksum += concrete.Name().size() + static_cast<std::size_t>(concrete.Value());
+        }
+    });
+    bench::DoNotOptimize(checksum);
+
+    const std::size_t bytes = clone.bytes + mutate.bytes;
+    std::printf("%-22s %10.1f %10.1f %10.1f %10.1f %12.1f %12.1f\n", name, clone.ms, mutate.ms,
+                read.ms, clone.ms + mutate.ms + read.ms, static_cast<double>(bytes) / (1 << 20),
+                static_cast<double>(bytes) / static_cast<double>(n));
+}
+
+}  // namespace
+
+// 统计堆上申请的字节数
+void* operator new(std::size_t size) {
+    g_heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::size_t n = 10000000;
+    std::size_t name_len = 64;
+    std::size_t mutate_every = 100;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 4, "--n=") == 0) {
+            n = static_cast<std::size_t>(std::max(1L, std::atol(arg.c_str() + 4)));
+        } else if (arg.compare(0, 11, "--name-len=") == 0) {
+            name_len = static_cast<std::size_t>(std::max(0, std::atoi(arg.c_str() + 11)));
+        } else if (arg.compare(0, 15, "--mutate-every=") == 0) {
+            mutate_every = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 15)));
+        }
+    }
+    std::printf("bench_cow_prototype: %zu clones, name length %zu, mutate 1 in %zu\n", n, name_len,
+                mutate_every);
+    std::printf("sizeof(ConcretePrototype) = %zu, sizeof(CowConcretePrototype) = %zu\n",
+                sizeof(ConcretePrototype), sizeof(CowConcretePrototype));
+
+    std::printf("\n== clone, mutate, read ==\n");
+    std::printf("%-22s %10s %10s %10s %10s %12s %12s\n", "variant", "clone(ms)", "mutate(ms)",
+                "read(ms)", "total(ms)", "heap(MiB)", "bytes/clone");
+    Run<ConcretePrototype>("deep copy", n, name_len, mutate_every);
+    Run<CowConcretePrototype>("copy-on-write", n, name_len, mutate_every);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "../../../src/creational/prototype/PrototypePool.h"
+#include "../../common/BenchUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 预热原型池基准：突发负载下单次取得克隆的延迟分布
+// ----------------------------------
+// 请求线程发出 --bursts 轮突发（默认 200 轮），每轮连续取 --burst 个克隆（默认 256），
+// 两轮之间空闲 --gap-us 微秒（默认 2000），模拟请求高峰与低谷；空闲时后台线程补充池子。
+// 每次取用单独计时（扣除计时器开销），取得的克隆保留到本轮结束后再统一释放（不计时）。
+// 两种原型：
+// - order   ：ConcretePrototype，name 长 64 字符，克隆一次分配一次；
+// - document：16 个 48 字符的段落，克隆一次分配 17 次。
+// 每种原型比较：
+// - Clone() inline           ：请求线程直接调用 Clone()；
+// - pool (capacity C)        ：PrototypePool::Acquire，容量 --capacity（默认 512，大于一轮突发）；
+// - pool (capacity burst/2)  ：容量只有一轮突发的一半，每轮后半段退回到直接克隆。
+//
+// 用法：bench_prototype_pool [--bursts=N] [--burst=N] [--gap-us=N] [--capacity=N]
+
+namespace {
+
+class DocumentPrototype final : public Prototype {
+public:
+    DocumentPrototype(std::size_t sections, std::size_t length)
+        : sections_(sections, std::string(length, 'd')) {}
+
+    std::unique_ptr<Prototype> Clone() const override {
+        return std::make_unique<DocumentPrototype>(*this);
+    }
+    void Show() const override {}
+
+private:
+    std::vector<std::string> sections_;
+};
+
+struct Load {
+    std::size_t bursts = 200;
+    std::size_t burst = 256;
+    int gap_us = 2000;
+};
+
+// 按突发负载调用 acquire()，返回每次调用的延迟（周期）
+template <typename Acquire>
+std::vector<std::uint64_t> RunBursts(const Load& load, Acquire acquire) {
+    const std::uint64_t overhead = bench::TimerOverhead();
+    std::vector<std::uint64_t> samples;
+    samples.reserve(load.bursts * load.burst);
+    std::vector<std::unique_ptr<Prototype>> held;
+    held.reserve(load.burst);
+    for (std::size_t b = 0; b < load.bursts; ++b) {
+        for (std::size_t i = 0; i < load.burst; ++i) {
+            std::uint64_t c0 = bench::ReadCycles();
+            std::unique_ptr<Prototype> object = acquire();
+            std::uint64_t c1 = bench::ReadCycles();
+            std::uint64_t d = c1 - c0;
+            samples.push_back(d > overhead ? d - overhead : 0);
+            held.push_back(std::move(object));
+        }
+        held.clear();
+        std::this_thread::sleep_for(std::chrono::microseconds(load.gap_us));
+    }
+    return samples;
+}
+
+void PrintRow(const char* kind, const char* path, std::vector<std::uint64_t> samples,
+              std::size_t misses) {
+    const double per_ns = bench::CyclesPerNs();
+    const double p50 = bench::Percentile(samples, 50) / per_ns;
+    const double p99 = bench::Percentile(samples, 99) / per_ns;
+    const double p999 = bench::Percentile(samples, 99.9) / per_ns;
+    const double max = bench::Percentile(samples, 100) / per_ns;
+    std::printf("%-9s %-26s %9.0f %9.0f %10.0f %10.0f %9.1f%%\n", kind, path, p50, p99, p999, max,
+                100.0 * static_cast<double>(misses) / static_cast<double>(samples.size()));
+}
+
+void Run(const char* kind, const Prototype& prototype, const Load& load, std::size_t capacity) {
+    PrintRow(kind, "Clone() inline", RunBursts(load, [&] { return prototype.Clone(); }), 0);
+
+    const std::size_t capacities[] = {capacity, std::max<std::size_t>(1, load.burst / 2)};
+    for (std::size_t c : capacities) {
+        PrototypePool pool;
+        const std::size_t id = pool.Register(kind, prototype.Clone(), c);
+        auto samples = RunBursts(load, [&] { return pool.Acquire(id); });
+        char path[64];
+        std::snprintf(path, sizeof(path), "pool (capacity %zu)", c);
+        PrintRow(kind, path, std::move(samples), pool.GetStats(id).misses);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    Load load;
+    std::size_t capacity = 512;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 9, "--bursts=") == 0) {
+            load.bursts = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 9)));
+        } else if (arg.compare(0, 8, "--burst=") == 0) {
+            load.burst = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 8)));
+        } else if (arg.compare(0, 9, "--gap-us=") == 0) {
+            load.gap_us = std::max(0, std::atoi(arg.c_str() + 9));
+        } else if (arg.compare(0, 11, "--capacity=") == 0) {
+            capacity = static_cast<std::size_t>(std::max(1, std::atoi(arg.c_str() + 11)));
+        }
+    }
+    std::printf("bench_prototype_pool: %zu bursts of %zu, %d us gap, capacity %zu\n", load.bursts,
+                load.burst, load.gap_us, capacity);
+
+    std::printf("\n== latency per clone under bursty load (ns) ==\n");
+    std::printf("%-9s %-26s %9s %9s %10s %10s %10s\n", "kind", "path", "p50", "p99", "p99.9",
+                "max", "misses");
+    ConcretePrototype order(std::string(64, 'o'), 42);
+    DocumentPrototype document(16, 48);
+    Run("order", order, load, capacity);
+    Run("document", document, load, capacity);
+    return 0;
+}
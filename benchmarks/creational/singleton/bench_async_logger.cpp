@@ -0,0 +1,136 @@
+#include "../../../src/creational/singleton/Singletons.h"
+#include "../../common/BenchUtil.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// 单例 Log() 日志后端基准：std::cout（同步 + 每条 flush） vs AsyncLogger（无锁环形缓冲区）
+// ----------------------------------
+// - 调用方吞吐：N 线程在固定时长内不断调用 MeyersSingleton::Instance().Log()；
+//   异步后端额外给出“含排空”的端到端吞吐（计时包含最后一次 Flush()）
+// - 调用方延迟：逐次计时 Log()，报告 p50 / p99 / p99.9 / 最大值
+// kDrop / kCount 行的吞吐包含被丢弃的调用，丢弃数量见最后一行统计。
+// 测量期间标准输出被重定向到 /dev/null，只比较日志路径本身的开销，结果在恢复后打印。
+//
+// 用法：bench_async_logger [--threads=N] [--ms=M] [--samples=S]
+
+namespace {
+
+struct Row {
+    std::string name;
+    unsigned threads;
+    double mops;
+    double end_to_end_mops;
+    double p50, p99, p999, max;
+};
+
+class StdoutSilencer {
+public:
+    StdoutSilencer() {
+#if defined(__unix__) || defined(__APPLE__)
+        std::fflush(stdout);
+        std::cout.flush();
+        saved_ = dup(STDOUT_FILENO);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            close(devnull);
+        }
+#endif
+    }
+
+    ~StdoutSilencer() {
+#if defined(__unix__) || defined(__APPLE__)
+        std::cout.flush();
+        if (saved_ >= 0) {
+            dup2(saved_, STDOUT_FILENO);
+            close(saved_);
+        }
+#endif
+    }
+
+private:
+    int saved_ = -1;
+};
+
+Row Measure(const char* name, unsigned threads, const bench::Options& opt, bool async) {
+    const std::string message = "order 42 filled at 101.25, qty 300, venue XNAS";
+    auto op = [&] { MeyersSingleton::Instance().Log(message); };
+
+    auto start = std::chrono::steady_clock::now();
+    auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+    if (async) {
+        AsyncLogger::Instance().Flush();
+    }
+    double drained_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto samples = bench::RunLatency(threads, opt.samples, op);
+    if (async) {
+        AsyncLogger::Instance().Flush();
+    }
+
+    Row row;
+    row.name = name;
+    row.threads = threads;
+    row.mops = tp.OpsPerSecond() / 1e6;
+    row.end_to_end_mops = static_cast<double>(tp.total_ops) / drained_seconds / 1e6;
+    double cpn = bench::CyclesPerNs();
+    row.p50 = bench::Percentile(samples, 50) / cpn;
+    row.p99 = bench::Percentile(samples, 99) / cpn;
+    row.p999 = bench::Percentile(samples, 99.9) / cpn;
+    row.max = bench::Percentile(samples, 100) / cpn;
+    return row;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::printf("bench_async_logger: max threads = %u, duration = %d ms/point, %zu samples/thread\n\n",
+                opt.max_threads, opt.duration_ms, opt.samples);
+    MeyersSingleton::Instance();
+    AsyncLogger::Instance();
+    bench::CyclesPerNs();
+
+    std::vector<Row> rows;
+    {
+        StdoutSilencer silence;
+        for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+            SetSingletonLogBackend(LogBackend::kStdout);
+            rows.push_back(Measure("std::cout + endl", threads, opt, false));
+
+            SetSingletonLogBackend(LogBackend::kAsync);
+            AsyncLogger::Instance().SetOverflowPolicy(OverflowPolicy::kBlock);
+            rows.push_back(Measure("AsyncLogger(kBlock)", threads, opt, true));
+
+            AsyncLogger::Instance().SetOverflowPolicy(OverflowPolicy::kCount);
+            rows.push_back(Measure("AsyncLogger(kCount)", threads, opt, true));
+
+            AsyncLogger::Instance().SetOverflowPolicy(OverflowPolicy::kDrop);
+            rows.push_back(Measure("AsyncLogger(kDrop)", threads, opt, true));
+        }
+        SetSingletonLogBackend(LogBackend::kStdout);
+        AsyncLogger::Instance().SetOverflowPolicy(OverflowPolicy::kBlock);
+    }
+
+    std::printf("%-22s %7s %12s %14s %10s %10s %10s %12s\n", "backend", "threads", "Mmsg/s",
+                "drained Mmsg/s", "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)");
+    for (const auto& r : rows) {
+        std::printf("%-22s %7u %12.2f %14.2f %10.0f %10.0f %10.0f %12.0f\n", r.name.c_str(),
+                    r.threads, r.mops, r.end_to_end_mops, r.p50, r.p99, r.p999, r.max);
+    }
+
+    auto stats = AsyncLogger::Instance().GetStats();
+    std::printf("\nAsyncLogger: %llu records written in %llu write() calls, %llu dropped (kCount)\n",
+                static_cast<unsigned long long>(stats.written),
+                static_cast<unsigned long long>(stats.batches),
+                static_cast<unsigned long long>(stats.dropped));
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "../../../src/creational/singleton/RcuSingleton.h"
+#include "../../common/BenchUtil.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 可热更新配置的读路径基准：shared_mutex + shared_ptr 整体替换 vs RcuSingleton
+// ----------------------------------
+// 后台写者以固定频率（默认每秒 5000 次）发布新版本的配置，同时 N 个读者线程不断读取配置：
+// - 读吞吐：固定时长内的总读取次数与每次读取的周期数
+// - 读延迟：逐次计时，报告 p50 / p99 / p99.9 / 最大值（写者替换期间的尾延迟是关注重点）
+// 每次读取都会校验配置内部的不变式，确保读到的是完整一致的版本。
+//
+// 用法：bench_rcu_singleton [--threads=N] [--ms=M] [--samples=S] [--swaps=每秒替换次数]
+
+namespace {
+
+struct Config {
+    std::uint64_t version = 0;
+    std::uint64_t timeout_ms = 100;
+    std::uint64_t checksum = 100;  // 恒等于 version + timeout_ms
+    char endpoint[40] = "https://config.example.com/v1";
+};
+
+// 对照组：读者在共享锁下复制 shared_ptr（引用计数是所有读者共享的原子读改写），
+// 写者在独占锁下替换指针，替换期间读者排队
+class SharedMutexConfig {
+public:
+    static SharedMutexConfig& Instance() {
+        static SharedMutexConfig instance;
+        return instance;
+    }
+
+    std::shared_ptr<const Config> Read() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return current_;
+    }
+
+    void Update(std::shared_ptr<const Config> next) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        current_.swap(next);
+    }
+
+private:
+    SharedMutexConfig() : current_(std::make_shared<Config>()) {}
+
+    mutable std::shared_mutex mutex_;
+    std::shared_ptr<const Config> current_;
+};
+
+struct BenchTag {};
+using RcuConfig = RcuSingleton<Config, BenchTag>;
+
+std::atomic<std::uint64_t> g_torn{0};
+
+void Check(const Config& c) {
+    if (c.version + c.timeout_ms != c.checksum) {
+        g_torn.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+Config MakeVersion(std::uint64_t v) {
+    Config c;
+    c.version = v;
+    c.timeout_ms = 100 + v % 7;
+    c.checksum = c.version + c.timeout_ms;
+    return c;
+}
+
+// 后台写者：按目标频率发布新版本，析构时停止并返回实际替换次数
+class PacedWriter {
+public:
+    template <typename Publish>
+    PacedWriter(double swaps_per_second, Publish publish)
+        : thread_([this, swaps_per_second, publish] {
+              auto start = std::chrono::steady_clock::now();
+              while (!stop_.load(std::memory_order_relaxed)) {
+                  double elapsed =
+                      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                          .count();
+                  auto due = static_cast<std::uint64_t>(elapsed * swaps_per_second);
+                  while (swaps_ < due) {
+                      publish(++swaps_);
+                  }
+                  std::this_thread::sleep_for(std::chrono::microseconds(100));
+              }
+          }) {}
+
+    std::uint64_t Stop() {
+        stop_.store(true, std::memory_order_relaxed);
+        thread_.join();
+        return swaps_;
+    }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::uint64_t swaps_ = 0;
+    std::thread thread_;
+};
+
+template <typename ReadOp, typename Publish>
+void Bench(const char* name, const bench::Options& opt, double swaps_per_second, ReadOp read,
+           Publish publish) {
+    double cpn = bench::CyclesPerNs();
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        PacedWriter writer(swaps_per_second, publish);
+        auto start = std::chrono::steady_clock::now();
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), read);
+        auto samples = bench::RunLatency(threads, opt.samples, read);
+        double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::uint64_t swaps = writer.Stop();
+
+        std::printf("%-26s %7u %12.2f %10.1f %9.0f %9.0f %10.0f %11.0f %10.0f\n", name, threads,
+                    tp.OpsPerSecond() / 1e6, tp.cycles_per_op,
+                    bench::Percentile(samples, 50) / cpn, bench::Percentile(samples, 99) / cpn,
+                    bench::Percentile(samples, 99.9) / cpn, bench::Percentile(samples, 100) / cpn,
+                    static_cast<double>(swaps) / seconds);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    double swaps_per_second = 5000;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 8, "--swaps=") == 0) {
+            swaps_per_second = std::max(1.0, std::atof(arg.c_str() + 8));
+        }
+    }
+    std::printf(
+        "bench_rcu_singleton: max threads = %u, duration = %d ms/point, %zu samples/thread, "
+        "target %.0f swaps/s\n\n",
+        opt.max_threads, opt.duration_ms, opt.samples, swaps_per_second);
+    SharedMutexConfig::Instance();
+    RcuConfig::Instance();
+
+    std::printf("%-26s %7s %12s %10s %9s %9s %10s %11s %10s\n", "config", "threads", "Mreads/s",
+                "cycles/op", "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)", "swaps/s");
+    Bench(
+        "shared_mutex + shared_ptr", opt, swaps_per_second,
+        [] {
+            auto cfg = SharedMutexConfig::Instance().Read();
+            Check(*cfg);
+        },
+        [](std::uint64_t v) {
+            SharedMutexConfig::Instance().Update(std::make_shared<const Config>(MakeVersion(v)));
+        });
+    Bench(
+        "RcuSingleton", opt, swaps_per_second,
+        [] {
+            auto cfg = RcuConfig::Instance().Read();
+            Check(*cfg);
+        },
+        [](std::uint64_t v) {
+            RcuConfig::Instance().Update(std::make_unique<Config>(MakeVersion(v)));
+        });
+
+    RcuConfig::Instance().Synchronize();
+    std::printf("\ntorn reads: %llu, RcuSingleton pending reclaim after Synchronize(): %zu\n",
+                static_cast<unsigned long long>(g_torn.load()),
+                RcuConfig::Instance().PendingReclaim());
+    return 0;
+}
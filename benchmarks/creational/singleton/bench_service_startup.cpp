@@ -0,0 +1,133 @@
+#include "../../../src/creational/singleton/ServiceRegistry.h"
+#include "../../common/BenchUtil.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 服务启动基准：按依赖并行启动 vs 逐个串行构造（threads = 1，相当于静态初始化阶段的饿汉式单例）
+// ----------------------------------
+// 生成一个分层的合成依赖图（默认 6 层 × 8 个服务），每个服务依赖上一层的 2 个服务，
+// 初始化耗时在 [1, 8] ms 之间（固定种子，多次运行结果可比）。对每个线程数重新注册并启动，报告：
+// - 实际启动耗时、全部初始化耗时之和、关键路径耗时（任何线程数都无法突破的下限）
+// - 相对串行的加速比，以及实际耗时与关键路径之比（越接近 1 说明调度越充分）
+// 默认用 sleep 模拟 I/O 型初始化（读文件、建连接）；--spin 改为忙等，模拟 CPU 型初始化，
+// 此时加速比受核数限制。最后打印最大线程数那一次的完整报告。
+//
+// 用法：bench_service_startup [--threads=N] [--layers=L] [--width=W] [--spin]
+
+namespace {
+
+struct SyntheticService {
+    std::size_t id;
+};
+
+struct Spec {
+    std::string name;
+    std::vector<std::string> deps;
+    int cost_us;
+};
+
+std::vector<Spec> MakeGraph(int layers, int width) {
+    std::uint32_t seed = 12345;
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    std::vector<Spec> specs;
+    for (int l = 0; l < layers; ++l) {
+        for (int w = 0; w < width; ++w) {
+            Spec spec;
+            spec.name = "svc_" + std::to_string(l) + "_" + std::to_string(w);
+            spec.cost_us = 1000 + static_cast<int>(next() % 7000);
+            if (l > 0) {
+                int a = static_cast<int>(next() % static_cast<std::uint32_t>(width));
+                int b = static_cast<int>(next() % static_cast<std::uint32_t>(width));
+                spec.deps.push_back("svc_" + std::to_string(l - 1) + "_" + std::to_string(a));
+                if (b != a) {
+                    spec.deps.push_back("svc_" + std::to_string(l - 1) + "_" + std::to_string(b));
+                }
+            }
+            specs.push_back(std::move(spec));
+        }
+    }
+    return specs;
+}
+
+void Work(int cost_us, bool spin) {
+    if (!spin) {
+        std::this_thread::sleep_for(std::chrono::microseconds(cost_us));
+        return;
+    }
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(cost_us);
+    while (std::chrono::steady_clock::now() < end) {
+        bench::ClobberMemory();
+    }
+}
+
+StartupReport RunOnce(const std::vector<Spec>& specs, unsigned threads, bool spin) {
+    ServiceRegistry registry;
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+        int cost = specs[i].cost_us;
+        registry.Register<SyntheticService>(specs[i].name, specs[i].deps,
+                                            [i, cost, spin](ServiceRegistry&) {
+                                                Work(cost, spin);
+                                                return std::make_unique<SyntheticService>(
+                                                    SyntheticService{i});
+                                            });
+    }
+    return registry.Start(threads);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    int layers = 6;
+    int width = 8;
+    bool spin = false;
+    for (const auto& arg : opt.positional) {
+        if (arg.compare(0, 9, "--layers=") == 0) {
+            layers = std::max(1, std::atoi(arg.c_str() + 9));
+        } else if (arg.compare(0, 8, "--width=") == 0) {
+            width = std::max(1, std::atoi(arg.c_str() + 8));
+        } else if (arg == "--spin") {
+            spin = true;
+        }
+    }
+    std::vector<Spec> specs = MakeGraph(layers, width);
+    std::printf("bench_service_startup: %zu services (%d layers x %d), %s init, max threads = %u\n\n",
+                specs.size(), layers, width, spin ? "spinning" : "sleeping", opt.max_threads);
+
+    std::printf("%7s %12s %14s %16s %9s %14s\n", "threads", "wall(ms)", "total init(ms)",
+                "critical path(ms)", "speedup", "wall/critical");
+    StartupReport last;
+    double serial_ms = 0;
+    std::vector<unsigned> counts = bench::ThreadCounts(opt.max_threads);
+    if (counts.back() < 16) {
+        counts.push_back(16);  // sleep 型初始化在超订阅下仍能受益
+    }
+    for (unsigned threads : counts) {
+        StartupReport report = RunOnce(specs, threads, spin);
+        if (!report.ok) {
+            std::printf("startup failed: %s\n", report.error.c_str());
+            return 1;
+        }
+        if (threads == 1) {
+            serial_ms = report.wall_ms;
+        }
+        std::printf("%7u %12.2f %14.2f %16.2f %8.2fx %14.2f\n", threads, report.wall_ms,
+                    report.total_init_ms, report.critical_path_ms,
+                    serial_ms > 0 ? serial_ms / report.wall_ms : 0.0,
+                    report.critical_path_ms > 0 ? report.wall_ms / report.critical_path_ms : 0.0);
+        last = std::move(report);
+    }
+
+    std::printf("\n%s", last.ToString().c_str());
+    return 0;
+}
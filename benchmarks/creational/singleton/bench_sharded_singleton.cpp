@@ -0,0 +1,92 @@
+#include "../../../src/creational/singleton/ShardedSingleton.h"
+#include "../../common/BenchUtil.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// 写多读少的全局计数器基准：Meyers 单例持有一个 std::atomic vs ShardedSingleton
+// ----------------------------------
+// N 个线程在固定时长内不断对计数器 +1，报告总吞吐、每线程周期/次与扩展效率，
+// 并校验合并后的计数与实际执行的次数一致；最后单独测量一次 Read()（合并所有分片）的开销。
+//
+// 用法：bench_sharded_singleton [--threads=N] [--ms=M]
+
+namespace {
+
+// 对照组：传统写法，所有线程共享同一个原子变量
+class AtomicCounterSingleton {
+public:
+    static AtomicCounterSingleton& Instance() {
+        static AtomicCounterSingleton instance;
+        return instance;
+    }
+
+    void Add(std::uint64_t n) { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t Read() const { return value_.load(std::memory_order_relaxed); }
+    void Reset() { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    AtomicCounterSingleton() = default;
+    std::atomic<std::uint64_t> value_{0};
+};
+
+struct BenchTag {};
+using ShardedCounter = ShardedSingleton<std::uint64_t, SumReducer<std::uint64_t>, BenchTag>;
+using ShardedPeak = ShardedSingleton<std::uint64_t, MaxReducer<std::uint64_t>, BenchTag>;
+
+template <typename Op, typename ReadFn, typename ResetFn>
+void Bench(const char* name, const bench::Options& opt, Op op, ReadFn read, ResetFn reset,
+           bool check_sum) {
+    double single = 0;
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        reset();
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+        if (threads == 1) {
+            single = tp.OpsPerSecond();
+        }
+        double scaling = single > 0 ? tp.OpsPerSecond() / (threads * single) : 0;
+        const char* check = "";
+        if (check_sum) {
+            check = read() == tp.total_ops ? "ok" : "MISMATCH";
+        }
+        std::printf("%-26s %7u %12.2f %12.2f %9.0f%% %8s\n", name, threads, tp.OpsPerSecond() / 1e6,
+                    tp.cycles_per_op, scaling * 100.0, check);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::printf("bench_sharded_singleton: max threads = %u, duration = %d ms/point, %zu shards\n\n",
+                opt.max_threads, opt.duration_ms, ShardedCounter::Instance().ShardCount());
+
+    std::printf("%-26s %7s %12s %12s %10s %8s\n", "counter", "threads", "Mupdates/s", "cycles/op",
+                "scaling", "sum");
+    Bench(
+        "Meyers + std::atomic", opt, [] { AtomicCounterSingleton::Instance().Add(1); },
+        [] { return AtomicCounterSingleton::Instance().Read(); },
+        [] { AtomicCounterSingleton::Instance().Reset(); }, true);
+    Bench(
+        "ShardedSingleton<Sum>", opt, [] { ShardedCounter::Instance().Update(1); },
+        [] { return ShardedCounter::Instance().Read(); }, [] { ShardedCounter::Instance().Reset(); },
+        true);
+    Bench(
+        "ShardedSingleton<Max>", opt,
+        [] {
+            thread_local std::uint64_t v = 0;
+            ShardedPeak::Instance().Update(++v);
+        },
+        [] { return ShardedPeak::Instance().Read(); }, [] { ShardedPeak::Instance().Reset(); },
+        false);
+
+    auto read_samples = bench::RunLatency(1, opt.samples, [] {
+        bench::DoNotOptimize(ShardedCounter::Instance().Read());
+    });
+    std::printf("\nShardedSingleton<Sum>::Read() over %zu shards: p50 %.0f ns, p99 %.0f ns\n",
+                ShardedCounter::Instance().ShardCount(),
+                bench::Percentile(read_samples, 50) / bench::CyclesPerNs(),
+                bench::Percentile(read_samples, 99) / bench::CyclesPerNs());
+    return 0;
+}
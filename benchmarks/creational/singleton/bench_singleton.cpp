@@ -0,0 +1,272 @@
+#include "../../../src/creational/singleton/SingletonTemplate.h"
+#include "../../../src/creational/singleton/Singletons.h"
+#include "../../common/BenchUtil.h"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define BENCH_HAS_FORK 1
+#endif
+
+// 单例 Instance() 并发访问基准
+// ----------------------------------
+// 两类场景：
+// 1）冷启动（首次调用竞争）：N 个线程在屏障处同时发起第一次 Instance()。
+//    单例一旦构造就无法“重置”，因此每个 (实现, 线程数) 组合都 fork 一个子进程，
+//    子进程里的静态状态是未初始化的全新副本，结果通过管道传回父进程。
+// 2）热路径：实例已经存在，N 个线程持续调用 Instance()，统计吞吐、周期/次、
+//    p50/p99 单次延迟以及扩展效率（N 线程吞吐 / (N × 单线程吞吐)）。
+// 3）访问函数：每种实现的 Instance() 都包进一个 extern "C" 且禁止内联的函数（singleton_access_*），
+//    热路径表中的 "call:" 行通过它们调用，反映“跨翻译单元调用 Instance()”的真实开销；
+//    同时这些符号名固定，可以直接反汇编对比生成的指令：
+//      cmake --build build --target disasm_singleton
+//    ConstinitSingleton 应该只有一条 lea + ret，MeyersSingleton 则多出 guard 检查与
+//    __cxa_guard_acquire 的冷路径。
+//
+// 用法：bench_singleton [--threads=N] [--ms=M] [--samples=S]
+//   --threads 默认为硬件线程数；可以设得比核数更大，观察超订阅下互斥量的退化。
+
+namespace {
+
+// 通用单例模板的被测类型（构造函数必须能常量求值，EagerInit 才能使用）
+class Payload {
+    friend class ::SingletonAccess;
+    constexpr Payload() = default;
+
+public:
+    int value = 0;
+};
+
+using TplMeyers = Singleton<Payload, MeyersInit>;
+using TplCallOnce = Singleton<Payload, CallOnceInit>;
+using TplDCL = Singleton<Payload, DCLInit>;
+using TplEager = Singleton<Payload, EagerInit>;
+using TplWeakRef = Singleton<Payload, WeakRefInit>;
+
+// 对照组：引入线程租约之前的 AtomicSingleton（读写锁 + 全局 weak_ptr::lock()），
+// 用来对比 one-shot 调用方式下两者的开销
+class BaselineAtomicSingleton {
+public:
+    static std::shared_ptr<BaselineAtomicSingleton> Instance() {
+        std::shared_ptr<BaselineAtomicSingleton> tmp;
+        {
+            std::shared_lock<std::shared_mutex> lock(read_mutex_);
+            tmp = instance_.lock();
+        }
+        if (tmp == nullptr) {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            tmp = instance_.lock();
+            if (tmp == nullptr) {
+                tmp = std::shared_ptr<BaselineAtomicSingleton>(new BaselineAtomicSingleton());
+                instance_ = tmp;
+            }
+        }
+        return tmp;
+    }
+
+private:
+    BaselineAtomicSingleton() = default;
+
+    inline static std::weak_ptr<BaselineAtomicSingleton> instance_;
+    inline static std::shared_mutex read_mutex_;
+    inline static std::mutex write_mutex_;
+};
+
+}  // namespace
+
+// 供反汇编与 "call:" 行使用的访问函数
+extern "C" {
+BENCH_NOINLINE void* singleton_access_meyers() { return &MeyersSingleton::Instance(); }
+BENCH_NOINLINE void* singleton_access_hungry() { return &HungrySingleton::Instance(); }
+BENCH_NOINLINE void* singleton_access_call_once() { return &LazySingletonCallOnce::Instance(); }
+BENCH_NOINLINE void* singleton_access_dcl() { return LazySingletonDCL::Instance(); }
+BENCH_NOINLINE void* singleton_access_constinit() { return &ConstinitSingleton::Instance(); }
+BENCH_NOINLINE void* singleton_access_tpl_eager() { return &TplEager::Instance(); }
+}
+
+namespace {
+
+struct ColdResult {
+    double p50 = 0;
+    double max = 0;
+};
+
+#if defined(BENCH_HAS_FORK)
+// 在子进程中让 threads 个线程同时首次调用 access()，返回首次调用延迟（周期）
+template <typename Access>
+bool RunCold(unsigned threads, Access access, ColdResult& out) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // 子进程：屏蔽构造函数里的打印，避免污染基准输出
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+        }
+        close(fds[0]);
+        bench::SpinBarrier barrier(threads);
+        std::vector<std::uint64_t> samples(threads);
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                barrier.ArriveAndWait();
+                std::uint64_t c0 = bench::ReadCycles();
+                auto instance = access();
+                std::uint64_t c1 = bench::ReadCycles();
+                bench::DoNotOptimize(instance);
+                samples[t] = c1 - c0;
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        ColdResult r;
+        r.max = static_cast<double>(*std::max_element(samples.begin(), samples.end()));
+        r.p50 = bench::Percentile(samples, 50);
+        ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(written == static_cast<ssize_t>(sizeof(r)) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], &out, sizeof(out));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return got == static_cast<ssize_t>(sizeof(out)) && WIFEXITED(status) &&
+           WEXITSTATUS(status) == 0;
+}
+#endif
+
+template <typename Access>
+void BenchCold(const char* name, Access access, const bench::Options& opt) {
+#if defined(BENCH_HAS_FORK)
+    const double cpn = bench::CyclesPerNs();
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        ColdResult r;
+        if (!RunCold(threads, access, r)) {
+            std::printf("%-22s %7u   (fork failed)\n", name, threads);
+            continue;
+        }
+        std::printf("%-22s %7u %14.0f %14.0f %12.2f\n", name, threads, r.p50, r.max,
+                    r.max / cpn / 1000.0);
+    }
+#else
+    (void)name;
+    (void)access;
+    (void)opt;
+#endif
+}
+
+template <typename Access>
+void BenchHot(const char* name, Access access, const bench::Options& opt) {
+    const double cpn = bench::CyclesPerNs();
+    auto op = [&] { bench::DoNotOptimize(access()); };
+    double single_thread_ops = 0;
+
+    for (unsigned threads : bench::ThreadCounts(opt.max_threads)) {
+        auto tp = bench::RunThroughput(threads, std::chrono::milliseconds(opt.duration_ms), op);
+        auto samples = bench::RunLatency(threads, opt.samples, op);
+        double p50 = bench::Percentile(samples, 50);
+        double p99 = bench::Percentile(samples, 99);
+        if (threads == 1) {
+            single_thread_ops = tp.OpsPerSecond();
+        }
+        double scaling = single_thread_ops > 0 ? tp.OpsPerSecond() / (threads * single_thread_ops) : 0;
+        std::printf("%-22s %7u %12.2f %12.2f %10.0f %10.0f %10.1f %9.0f%%\n", name, threads,
+                    tp.OpsPerSecond() / 1e6, tp.cycles_per_op, p50, p99, p99 / cpn,
+                    scaling * 100.0);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Options opt = bench::Options::Parse(argc, argv);
+    std::printf("bench_singleton: max threads = %u, duration = %d ms/point, %zu latency samples/thread\n",
+                opt.max_threads, opt.duration_ms, opt.samples);
+    std::printf("cycle counter: %.2f cycles/ns, timer overhead %llu cycles subtracted\n\n",
+                bench::CyclesPerNs(), static_cast<unsigned long long>(bench::TimerOverhead()));
+
+    // 冷启动必须最先跑：父进程中的单例一旦被初始化，fork 出来的子进程就不再“冷”
+    std::printf("== First-call contention (fresh process per row) ==\n");
+    std::printf("%-22s %7s %14s %14s %12s\n", "variant", "threads", "p50(cycles)", "max(cycles)",
+                "max(us)");
+    BenchCold("LazySingletonMutex", [] { return LazySingletonMutex::Instance(); }, opt);
+    BenchCold("LazySingletonDCL", [] { return LazySingletonDCL::Instance(); }, opt);
+    BenchCold("LazySingletonCallOnce", [] { return &LazySingletonCallOnce::Instance(); }, opt);
+    BenchCold("HungrySingleton", [] { return &HungrySingleton::Instance(); }, opt);
+    BenchCold("MeyersSingleton", [] { return &MeyersSingleton::Instance(); }, opt);
+    BenchCold("ConstinitSingleton", [] { return &ConstinitSingleton::Instance(); }, opt);
+    BenchCold("AtomicSingleton", [] { return AtomicSingleton::Instance(); }, opt);
+    BenchCold("Singleton<CallOnce>", [] { return &TplCallOnce::Instance(); }, opt);
+    BenchCold("Singleton<DCL>", [] { return &TplDCL::Instance(); }, opt);
+    BenchCold("Singleton<Meyers>", [] { return &TplMeyers::Instance(); }, opt);
+    BenchCold("Singleton<WeakRef>", [] { return TplWeakRef::Instance(); }, opt);
+
+    // 热路径：先把所有实例构造出来；AtomicSingleton 需要有人持有引用，否则每次调用都会重建
+    auto atomic_keep_alive = AtomicSingleton::Instance();
+    auto baseline_keep_alive = BaselineAtomicSingleton::Instance();
+    LazySingletonUnsafe::Instance();
+    LazySingletonMutex::Instance();
+    LazySingletonDCL::Instance();
+    LazySingletonCallOnce::Instance();
+    MeyersSingleton::Instance();
+    TplMeyers::Instance();
+    TplCallOnce::Instance();
+    TplDCL::Instance();
+
+    std::printf("\n== Hot Instance() (instance already constructed) ==\n");
+    std::printf("%-22s %7s %12s %12s %10s %10s %10s %10s\n", "variant", "threads", "Mops/s",
+                "cycles/call", "p50(cyc)", "p99(cyc)", "p99(ns)", "scaling");
+    BenchHot("LazySingletonUnsafe", [] { return LazySingletonUnsafe::Instance(); }, opt);
+    BenchHot("LazySingletonMutex", [] { return LazySingletonMutex::Instance(); }, opt);
+    BenchHot("LazySingletonDCL", [] { return LazySingletonDCL::Instance(); }, opt);
+    BenchHot("LazySingletonCallOnce", [] { return &LazySingletonCallOnce::Instance(); }, opt);
+    BenchHot("HungrySingleton", [] { return &HungrySingleton::Instance(); }, opt);
+    BenchHot("MeyersSingleton", [] { return &MeyersSingleton::Instance(); }, opt);
+    BenchHot("ConstinitSingleton", [] { return &ConstinitSingleton::Instance(); }, opt);
+    // AtomicSingleton 的读路径依赖线程租约：线程自己持有一份引用时走无共享竞争的快速路径；
+    // 每次取用后立即丢弃（one-shot）时租约留不住，WeakRefInit 识别出这种调用方式后不再建租约，
+    // 直接返回全局强引用，开销应与 base 行（引入租约之前的实现）持平，但同样不随线程数扩展
+    BenchHot("AtomicSingleton(held)", [] {
+        thread_local auto held = AtomicSingleton::Instance();
+        return AtomicSingleton::Instance();
+    }, opt);
+    BenchHot("AtomicSingleton(1shot)", [] { return AtomicSingleton::Instance(); }, opt);
+    BenchHot("AtomicSingleton(base)", [] { return BaselineAtomicSingleton::Instance(); }, opt);
+    BenchHot("Singleton<Meyers>", [] { return &TplMeyers::Instance(); }, opt);
+    BenchHot("Singleton<CallOnce>", [] { return &TplCallOnce::Instance(); }, opt);
+    BenchHot("Singleton<DCL>", [] { return &TplDCL::Instance(); }, opt);
+    BenchHot("Singleton<Eager>", [] { return &TplEager::Instance(); }, opt);
+    BenchHot("Singleton<DCL>::Cached", [] { return &TplDCL::CachedInstance(); }, opt);
+    BenchHot("Singleton<WeakRef>", [] {
+        thread_local auto held = TplWeakRef::Instance();
+        return TplWeakRef::Instance();
+    }, opt);
+    BenchHot("call:Meyers", singleton_access_meyers, opt);
+    BenchHot("call:Hungry", singleton_access_hungry, opt);
+    BenchHot("call:CallOnce", singleton_access_call_once, opt);
+    BenchHot("call:DCL", singleton_access_dcl, opt);
+    BenchHot("call:Constinit", singleton_access_constinit, opt);
+    BenchHot("call:Singleton<Eager>", singleton_access_tpl_eager, opt);
+
+    bench::DoNotOptimize(atomic_keep_alive);
+    bench::DoNotOptimize(baseline_keep_alive);
+    return 0;
+}
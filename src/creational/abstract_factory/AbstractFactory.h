@@ -1,7 +1,16 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "RenderCommandBuffer.h"
 
 // 抽象工厂模式（Abstract Factory）示例
 // -------------------------------------
@@ -19,6 +28,13 @@ class Button {
 public:
     virtual ~Button() = default;
     virtual void Paint() = 0; // 绘制按钮
+
+    // 批量绘制：只记录一条绘制命令，由 commands.Flush() 统一输出。
+    // 默认实现退化为立即 Paint()（输出排在缓冲区中尚未 Flush 的记录之前），
+    // 具体控件覆盖为 commands.Append(RenderCommandBuffer::LineOf<...>())。
+    // 具体控件的输出文本放在 kPaintText 中，逐个 Paint() 与批量绘制共用同一份。
+    // 与 Paint() 不同名：只覆盖 Paint() 的控件不会隐藏它，直接对具体控件调用也能退化为立即绘制
+    virtual void PaintTo(RenderCommandBuffer& /*commands*/) { Paint(); }
 };
 
 // 抽象产品：复选框
@@ -26,46 +42,140 @@ class Checkbox {
 public:
     virtual ~Checkbox() = default;
     virtual void Paint() = 0; // 绘制复选框
+    virtual void PaintTo(RenderCommandBuffer& /*commands*/) { Paint(); }  // 见 Button
 };
 
+// 具体产品声明为 final：动态类型一旦已知（例如栈上的局部对象），Paint() 可以被去虚化
+
 // 具体产品：Windows 风格按钮
-class WindowsButton : public Button {
+class WindowsButton final : public Button {
 public:
+    static constexpr std::string_view kPaintText = "Render Windows Button";
+
     void Paint() override {
-        std::cout << "Render Windows Button" << std::endl;
+        std::cout << kPaintText << std::endl;
+    }
+
+    void PaintTo(RenderCommandBuffer& commands) override {
+        commands.Append(RenderCommandBuffer::LineOf<WindowsButton>());
     }
 };
 
 // 具体产品：Windows 风格复选框
-class WindowsCheckbox : public Checkbox {
+class WindowsCheckbox final : public Checkbox {
 public:
+    static constexpr std::string_view kPaintText = "Render Windows Checkbox";
+
     void Paint() override {
-        std::cout << "Render Windows Checkbox" << std::endl;
+        std::cout << kPaintText << std::endl;
+    }
+
+    void PaintTo(RenderCommandBuffer& commands) override {
+        commands.Append(RenderCommandBuffer::LineOf<WindowsCheckbox>());
     }
 };
 
 // 具体产品：Mac 风格按钮
-class MacButton : public Button {
+class MacButton final : public Button {
 public:
+    static constexpr std::string_view kPaintText = "Render Mac Button";
+
     void Paint() override {
-        std::cout << "Render Mac Button" << std::endl;
+        std::cout << kPaintText << std::endl;
+    }
+
+    void PaintTo(RenderCommandBuffer& commands) override {
+        commands.Append(RenderCommandBuffer::LineOf<MacButton>());
     }
 };
 
 // 具体产品：Mac 风格复选框
-class MacCheckbox : public Checkbox {
+class MacCheckbox final : public Checkbox {
 public:
+    static constexpr std::string_view kPaintText = "Render Mac Checkbox";
+
     void Paint() override {
-        std::cout << "Render Mac Checkbox" << std::endl;
+        std::cout << kPaintText << std::endl;
+    }
+
+    void PaintTo(RenderCommandBuffer& commands) override {
+        commands.Append(RenderCommandBuffer::LineOf<MacCheckbox>());
+    }
+};
+
+// 在 arena 中创建的产品（见文末“按帧分配”）：删除器调用析构函数后把内存交还给分配它的
+// memory_resource。monotonic_buffer_resource 的 deallocate 是空操作，内存随 arena 整体释放；
+// new_delete_resource 等通用资源则会真正释放。resource 为空表示产品来自堆，直接 delete。
+// 指针不能比 arena 活得更久
+struct ArenaDestroy {
+    std::pmr::memory_resource* resource = nullptr;
+    std::uint32_t size = 0;  // 控件很小，32 位足够，ArenaPtr 保持 24 字节
+    std::uint32_t align = 0;
+
+    template <typename T>
+    void operator()(T* object) const {
+        if (resource == nullptr) {
+            delete object;
+            return;
+        }
+        // 经基类指针销毁时，分配的起始地址是完整对象的地址
+        void* memory = MostDerived(object);
+        object->~T();
+        resource->deallocate(memory, size, align);
+    }
+
+private:
+    template <typename T>
+    static void* MostDerived(T* object) {
+        if constexpr (std::is_polymorphic_v<T>) {
+            return dynamic_cast<void*>(object);
+        } else {
+            return static_cast<void*>(object);
+        }
     }
 };
 
+template <typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDestroy>;
+
+// 从 arena 分配并构造 T；构造失败时把内存交还 arena
+template <typename T>
+T* NewInArena(std::pmr::memory_resource& arena) {
+    void* memory = arena.allocate(sizeof(T), alignof(T));
+    try {
+        return ::new (memory) T();
+    } catch (...) {
+        arena.deallocate(memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+// NewInArena 并交给 ArenaPtr，删除器记下归还内存所需的资源、大小与对齐
+template <typename T>
+ArenaPtr<T> MakeInArena(std::pmr::memory_resource& arena) {
+    static_assert(sizeof(T) <= UINT32_MAX, "MakeInArena: object too large");
+    const ArenaDestroy deleter{&arena, static_cast<std::uint32_t>(sizeof(T)),
+                               static_cast<std::uint32_t>(alignof(T))};
+    return ArenaPtr<T>(NewInArena<T>(arena), deleter);
+}
+
 // 抽象工厂：负责创建一整套 UI 控件
 class GUIFactory {
 public:
     virtual ~GUIFactory() = default;
     virtual std::unique_ptr<Button> CreateButton() const = 0;
     virtual std::unique_ptr<Checkbox> CreateCheckbox() const = 0;
+
+    // arena 版本：控件从 arena 线性分配，不单独向堆申请与归还内存。
+    // 具体工厂用 MakeInArena<具体控件>(arena) 覆盖；未覆盖的工厂退回到上面的堆版本
+    // （删除器直接 delete）。与堆版本不同名：只覆盖堆版本的已有工厂不会隐藏它，
+    // 无需修改即可用于 BuildUI
+    virtual ArenaPtr<Button> CreateButtonIn(std::pmr::memory_resource& /*arena*/) const {
+        return ArenaPtr<Button>(CreateButton().release());
+    }
+    virtual ArenaPtr<Checkbox> CreateCheckboxIn(std::pmr::memory_resource& /*arena*/) const {
+        return ArenaPtr<Checkbox>(CreateCheckbox().release());
+    }
 };
 
 // 具体工厂：Windows 工厂
@@ -78,6 +188,14 @@ public:
     std::unique_ptr<Checkbox> CreateCheckbox() const override {
         return std::make_unique<WindowsCheckbox>();
     }
+
+    ArenaPtr<Button> CreateButtonIn(std::pmr::memory_resource& arena) const override {
+        return MakeInArena<WindowsButton>(arena);
+    }
+
+    ArenaPtr<Checkbox> CreateCheckboxIn(std::pmr::memory_resource& arena) const override {
+        return MakeInArena<WindowsCheckbox>(arena);
+    }
 };
 
 // 具体工厂：Mac 工厂
@@ -90,6 +208,14 @@ public:
     std::unique_ptr<Checkbox> CreateCheckbox() const override {
         return std::make_unique<MacCheckbox>();
     }
+
+    ArenaPtr<Button> CreateButtonIn(std::pmr::memory_resource& arena) const override {
+        return MakeInArena<MacButton>(arena);
+    }
+
+    ArenaPtr<Checkbox> CreateCheckboxIn(std::pmr::memory_resource& arena) const override {
+        return MakeInArena<MacCheckbox>(arena);
+    }
 };
 
 // 客户端演示函数：只依赖抽象工厂与抽象产品
@@ -100,6 +226,14 @@ inline void RenderUI(const GUIFactory& factory) {
     checkbox->Paint();
 }
 
+// 批量版本：控件只把绘制命令追加到 commands，调用方在一帧结束时 commands.Flush()
+inline void RenderUI(const GUIFactory& factory, RenderCommandBuffer& commands) {
+    auto button = factory.CreateButton();
+    auto checkbox = factory.CreateCheckbox();
+    button->PaintTo(commands);
+    checkbox->PaintTo(commands);
+}
+
 inline void RunAbstractFactoryDemo() {
     WindowsFactory winFactory;
     MacFactory macFactory;
@@ -110,3 +244,117 @@ inline void RunAbstractFactoryDemo() {
     std::cout << "\nUse MacFactory:" << std::endl;
     RenderUI(macFactory);
 }
+
+// ====================================
+// 性能优化：编译期产品族（静态抽象工厂）
+// ====================================
+// RenderUI(const GUIFactory&) 每绘制一套控件要经过 2 次虚函数创建、2 次堆分配与释放、
+// 2 次虚函数 Paint()。当产品族在编译期（或启动时一次性）就已确定时，可以把工厂换成模板参数：
+// - 产品族是一个只有静态成员函数的类型，CreateButton() / CreateCheckbox() 按值返回具体产品；
+// - 控件是栈上的局部对象，动态类型已知，Paint() 直接调用（final + 已知类型），可以内联；
+// - RenderUI<Family>() 没有任何间接调用，整个函数体可以内联进调用方的循环。
+// 代价：每个产品族实例化一份代码，产品族不能在运行中途切换（启动时选择见 SelectRenderUI）。
+
+// 静态产品族：Windows
+struct WindowsFamily {
+    static WindowsButton CreateButton() { return WindowsButton(); }
+    static WindowsCheckbox CreateCheckbox() { return WindowsCheckbox(); }
+};
+
+// 静态产品族：Mac
+struct MacFamily {
+    static MacButton CreateButton() { return MacButton(); }
+    static MacCheckbox CreateCheckbox() { return MacCheckbox(); }
+};
+
+// 静态工厂约束（C++17 用类型萃取表达，C++20 版本见文件末尾的 concept）：
+// Family::CreateButton() / Family::CreateCheckbox() 可以无参调用，并分别按值返回
+// Button / Checkbox 的具体（非抽象）派生类
+template <typename Family, typename = void>
+struct IsStaticGUIFactory : std::false_type {};
+
+template <typename Family>
+struct IsStaticGUIFactory<Family, std::void_t<decltype(Family::CreateButton()),
+                                              decltype(Family::CreateCheckbox())>>
+    : std::bool_constant<
+          std::is_base_of_v<Button, decltype(Family::CreateButton())> &&
+          std::is_base_of_v<Checkbox, decltype(Family::CreateCheckbox())> &&
+          !std::is_abstract_v<decltype(Family::CreateButton())> &&
+          !std::is_abstract_v<decltype(Family::CreateCheckbox())>> {};
+
+template <typename Family>
+inline constexpr bool kIsStaticGUIFactory = IsStaticGUIFactory<Family>::value;
+
+// 客户端演示函数（静态版本）：与 RenderUI(const GUIFactory&) 输出相同，但没有虚调用与堆分配
+template <typename Family>
+inline void RenderUI() {
+    static_assert(kIsStaticGUIFactory<Family>,
+                  "Family must provide static CreateButton()/CreateCheckbox() returning "
+                  "concrete Button/Checkbox types by value");
+    auto button = Family::CreateButton();
+    auto checkbox = Family::CreateCheckbox();
+    button.Paint();
+    checkbox.Paint();
+}
+
+// 启动时确定产品族：按平台名选出对应的 RenderUI<Family> 实例，之后每次只有一次间接调用。
+// 未知平台返回 nullptr
+using RenderUIFunction = void (*)();
+
+inline RenderUIFunction SelectRenderUI(std::string_view platform) {
+    if (platform == "windows") {
+        return &RenderUI<WindowsFamily>;
+    }
+    if (platform == "mac") {
+        return &RenderUI<MacFamily>;
+    }
+    return nullptr;
+}
+
+// ====================================
+// 性能优化：按帧分配（arena）
+// ====================================
+// 每帧重建整屏控件时，经 CreateButton() / CreateCheckbox() 创建的每个控件都是一次独立的堆分配，
+// 拆除时又逐个释放。arena 版本的工厂方法把一帧的控件（以及保存它们的容器）全部放进同一个
+// std::pmr::memory_resource，典型用法是 std::pmr::monotonic_buffer_resource：
+// - 分配只是移动指针，控件在内存中连续排列；
+// - 帧结束时先销毁控件树（析构函数 + 空操作的 deallocate），再 release()，整块内存 O(1) 归还；
+// - 给 monotonic_buffer_resource 一块跨帧复用的初始缓冲区后，稳定状态下每帧 0 次堆分配。
+// 控件树必须在 arena release() 或销毁之前销毁；arena 不做同步，每个线程使用自己的 arena。
+
+// 一帧的控件树：控件与保存控件指针的容器都分配在同一个 arena 中
+struct ArenaUI {
+    explicit ArenaUI(std::pmr::memory_resource& arena) : buttons(&arena), checkboxes(&arena) {}
+
+    std::pmr::vector<ArenaPtr<Button>> buttons;
+    std::pmr::vector<ArenaPtr<Checkbox>> checkboxes;
+};
+
+// 用 factory 在 arena 中创建 sets 套控件
+inline ArenaUI BuildUI(const GUIFactory& factory, std::size_t sets,
+                       std::pmr::memory_resource& arena) {
+    ArenaUI ui(arena);
+    ui.buttons.reserve(sets);
+    ui.checkboxes.reserve(sets);
+    for (std::size_t i = 0; i < sets; ++i) {
+        ui.buttons.push_back(factory.CreateButtonIn(arena));
+        ui.checkboxes.push_back(factory.CreateCheckboxIn(arena));
+    }
+    return ui;
+}
+
+/* C++20 版本：用 concept 约束静态产品族
+template <typename Family>
+concept StaticGUIFactory = requires {
+    { Family::CreateButton() } -> std::derived_from<Button>;
+    { Family::CreateCheckbox() } -> std::derived_from<Checkbox>;
+};
+
+template <StaticGUIFactory Family>
+void RenderUI() {
+    auto button = Family::CreateButton();
+    auto checkbox = Family::CreateCheckbox();
+    button.Paint();
+    checkbox.Paint();
+}
+*/
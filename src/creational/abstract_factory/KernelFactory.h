@@ -0,0 +1,610 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define KERNEL_FACTORY_X86 1
+// 按函数指定目标指令集：整个工程仍按基线 x86-64 编译，只有这些函数使用更新的指令
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// ===========================
+// 抽象工厂的实际应用：按指令集选择的计算内核族
+// ===========================
+// 与 GUIFactory 的 Windows / Mac 产品族同构：
+// - 抽象产品：CopyKernel（类似 memcpy 的拷贝）、SumKernel（uint32 求和）、
+//   SearchKernel（查找字节，类似 memchr）、ChecksumKernel（CRC32C 校验和）；
+// - 产品族：Scalar / SSE4.2 / AVX2 / AVX-512，同一族的内核使用同一档指令集；
+// - 抽象工厂：KernelFactory，每个具体工厂创建一整族内核。
+//
+// 启动时 SelectKernelFactory() 用 cpuid（以及 xgetbv 确认操作系统保存了对应的寄存器状态）
+// 检测一次 CPU 特性，选出主机支持的最高档，并先用 VerifyKernelFamily() 与标量族逐项比对结果，
+// 比对不一致就退到下一档。之后调用方只持有这一个工厂，产品族内部的各个内核始终配套。
+//
+// 所有产品族对同一输入给出完全相同的结果（整数运算，没有浮点求和顺序的问题）。
+// 非 x86-64 或非 GCC/Clang 编译器下只有标量族。
+//
+//   const KernelFactory& kernels = SelectKernelFactory();
+//   auto crc = kernels.CreateChecksum();
+//   std::uint32_t value = crc->Crc32c(data, size);
+//
+// 注意：部分 CPU 在执行 AVX-512 指令时会降频，短小、零星的调用未必比 AVX2 快；
+// 可以用 KernelFactoryFor(KernelIsa::kAvx2) 显式指定产品族。
+
+enum class KernelIsa { kScalar, kSse42, kAvx2, kAvx512 };
+
+inline const char* KernelIsaName(KernelIsa isa) {
+    switch (isa) {
+    case KernelIsa::kScalar:
+        return "scalar";
+    case KernelIsa::kSse42:
+        return "sse4.2";
+    case KernelIsa::kAvx2:
+        return "avx2";
+    case KernelIsa::kAvx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+// 主机 CPU 特性（只检测一次）
+struct CpuFeatures {
+    bool sse42 = false;
+    bool avx2 = false;      // CPU 支持且操作系统保存 YMM 状态
+    bool avx512bw = false;  // AVX-512F + AVX-512BW，且操作系统保存 ZMM / opmask 状态
+
+    static const CpuFeatures& Host() {
+        static const CpuFeatures features = Detect();
+        return features;
+    }
+
+    bool Supports(KernelIsa isa) const {
+        switch (isa) {
+        case KernelIsa::kScalar:
+            return true;
+        case KernelIsa::kSse42:
+            return sse42;
+        case KernelIsa::kAvx2:
+            return sse42 && avx2;
+        case KernelIsa::kAvx512:
+            return sse42 && avx2 && avx512bw;
+        }
+        return false;
+    }
+
+private:
+    static CpuFeatures Detect() {
+        CpuFeatures features;
+#if defined(KERNEL_FACTORY_X86)
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return features;
+        }
+        features.sse42 = (ecx & bit_SSE4_2) != 0;
+        const bool osxsave = (ecx & bit_OSXSAVE) != 0;
+        const bool avx = (ecx & bit_AVX) != 0;
+        std::uint64_t xcr0 = 0;
+        if (osxsave) {
+            unsigned lo = 0, hi = 0;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            xcr0 = (static_cast<std::uint64_t>(hi) << 32) | lo;
+        }
+        const bool os_ymm = (xcr0 & 0x6) == 0x6;     // XMM + YMM
+        const bool os_zmm = (xcr0 & 0xe6) == 0xe6;   // 另加 opmask、ZMM0-15 高半部分、ZMM16-31
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            features.avx2 = avx && os_ymm && (ebx & bit_AVX2) != 0;
+            features.avx512bw =
+                os_zmm && (ebx & bit_AVX512F) != 0 && (ebx & bit_AVX512BW) != 0;
+        }
+#endif
+        return features;
+    }
+};
+
+// ===========================
+// 抽象产品
+// ===========================
+
+class CopyKernel {
+public:
+    virtual ~CopyKernel() = default;
+    // 拷贝 n 字节，src 与 dst 不得重叠
+    virtual void Copy(void* dst, const void* src, std::size_t n) const = 0;
+};
+
+class SumKernel {
+public:
+    virtual ~SumKernel() = default;
+    // 求和（64 位累加，不会溢出到 2^32 个元素以上才需要考虑的范围）
+    virtual std::uint64_t Sum(const std::uint32_t* data, std::size_t n) const = 0;
+};
+
+class SearchKernel {
+public:
+    virtual ~SearchKernel() = default;
+    // 返回 value 第一次出现的下标，没有时返回 n
+    virtual std::size_t Find(const std::uint8_t* data, std::size_t n, std::uint8_t value) const = 0;
+};
+
+class ChecksumKernel {
+public:
+    virtual ~ChecksumKernel() = default;
+    // CRC32C（Castagnoli）；crc 为前一段数据的结果，可分段计算
+    virtual std::uint32_t Crc32c(const void* data, std::size_t n, std::uint32_t crc = 0) const = 0;
+};
+
+// ===========================
+// 抽象工厂
+// ===========================
+
+class KernelFactory {
+public:
+    virtual ~KernelFactory() = default;
+    virtual KernelIsa Isa() const = 0;
+    virtual std::unique_ptr<CopyKernel> CreateCopy() const = 0;
+    virtual std::unique_ptr<SumKernel> CreateSum() const = 0;
+    virtual std::unique_ptr<SearchKernel> CreateSearch() const = 0;
+    virtual std::unique_ptr<ChecksumKernel> CreateChecksum() const = 0;
+
+    const char* Name() const { return KernelIsaName(Isa()); }
+};
+
+// 具体工厂：由四个具体内核类型组成一个产品族，类型层面保证族内配套
+template <KernelIsa kIsa, typename Copy, typename Sum, typename Search, typename Checksum>
+class KernelFamily final : public KernelFactory {
+public:
+    KernelIsa Isa() const override { return kIsa; }
+    std::unique_ptr<CopyKernel> CreateCopy() const override { return std::make_unique<Copy>(); }
+    std::unique_ptr<SumKernel> CreateSum() const override { return std::make_unique<Sum>(); }
+    std::unique_ptr<SearchKernel> CreateSearch() const override {
+        return std::make_unique<Search>();
+    }
+    std::unique_ptr<ChecksumKernel> CreateChecksum() const override {
+        return std::make_unique<Checksum>();
+    }
+};
+
+// ===========================
+// 标量族（可移植 C++，任何平台可用）
+// ===========================
+
+// CRC32C 查表法使用的表（反射多项式 0x82F63B78），编译期生成
+constexpr std::array<std::uint32_t, 256> MakeCrc32cTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) != 0 ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+inline constexpr std::array<std::uint32_t, 256> kCrc32cTable = MakeCrc32cTable();
+
+// 拷贝直接交给 std::memcpy：手写的逐字节循环同样会被编译器识别成 memcpy 调用，
+// 而 glibc 的 memcpy 本身也在加载时按 CPU 特性选择实现（同一思路的另一个实例）
+class ScalarCopyKernel final : public CopyKernel {
+public:
+    void Copy(void* dst, const void* src, std::size_t n) const override {
+        if (n != 0) {
+            std::memcpy(dst, src, n);
+        }
+    }
+};
+
+class ScalarSumKernel final : public SumKernel {
+public:
+    std::uint64_t Sum(const std::uint32_t* data, std::size_t n) const override {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += data[i];
+        }
+        return sum;
+    }
+};
+
+class ScalarSearchKernel final : public SearchKernel {
+public:
+    std::size_t Find(const std::uint8_t* data, std::size_t n, std::uint8_t value) const override {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+};
+
+class ScalarChecksumKernel final : public ChecksumKernel {
+public:
+    std::uint32_t Crc32c(const void* data, std::size_t n, std::uint32_t crc = 0) const override {
+        const auto* p = static_cast<const unsigned char*>(data);
+        std::uint32_t c = ~crc;
+        for (std::size_t i = 0; i < n; ++i) {
+            c = kCrc32cTable[(c ^ p[i]) & 0xff] ^ (c >> 8);
+        }
+        return ~c;
+    }
+};
+
+using ScalarKernelFactory = KernelFamily<KernelIsa::kScalar, ScalarCopyKernel, ScalarSumKernel,
+                                         ScalarSearchKernel, ScalarChecksumKernel>;
+
+#if defined(KERNEL_FACTORY_X86)
+
+// ===========================
+// SSE4.2 族（128 位）
+// ===========================
+
+class Sse42CopyKernel final : public CopyKernel {
+public:
+    KERNEL_TARGET("sse4.2")
+    void Copy(void* dst, const void* src, std::size_t n) const override {
+        auto* d = static_cast<unsigned char*>(dst);
+        const auto* s = static_cast<const unsigned char*>(src);
+        std::size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 16));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 32));
+            __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 48));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i + 16), b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i + 32), c);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i + 48), e);
+        }
+        for (; i + 16 <= n; i += 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+        }
+        for (; i < n; ++i) {
+            d[i] = s[i];
+        }
+    }
+};
+
+class Sse42SumKernel final : public SumKernel {
+public:
+    KERNEL_TARGET("sse4.2")
+    std::uint64_t Sum(const std::uint32_t* data, std::size_t n) const override {
+        // 每次读 4 个 uint32，零扩展为两组 2 × uint64 分别累加
+        __m128i lo = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            lo = _mm_add_epi64(lo, _mm_cvtepu32_epi64(v));
+            hi = _mm_add_epi64(hi, _mm_cvtepu32_epi64(_mm_srli_si128(v, 8)));
+        }
+        __m128i total = _mm_add_epi64(lo, hi);
+        std::uint64_t sum = static_cast<std::uint64_t>(_mm_cvtsi128_si64(total)) +
+                            static_cast<std::uint64_t>(_mm_extract_epi64(total, 1));
+        for (; i < n; ++i) {
+            sum += data[i];
+        }
+        return sum;
+    }
+};
+
+class Sse42SearchKernel final : public SearchKernel {
+public:
+    KERNEL_TARGET("sse4.2")
+    std::size_t Find(const std::uint8_t* data, std::size_t n, std::uint8_t value) const override {
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+            if (mask != 0) {
+                return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+        }
+        for (; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+};
+
+// CRC32C 硬件指令（SSE4.2 引入），更高的产品族沿用同一内核
+class Sse42ChecksumKernel final : public ChecksumKernel {
+public:
+    KERNEL_TARGET("sse4.2")
+    std::uint32_t Crc32c(const void* data, std::size_t n, std::uint32_t crc = 0) const override {
+        const auto* p = static_cast<const unsigned char*>(data);
+        std::uint64_t c = ~crc;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p + i, sizeof(word));
+            c = _mm_crc32_u64(c, word);
+        }
+        auto c32 = static_cast<std::uint32_t>(c);
+        for (; i < n; ++i) {
+            c32 = _mm_crc32_u8(c32, p[i]);
+        }
+        return ~c32;
+    }
+};
+
+using Sse42KernelFactory = KernelFamily<KernelIsa::kSse42, Sse42CopyKernel, Sse42SumKernel,
+                                        Sse42SearchKernel, Sse42ChecksumKernel>;
+
+// ===========================
+// AVX2 族（256 位）
+// ===========================
+
+class Avx2CopyKernel final : public CopyKernel {
+public:
+    KERNEL_TARGET("avx2")
+    void Copy(void* dst, const void* src, std::size_t n) const override {
+        auto* d = static_cast<unsigned char*>(dst);
+        const auto* s = static_cast<const unsigned char*>(src);
+        std::size_t i = 0;
+        for (; i + 128 <= n; i += 128) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 32));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 64));
+            __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 96));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 32), b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 64), c);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 96), e);
+        }
+        for (; i + 32 <= n; i += 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)));
+        }
+        for (; i < n; ++i) {
+            d[i] = s[i];
+        }
+    }
+};
+
+class Avx2SumKernel final : public SumKernel {
+public:
+    KERNEL_TARGET("avx2")
+    std::uint64_t Sum(const std::uint32_t* data, std::size_t n) const override {
+        // 每次读 8 个 uint32，两半分别零扩展为 4 × uint64 累加
+        __m256i lo = _mm256_setzero_si256();
+        __m256i hi = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+            lo = _mm256_add_epi64(lo, _mm256_cvtepu32_epi64(a));
+            hi = _mm256_add_epi64(hi, _mm256_cvtepu32_epi64(b));
+        }
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(lo, hi));
+        std::uint64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        for (; i < n; ++i) {
+            sum += data[i];
+        }
+        return sum;
+    }
+};
+
+class Avx2SearchKernel final : public SearchKernel {
+public:
+    KERNEL_TARGET("avx2")
+    std::size_t Find(const std::uint8_t* data, std::size_t n, std::uint8_t value) const override {
+        const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+            if (mask != 0) {
+                return i + static_cast<std::size_t>(__builtin_ctz(mask));
+            }
+        }
+        for (; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+};
+
+using Avx2KernelFactory = KernelFamily<KernelIsa::kAvx2, Avx2CopyKernel, Avx2SumKernel,
+                                       Avx2SearchKernel, Sse42ChecksumKernel>;
+
+// ===========================
+// AVX-512 族（512 位，需要 AVX-512F + AVX-512BW）
+// ===========================
+
+class Avx512CopyKernel final : public CopyKernel {
+public:
+    KERNEL_TARGET("avx512f")
+    void Copy(void* dst, const void* src, std::size_t n) const override {
+        auto* d = static_cast<unsigned char*>(dst);
+        const auto* s = static_cast<const unsigned char*>(src);
+        std::size_t i = 0;
+        for (; i + 256 <= n; i += 256) {
+            __m512i a = _mm512_loadu_si512(s + i);
+            __m512i b = _mm512_loadu_si512(s + i + 64);
+            __m512i c = _mm512_loadu_si512(s + i + 128);
+            __m512i e = _mm512_loadu_si512(s + i + 192);
+            _mm512_storeu_si512(d + i, a);
+            _mm512_storeu_si512(d + i + 64, b);
+            _mm512_storeu_si512(d + i + 128, c);
+            _mm512_storeu_si512(d + i + 192, e);
+        }
+        for (; i + 64 <= n; i += 64) {
+            _mm512_storeu_si512(d + i, _mm512_loadu_si512(s + i));
+        }
+        for (; i < n; ++i) {
+            d[i] = s[i];
+        }
+    }
+};
+
+class Avx512SumKernel final : public SumKernel {
+public:
+    KERNEL_TARGET("avx512f")
+    std::uint64_t Sum(const std::uint32_t* data, std::size_t n) const override {
+        // 每次读 16 个 uint32，两半分别零扩展为 8 × uint64 累加
+        __m512i lo = _mm512_setzero_si512();
+        __m512i hi = _mm512_setzero_si512();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8));
+            // maskz 形式（全 1 掩码）与不带掩码的形式结果相同，但 GCC 12 对后者内部的
+            // _mm512_undefined 会误报未初始化警告
+            lo = _mm512_add_epi64(lo, _mm512_maskz_cvtepu32_epi64(0xff, a));
+            hi = _mm512_add_epi64(hi, _mm512_maskz_cvtepu32_epi64(0xff, b));
+        }
+        alignas(64) std::uint64_t lanes[8];
+        _mm512_store_si512(lanes, _mm512_add_epi64(lo, hi));
+        std::uint64_t sum = 0;
+        for (std::uint64_t lane : lanes) {
+            sum += lane;
+        }
+        for (; i < n; ++i) {
+            sum += data[i];
+        }
+        return sum;
+    }
+};
+
+class Avx512SearchKernel final : public SearchKernel {
+public:
+    KERNEL_TARGET("avx512f,avx512bw")
+    std::size_t Find(const std::uint8_t* data, std::size_t n, std::uint8_t value) const override {
+        const __m512i needle = _mm512_set1_epi8(static_cast<char>(value));
+        std::size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            __mmask64 mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(data + i), needle);
+            if (mask != 0) {
+                return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+            }
+        }
+        for (; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+};
+
+using Avx512KernelFactory = KernelFamily<KernelIsa::kAvx512, Avx512CopyKernel, Avx512SumKernel,
+                                         Avx512SearchKernel, Sse42ChecksumKernel>;
+
+#endif  // KERNEL_FACTORY_X86
+
+// ===========================
+// 工厂获取与启动时选择
+// ===========================
+
+// 取得 isa 对应的工厂（无状态，进程内单例）；主机不支持或未编译该族时返回 nullptr
+inline const KernelFactory* KernelFactoryFor(KernelIsa isa) {
+    if (!CpuFeatures::Host().Supports(isa)) {
+        return nullptr;
+    }
+    switch (isa) {
+    case KernelIsa::kScalar: {
+        static const ScalarKernelFactory factory;
+        return &factory;
+    }
+#if defined(KERNEL_FACTORY_X86)
+    case KernelIsa::kSse42: {
+        static const Sse42KernelFactory factory;
+        return &factory;
+    }
+    case KernelIsa::kAvx2: {
+        static const Avx2KernelFactory factory;
+        return &factory;
+    }
+    case KernelIsa::kAvx512: {
+        static const Avx512KernelFactory factory;
+        return &factory;
+    }
+#else
+    default:
+        break;
+#endif
+    }
+    return nullptr;
+}
+
+// 用确定的伪随机输入，把 family 的每个内核与标量族逐项比对（覆盖各种长度与未对齐的起始地址）
+inline bool VerifyKernelFamily(const KernelFactory& family) {
+    static const ScalarKernelFactory reference;
+    auto copy = family.CreateCopy();
+    auto sum = family.CreateSum();
+    auto search = family.CreateSearch();
+    auto checksum = family.CreateChecksum();
+    auto ref_sum = reference.CreateSum();
+    auto ref_search = reference.CreateSearch();
+    auto ref_checksum = reference.CreateChecksum();
+
+    constexpr std::size_t kMaxSize = 1100;  // 大于 AVX-512 拷贝一轮展开（256 字节）的数倍
+    constexpr std::size_t kMaxOffset = 7;
+    std::mt19937 rng(20240611);
+    std::vector<std::uint8_t> bytes(kMaxSize + kMaxOffset + 64);
+    std::vector<std::uint32_t> words(kMaxSize + kMaxOffset);
+    for (auto& b : bytes) {
+        b = static_cast<std::uint8_t>(rng() % 251);  // 值 251..255 不出现，作为“找不到”的目标
+    }
+    for (auto& w : words) {
+        w = static_cast<std::uint32_t>(rng());
+    }
+    std::vector<std::uint8_t> out(bytes.size());
+
+    for (std::size_t n = 0; n <= kMaxSize; n += (n < 80 ? 1 : 37)) {
+        for (std::size_t offset = 0; offset <= kMaxOffset; offset += 3) {
+            const std::uint8_t* src = bytes.data() + offset;
+            std::fill(out.begin(), out.end(), 0xee);
+            copy->Copy(out.data() + offset, src, n);
+            if (std::memcmp(out.data() + offset, src, n) != 0 || out[offset + n] != 0xee ||
+                (offset > 0 && out[offset - 1] != 0xee)) {
+                return false;
+            }
+            if (sum->Sum(words.data() + offset, n) != ref_sum->Sum(words.data() + offset, n)) {
+                return false;
+            }
+            const std::uint8_t targets[] = {src[n / 2], src[n == 0 ? 0 : n - 1], 0, 253};
+            for (std::uint8_t target : targets) {
+                if (search->Find(src, n, target) != ref_search->Find(src, n, target)) {
+                    return false;
+                }
+            }
+            if (checksum->Crc32c(src, n, 0x1234u) != ref_checksum->Crc32c(src, n, 0x1234u)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 启动时调用：检测一次 CPU 特性，返回主机支持且通过校验的最高一档工厂（至少是标量族）
+inline const KernelFactory& SelectKernelFactory() {
+    static const KernelFactory* selected = [] {
+        constexpr KernelIsa kPreference[] = {KernelIsa::kAvx512, KernelIsa::kAvx2,
+                                             KernelIsa::kSse42};
+        for (KernelIsa isa : kPreference) {
+            const KernelFactory* factory = KernelFactoryFor(isa);
+            if (factory != nullptr && VerifyKernelFamily(*factory)) {
+                return factory;
+            }
+        }
+        return KernelFactoryFor(KernelIsa::kScalar);
+    }();
+    return *selected;
+}
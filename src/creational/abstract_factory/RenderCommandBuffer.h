@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// ===========================
+// 批量绘制：渲染命令缓冲区
+// ===========================
+// Button::Paint() / Checkbox::Paint() 每次写一行并 std::endl 刷新，绘制 N 个控件就是 N 次 write 系统调用。
+// RenderCommandBuffer 把“绘制”拆成两个阶段：
+// 1）记录：控件调用 PaintTo(RenderCommandBuffer&)，只追加一条 2 字节的绘制记录（输出行的编号）；
+// 2）提交：Flush() 先做计数排序的计数阶段，得到每一行的数量，再按编号分组输出。
+//    同一编号输出的文本完全相同，因此每组只需引用一块预先重复好的文本（约 64 KiB），
+//    用 iovec 指向它若干次；全部 iovec 以 writev 成批写出（每次最多 IOV_MAX 个，处理部分写入）。
+//    10M 个控件约 220 MB 输出，只需要几次 writev。
+//
+// 输出行在运行时登记（RegisterLine / LineOf<Widget>()），编号按登记顺序分配，新增控件不需要修改本文件。
+// 控件类的 kPaintText 是该控件输出文本的唯一出处，逐个 Paint() 与批量绘制都使用它。
+//
+// 输出顺序：按编号（登记顺序）分组，每组内的行数与记录数相同；
+// 不同行之间不再保持原来的交错顺序。如果以后绘制记录带有各自的参数（坐标、文字），
+// 需要在计数之后再做一遍稳定的分桶放置，组内仍保持追加顺序。
+//
+// 线程安全：登记是线程安全的；单个缓冲区不做同步，每个线程使用自己的缓冲区。
+
+class RenderCommandBuffer {
+public:
+#if defined(_WIN32)
+    static constexpr int kStdout = 1;
+#else
+    static constexpr int kStdout = STDOUT_FILENO;
+#endif
+
+    struct FlushStats {
+        std::size_t records = 0;  // 输出的绘制记录数
+        std::size_t bytes = 0;    // 写出的字节数
+        std::size_t writes = 0;   // 写系统调用次数
+        bool ok = true;           // 写入失败时为 false（缓冲区仍会清空）
+    };
+
+    // 输出行的编号
+    using LineId = std::uint16_t;
+    static constexpr std::size_t kMaxLines = 65536;
+
+    // 登记一行输出（text 不含换行，输出时每条记录一行），返回它的编号；相同文本返回同一编号。
+    // 登记过的行在进程内一直有效；超过 kMaxLines 行时抛出 std::length_error
+    static LineId RegisterLine(std::string_view text) {
+        LineTable& table = Lines();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (std::size_t id = 0; id < table.lines.size(); ++id) {
+            const std::string& line = table.lines[id]->text;
+            if (std::string_view(line).substr(0, line.size() - 1) == text) {
+                return static_cast<LineId>(id);
+            }
+        }
+        if (table.lines.size() == kMaxLines) {
+            throw std::length_error("RenderCommandBuffer: too many paint lines");
+        }
+        auto line = std::make_unique<Line>();
+        line->text.reserve(text.size() + 1);
+        line->text.append(text).push_back('\n');
+        table.lines.push_back(std::move(line));
+        return static_cast<LineId>(table.lines.size() - 1);
+    }
+
+    // 控件类型 Widget 的输出行（Widget::kPaintText），每个类型第一次调用时登记
+    template <typename Widget>
+    static LineId LineOf() {
+        static const LineId id = RegisterLine(Widget::kPaintText);
+        return id;
+    }
+
+    // 已登记的行数（编号的上界）
+    static std::size_t LineCount() {
+        LineTable& table = Lines();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.lines.size();
+    }
+
+    void Append(LineId line) { records_.push_back(line); }
+
+    void Reserve(std::size_t records) { records_.reserve(records); }
+    std::size_t Size() const { return records_.size(); }
+    bool Empty() const { return records_.empty(); }
+    void Clear() { records_.clear(); }
+
+    // 每一行的记录数，按编号下标（计数排序的计数阶段）
+    std::vector<std::size_t> Histogram() const {
+        std::vector<std::size_t> counts(LineCount());
+        for (LineId line : records_) {
+            ++counts[line];
+        }
+        return counts;
+    }
+
+    // 按编号分组后写到 fd（默认标准输出），然后清空缓冲区。
+    // 先刷新 std::cout，保证之前经 std::cout 输出的内容排在前面
+    FlushStats Flush(int fd = kStdout) {
+        std::cout.flush();
+        FlushStats stats;
+        stats.records = records_.size();
+        std::vector<Chunk> chunks = Plan(Histogram());
+        records_.clear();
+
+        std::size_t next = 0;
+        while (next < chunks.size()) {
+            std::size_t count = std::min(chunks.size() - next, kMaxChunksPerWrite);
+            std::size_t written = 0;
+            if (!WriteAll(fd, chunks.data() + next, count, written, stats.writes)) {
+                stats.bytes += written;
+                stats.ok = false;
+                break;
+            }
+            stats.bytes += written;
+            next += count;
+        }
+        return stats;
+    }
+
+    // 按与 Flush() 相同的顺序拼出输出内容（测试与调试用），不清空缓冲区
+    std::string Render() const {
+        std::string out;
+        for (const Chunk& chunk : Plan(Histogram())) {
+            out.append(chunk.data, chunk.size);
+        }
+        return out;
+    }
+
+private:
+    struct Chunk {
+        const char* data;
+        std::size_t size;
+    };
+
+#if defined(_WIN32)
+    static constexpr std::size_t kMaxChunksPerWrite = 1;
+#else
+    static constexpr std::size_t kMaxChunksPerWrite = IOV_MAX;
+#endif
+    static constexpr std::size_t kRepeatBytes = 64 * 1024;
+
+    struct Line {
+        std::string text;      // 含换行
+        std::string repeated;  // text 重复到约 kRepeatBytes 字节（整行），第一次输出时构建
+    };
+
+    // 全部已登记的行；Line 单独分配，登记新行时已有的文本地址不变
+    struct LineTable {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Line>> lines;
+    };
+
+    // 故意不析构：静态析构阶段仍可能有缓冲区在 Flush()
+    static LineTable& Lines() {
+        static LineTable* table = new LineTable();
+        return *table;
+    }
+
+    // 每组 counts[id] 行，拆成若干段指向该行的重复文本块
+    static std::vector<Chunk> Plan(const std::vector<std::size_t>& counts) {
+        std::vector<Chunk> chunks;
+        LineTable& table = Lines();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (std::size_t id = 0; id < counts.size(); ++id) {
+            if (counts[id] == 0) {
+                continue;
+            }
+            Line& line = *table.lines[id];
+            const std::size_t size = line.text.size();
+            if (line.repeated.empty()) {
+                const std::size_t repeat = std::max<std::size_t>(1, kRepeatBytes / size);
+                line.repeated.reserve(repeat * size);
+                for (std::size_t i = 0; i < repeat; ++i) {
+                    line.repeated.append(line.text);
+                }
+            }
+            const std::size_t per_block = line.repeated.size() / size;
+            for (std::size_t remaining = counts[id]; remaining > 0;) {
+                std::size_t lines = std::min(remaining, per_block);
+                chunks.push_back(Chunk{line.repeated.data(), lines * size});
+                remaining -= lines;
+            }
+        }
+        return chunks;
+    }
+
+    // 写出 count 段，处理部分写入与 EINTR；written 累计写出的字节数
+    static bool WriteAll(int fd, Chunk* chunks, std::size_t count, std::size_t& written,
+                         std::size_t& writes) {
+#if defined(_WIN32)
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* data = chunks[i].data;
+            std::size_t left = chunks[i].size;
+            while (left > 0) {
+                int n = ::_write(fd, data, static_cast<unsigned>(std::min<std::size_t>(left, 1 << 30)));
+                ++writes;
+                if (n <= 0) {
+                    return false;
+                }
+                data += n;
+                left -= static_cast<std::size_t>(n);
+                written += static_cast<std::size_t>(n);
+            }
+        }
+        return true;
+#else
+        std::vector<iovec> iov(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = const_cast<char*>(chunks[i].data);
+            iov[i].iov_len = chunks[i].size;
+        }
+        iovec* first = iov.data();
+        std::size_t left = count;
+        while (left > 0) {
+            ssize_t n = ::writev(fd, first, static_cast<int>(left));
+            ++writes;
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            written += static_cast<std::size_t>(n);
+            // 跳过已完整写出的段，调整写了一半的段
+            auto done = static_cast<std::size_t>(n);
+            while (left > 0 && done >= first->iov_len) {
+                done -= first->iov_len;
+                ++first;
+                --left;
+            }
+            if (left > 0) {
+                first->iov_base = static_cast<char*>(first->iov_base) + done;
+                first->iov_len -= done;
+            }
+        }
+        return true;
+#endif
+    }
+
+    std::vector<LineId> records_;
+};
@@ -1,8 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 // 建造者模式（Builder）示例
 // ---------------------------
@@ -40,15 +51,28 @@ public:
     virtual std::unique_ptr<Computer> GetResult() = 0;
 };
 
+// 一种配置的四个组件名：std::string 建造者与紧凑建造者（见下文）共用同一份，修改一处即可
+struct ComputerComponents {
+    std::string_view cpu;
+    std::string_view gpu;
+    std::string_view ram;
+    std::string_view storage;
+};
+
+inline constexpr ComputerComponents kGamingComponents{"High-end CPU", "High-end GPU", "32GB",
+                                                      "1TB SSD"};
+inline constexpr ComputerComponents kOfficeComponents{"Mid-range CPU", "Integrated GPU", "16GB",
+                                                      "512GB SSD"};
+
 // 具体建造者：游戏电脑
 class GamingComputerBuilder : public ComputerBuilder {
 public:
     GamingComputerBuilder() { computer_ = std::make_unique<Computer>(); }
 
-    void BuildCPU() override { computer_->cpu = "High-end CPU"; }
-    void BuildGPU() override { computer_->gpu = "High-end GPU"; }
-    void BuildRAM() override { computer_->ram = "32GB"; }
-    void BuildStorage() override { computer_->storage = "1TB SSD"; }
+    void BuildCPU() override { computer_->cpu = kGamingComponents.cpu; }
+    void BuildGPU() override { computer_->gpu = kGamingComponents.gpu; }
+    void BuildRAM() override { computer_->ram = kGamingComponents.ram; }
+    void BuildStorage() override { computer_->storage = kGamingComponents.storage; }
     std::unique_ptr<Computer> GetResult() override { return std::move(computer_); }
 
 private:
@@ -60,10 +84,10 @@ class OfficeComputerBuilder : public ComputerBuilder {
 public:
     OfficeComputerBuilder() { computer_ = std::make_unique<Computer>(); }
 
-    void BuildCPU() override { computer_->cpu = "Mid-range CPU"; }
-    void BuildGPU() override { computer_->gpu = "Integrated GPU"; }
-    void BuildRAM() override { computer_->ram = "16GB"; }
-    void BuildStorage() override { computer_->storage = "512GB SSD"; }
+    void BuildCPU() override { computer_->cpu = kOfficeComponents.cpu; }
+    void BuildGPU() override { computer_->gpu = kOfficeComponents.gpu; }
+    void BuildRAM() override { computer_->ram = kOfficeComponents.ram; }
+    void BuildStorage() override { computer_->storage = kOfficeComponents.storage; }
     std::unique_ptr<Computer> GetResult() override { return std::move(computer_); }
 
 private:
@@ -99,3 +123,189 @@ inline void RunBuilderDemo() {
     std::cout << "\nOffice PC:\n";
     officePC->Show();
 }
+
+// ====================================
+// 性能优化：紧凑产品 + 组件字符串驻留
+// ====================================
+// Computer 的四个 std::string 字段每台 128 字节，Director::Construct 每台电脑还要一次堆分配，
+// 每个构建步骤都复制一次组件名（memcpy；超过 SSO 长度时还有堆分配）。
+// 批量生成数百万台配置时，绝大多数时间花在这些复制和分配上，而组件名其实只有少数几种。
+// - ComponentTable：组件字符串驻留表，每种字符串只保存一份，用 16 位 id 表示；
+// - CompactComputer：四个 id，共 8 字节，可平凡复制；需要字符串时再 Expand() 成 Computer；
+// - CompactComputerBuilder：构建步骤直接写入调用方提供的 CompactComputer，建造者本身不持有产品，
+//   可以反复使用；组件 id 在建造者构造时驻留一次，构建步骤只是写入整数；
+// - CompactDirector：构建到调用方提供的存储（单台 / 连续数组）或 arena。
+
+using ComponentId = std::uint16_t;
+
+// 组件字符串驻留表（进程级）：Intern 相同字符串总是返回同一个 id，id 0 固定表示空字符串。
+// 驻留过的字符串永不释放，Name() 返回的 string_view 一直有效。Intern / Name 可并发调用
+class ComponentTable {
+public:
+    // 超过 id 上限（65536 种）时抛出 std::length_error
+    static ComponentId Intern(std::string_view text) {
+        ComponentTable& table = Instance();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex_);
+            auto it = table.ids_.find(text);
+            if (it != table.ids_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(table.mutex_);
+        return table.InternLocked(text);
+    }
+
+    // 未知 id 返回空字符串
+    static std::string_view Name(ComponentId id) {
+        ComponentTable& table = Instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex_);
+        return id < table.names_.size() ? std::string_view(table.names_[id]) : std::string_view();
+    }
+
+    // 已驻留的字符串种数（含空字符串）
+    static std::size_t Size() {
+        ComponentTable& table = Instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex_);
+        return table.names_.size();
+    }
+
+private:
+    ComponentTable() { InternLocked(std::string_view()); }
+
+    // 故意泄漏：静态析构阶段仍可能有代码访问驻留表
+    static ComponentTable& Instance() {
+        static ComponentTable* table = new ComponentTable();
+        return *table;
+    }
+
+    ComponentId InternLocked(std::string_view text) {
+        auto it = ids_.find(text);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        if (names_.size() > 0xFFFF) {
+            throw std::length_error("ComponentTable: too many distinct component names");
+        }
+        auto id = static_cast<ComponentId>(names_.size());
+        names_.emplace_back(text);  // deque 追加不移动已有元素，键中的 string_view 保持有效
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    std::shared_mutex mutex_;
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, ComponentId> ids_;
+};
+
+// 紧凑产品：每个组件一个驻留 id
+struct CompactComputer {
+    ComponentId cpu = 0;
+    ComponentId gpu = 0;
+    ComponentId ram = 0;
+    ComponentId storage = 0;
+
+    // 还原成字符串形式的 Computer
+    Computer Expand() const {
+        Computer computer;
+        computer.cpu = ComponentTable::Name(cpu);
+        computer.gpu = ComponentTable::Name(gpu);
+        computer.ram = ComponentTable::Name(ram);
+        computer.storage = ComponentTable::Name(storage);
+        return computer;
+    }
+
+    void Show() const { Expand().Show(); }
+};
+
+static_assert(sizeof(CompactComputer) == 8, "CompactComputer should stay 8 bytes");
+static_assert(std::is_trivially_copyable_v<CompactComputer>);
+
+// 抽象建造者（紧凑版本）：每一步写入调用方提供的产品，建造者无状态、可反复使用
+class CompactComputerBuilder {
+public:
+    virtual ~CompactComputerBuilder() = default;
+    virtual void BuildCPU(CompactComputer& computer) const = 0;
+    virtual void BuildGPU(CompactComputer& computer) const = 0;
+    virtual void BuildRAM(CompactComputer& computer) const = 0;
+    virtual void BuildStorage(CompactComputer& computer) const = 0;
+};
+
+// 按四个组件名构造的具体建造者；组件名只在构造时驻留一次
+class FixedCompactComputerBuilder : public CompactComputerBuilder {
+public:
+    FixedCompactComputerBuilder(std::string_view cpu, std::string_view gpu, std::string_view ram,
+                                std::string_view storage)
+        : cpu_(ComponentTable::Intern(cpu)),
+          gpu_(ComponentTable::Intern(gpu)),
+          ram_(ComponentTable::Intern(ram)),
+          storage_(ComponentTable::Intern(storage)) {}
+
+    explicit FixedCompactComputerBuilder(const ComputerComponents& components)
+        : FixedCompactComputerBuilder(components.cpu, components.gpu, components.ram,
+                                      components.storage) {}
+
+    void BuildCPU(CompactComputer& computer) const override { computer.cpu = cpu_; }
+    void BuildGPU(CompactComputer& computer) const override { computer.gpu = gpu_; }
+    void BuildRAM(CompactComputer& computer) const override { computer.ram = ram_; }
+    void BuildStorage(CompactComputer& computer) const override { computer.storage = storage_; }
+
+private:
+    ComponentId cpu_;
+    ComponentId gpu_;
+    ComponentId ram_;
+    ComponentId storage_;
+};
+
+// 具体建造者：游戏电脑（与 GamingComputerBuilder 共用 kGamingComponents）
+class CompactGamingComputerBuilder final : public FixedCompactComputerBuilder {
+public:
+    CompactGamingComputerBuilder() : FixedCompactComputerBuilder(kGamingComponents) {}
+};
+
+// 具体建造者：办公电脑（与 OfficeComputerBuilder 共用 kOfficeComponents）
+class CompactOfficeComputerBuilder final : public FixedCompactComputerBuilder {
+public:
+    CompactOfficeComputerBuilder() : FixedCompactComputerBuilder(kOfficeComponents) {}
+};
+
+// 指挥者（紧凑版本）：构建顺序与 Director 相同，产品写入调用方提供的存储
+class CompactDirector {
+public:
+    void Construct(const CompactComputerBuilder& builder, CompactComputer& computer) const {
+        builder.BuildCPU(computer);
+        builder.BuildGPU(computer);
+        builder.BuildRAM(computer);
+        builder.BuildStorage(computer);
+    }
+
+    // 在 out[0, count) 中构建 count 台相同配置的电脑：只构建第一台，其余按值复制
+    void ConstructMany(const CompactComputerBuilder& builder, CompactComputer* out,
+                       std::size_t count) const {
+        if (count == 0) {
+            return;
+        }
+        Construct(builder, out[0]);
+        for (std::size_t i = 1; i < count; ++i) {
+            out[i] = out[0];
+        }
+    }
+
+    // 在 arena 中连续构建 count 台电脑，返回首地址（count 为 0 时返回 nullptr）。
+    // CompactComputer 可平凡析构，内存随 arena 一起释放
+    CompactComputer* ConstructInArena(const CompactComputerBuilder& builder, std::size_t count,
+                                      std::pmr::memory_resource& arena) const {
+        if (count == 0) {
+            return nullptr;
+        }
+        if (count > SIZE_MAX / sizeof(CompactComputer)) {
+            throw std::bad_array_new_length();
+        }
+        CompactComputer prototype;
+        Construct(builder, prototype);
+        void* memory = arena.allocate(count * sizeof(CompactComputer), alignof(CompactComputer));
+        auto* computers = static_cast<CompactComputer*>(memory);
+        std::uninitialized_fill_n(computers, count, prototype);
+        return computers;
+    }
+};
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Builder.h"
+
+// ====================================
+// 二进制存档：固定布局 + 共享字符串表 + mmap 零拷贝读取
+// ====================================
+// 构建好的 Computer 配置需要持久化并在启动时重新载入，逐行解析文本很慢。存档格式（版本 1）：
+//
+//   [ComputerArchiveHeader]                     56 字节
+//   [ComputerRecord] x record_count             每条 record_size 字节（版本 1 为 16）
+//   [字符串表]                                   每项：uint32 长度 + 字节，补齐到 4 字节边界
+//
+// - 记录的每个字段是字符串表内的偏移，相同字符串只保存一份（配置目录里组件名的种类很少）；
+// - 所有整数按写入机器的字节序保存，读取时用 byte_order 字段拒绝字节序不同的文件；
+// - 读取方只接受版本号相同的文件；record_size 允许以后在记录末尾追加字段，读取方按步长跳过；
+// - ComputerArchive 用 mmap 映射整个文件，打开时只校验文件头（O(1)），不逐条解析；
+//   operator[] 返回 ComputerView：四个 std::string_view 直接指向映射的内存，不创建 std::string。
+//   每次访问都检查偏移与长度不越界，损坏的字段得到空视图而不是越界读取。
+
+inline constexpr char kComputerArchiveMagic[8] = {'C', 'M', 'P', 'A', 'R', 'C', 'H', '\0'};
+inline constexpr std::uint32_t kComputerArchiveVersion = 1;
+inline constexpr std::uint32_t kComputerArchiveByteOrder = 0x01020304u;
+
+struct ComputerArchiveHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t header_size;     // sizeof(ComputerArchiveHeader)
+    std::uint32_t record_size;     // 每条记录的字节数（步长）
+    std::uint64_t record_count;
+    std::uint64_t records_offset;  // 相对文件开头
+    std::uint64_t strings_offset;
+    std::uint64_t strings_size;
+};
+
+// 一条记录：四个字段在字符串表中的偏移
+struct ComputerRecord {
+    std::uint32_t cpu;
+    std::uint32_t gpu;
+    std::uint32_t ram;
+    std::uint32_t storage;
+};
+
+static_assert(sizeof(ComputerArchiveHeader) == 56, "archive header layout is part of the format");
+static_assert(sizeof(ComputerRecord) == 16, "archive record layout is part of the format");
+
+// 存档中一台电脑的零拷贝视图；视图在 ComputerArchive 关闭之前有效
+struct ComputerView {
+    std::string_view cpu;
+    std::string_view gpu;
+    std::string_view ram;
+    std::string_view storage;
+
+    // 复制成拥有字符串的 Computer
+    Computer Materialize() const {
+        Computer computer;
+        computer.cpu = cpu;
+        computer.gpu = gpu;
+        computer.ram = ram;
+        computer.storage = storage;
+        return computer;
+    }
+};
+
+// 存档写入器：逐条 Add，最后 WriteFile / Serialize
+class ComputerArchiveWriter {
+public:
+    void Reserve(std::size_t records) { records_.reserve(records); }
+
+    void Add(const Computer& computer) {
+        records_.push_back(ComputerRecord{Offset(computer.cpu), Offset(computer.gpu),
+                                          Offset(computer.ram), Offset(computer.storage)});
+    }
+
+    // 建造者的紧凑输出：按驻留 id 缓存偏移，不必每条都查字符串
+    void Add(const CompactComputer& computer) {
+        records_.push_back(ComputerRecord{IdOffset(computer.cpu), IdOffset(computer.gpu),
+                                          IdOffset(computer.ram), IdOffset(computer.storage)});
+    }
+
+    std::size_t Size() const { return records_.size(); }
+
+    // 完整的存档映像
+    std::string Serialize() const {
+        ComputerArchiveHeader header = Header();
+        std::string out(static_cast<std::size_t>(header.strings_offset + header.strings_size), '\0');
+        std::memcpy(&out[0], &header, sizeof(header));
+        if (!records_.empty()) {
+            std::memcpy(&out[header.records_offset], records_.data(),
+                        records_.size() * sizeof(ComputerRecord));
+        }
+        if (!strings_.empty()) {
+            std::memcpy(&out[header.strings_offset], strings_.data(), strings_.size());
+        }
+        return out;
+    }
+
+    // 写入文件（覆盖），返回是否成功
+    bool WriteFile(const std::string& path) const {
+        ComputerArchiveHeader header = Header();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(records_.data()),
+                   static_cast<std::streamsize>(records_.size() * sizeof(ComputerRecord)));
+        file.write(strings_.data(), static_cast<std::streamsize>(strings_.size()));
+        return static_cast<bool>(file);
+    }
+
+private:
+    static constexpr std::uint32_t kNoOffset = 0xFFFFFFFFu;
+
+    ComputerArchiveHeader Header() const {
+        ComputerArchiveHeader header{};
+        std::memcpy(header.magic, kComputerArchiveMagic, sizeof(header.magic));
+        header.version = kComputerArchiveVersion;
+        header.byte_order = kComputerArchiveByteOrder;
+        header.header_size = sizeof(ComputerArchiveHeader);
+        header.record_size = sizeof(ComputerRecord);
+        header.record_count = records_.size();
+        header.records_offset = sizeof(ComputerArchiveHeader);
+        header.strings_offset = header.records_offset + records_.size() * sizeof(ComputerRecord);
+        header.strings_size = strings_.size();
+        return header;
+    }
+
+    // 字符串在表中的偏移，第一次出现时追加（长度前缀 + 字节 + 补齐）
+    std::uint32_t Offset(std::string_view text) {
+        auto it = offsets_.find(text);
+        if (it != offsets_.end()) {
+            return it->second;
+        }
+        if (strings_.size() + sizeof(std::uint32_t) + text.size() + 3 > kNoOffset) {
+            throw std::length_error("ComputerArchiveWriter: string table exceeds 4 GiB");
+        }
+        auto offset = static_cast<std::uint32_t>(strings_.size());
+        auto length = static_cast<std::uint32_t>(text.size());
+        strings_.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        strings_.append(text);
+        strings_.append((4 - strings_.size() % 4) % 4, '\0');
+        keys_.emplace_back(text);  // deque 追加不移动已有元素，键中的 string_view 保持有效
+        offsets_.emplace(keys_.back(), offset);
+        return offset;
+    }
+
+    std::uint32_t IdOffset(ComponentId id) {
+        if (id >= id_offsets_.size()) {
+            id_offsets_.resize(static_cast<std::size_t>(id) + 1, kNoOffset);
+        }
+        if (id_offsets_[id] == kNoOffset) {
+            id_offsets_[id] = Offset(ComponentTable::Name(id));
+        }
+        return id_offsets_[id];
+    }
+
+    std::vector<ComputerRecord> records_;
+    std::string strings_;
+    std::deque<std::string> keys_;
+    std::unordered_map<std::string_view, std::uint32_t> offsets_;
+    std::vector<std::uint32_t> id_offsets_;  // 驻留 id -> 偏移
+};
+
+// 存档读取器：映射文件（或引用已在内存中的映像），按下标返回零拷贝视图
+class ComputerArchive {
+public:
+    ComputerArchive() = default;
+    ~ComputerArchive() { Close(); }
+
+    ComputerArchive(ComputerArchive&& other) noexcept { MoveFrom(other); }
+    ComputerArchive& operator=(ComputerArchive&& other) noexcept {
+        if (this != &other) {
+            Close();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    ComputerArchive(const ComputerArchive&) = delete;
+    ComputerArchive& operator=(const ComputerArchive&) = delete;
+
+    // 只读映射 path 并校验文件头；失败时返回 false，原因见 Error()
+    bool Open(const std::string& path) {
+        Close();
+#if defined(_WIN32)
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return Fail("cannot open " + path);
+        }
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            ::CloseHandle(file);
+            return Fail("cannot map empty or unreadable file " + path);
+        }
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        void* data = mapping != nullptr ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (mapping != nullptr) {
+            ::CloseHandle(mapping);  // 视图保持映射有效
+        }
+        if (data == nullptr) {
+            return Fail("cannot map " + path);
+        }
+        const auto bytes = static_cast<std::size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return Fail("cannot open " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return Fail("cannot map empty or unreadable file " + path);
+        }
+        const auto bytes = static_cast<std::size_t>(st.st_size);
+        void* data = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // 映射保持文件内容可用
+        if (data == MAP_FAILED) {
+            return Fail("cannot map " + path);
+        }
+#endif
+        mapped_ = data;
+        mapped_size_ = bytes;
+        return Attach(data, bytes);
+    }
+
+    // 使用已在内存中的存档映像（不复制，调用方保证其在本对象使用期间有效，且按 4 字节对齐）
+    bool Attach(const void* data, std::size_t size) {
+        if (mapped_ != data) {
+            Close();
+        }
+        error_.clear();
+        base_ = static_cast<const unsigned char*>(data);
+        size_ = size;
+        if (base_ == nullptr || size_ < sizeof(ComputerArchiveHeader)) {
+            return Fail("archive too small");
+        }
+        ComputerArchiveHeader header;
+        std::memcpy(&header, base_, sizeof(header));
+        if (std::memcmp(header.magic, kComputerArchiveMagic, sizeof(header.magic)) != 0) {
+            return Fail("not a computer archive");
+        }
+        if (header.byte_order != kComputerArchiveByteOrder) {
+            return Fail("archive byte order differs from this machine");
+        }
+        if (header.version != kComputerArchiveVersion) {
+            return Fail("unsupported archive version " + std::to_string(header.version));
+        }
+        if (header.header_size < sizeof(ComputerArchiveHeader) || header.header_size > size_ ||
+            header.record_size < sizeof(ComputerRecord) || header.record_size % 4 != 0 ||
+            header.records_offset % 4 != 0 || header.strings_offset % 4 != 0 ||
+            !Fits(header.records_offset, header.record_count, header.record_size) ||
+            !Fits(header.strings_offset, header.strings_size, 1)) {
+            return Fail("corrupt archive header");
+        }
+        records_ = base_ + header.records_offset;
+        record_size_ = header.record_size;
+        count_ = static_cast<std::size_t>(header.record_count);
+        strings_ = base_ + header.strings_offset;
+        strings_size_ = static_cast<std::size_t>(header.strings_size);
+        return true;
+    }
+
+    void Close() {
+        if (mapped_ != nullptr) {
+#if defined(_WIN32)
+            ::UnmapViewOfFile(mapped_);
+#else
+            ::munmap(mapped_, mapped_size_);
+#endif
+        }
+        mapped_ = nullptr;
+        mapped_size_ = 0;
+        base_ = nullptr;
+        size_ = 0;
+        records_ = nullptr;
+        record_size_ = 0;
+        count_ = 0;
+        strings_ = nullptr;
+        strings_size_ = 0;
+    }
+
+    bool IsOpen() const { return records_ != nullptr; }
+    std::size_t Size() const { return count_; }
+    const std::string& Error() const { return error_; }
+
+    // 第 i 条记录的视图（i < Size()）
+    ComputerView operator[](std::size_t i) const {
+        ComputerRecord record;
+        std::memcpy(&record, records_ + i * record_size_, sizeof(record));
+        return ComputerView{String(record.cpu), String(record.gpu), String(record.ram),
+                            String(record.storage)};
+    }
+
+private:
+    bool Fail(std::string message) {
+        Close();
+        error_ = std::move(message);
+        return false;
+    }
+
+    // [offset, offset + count * stride) 是否落在映像内（含溢出检查）
+    bool Fits(std::uint64_t offset, std::uint64_t count, std::uint64_t stride) const {
+        if (offset > size_) {
+            return false;
+        }
+        return count <= (size_ - offset) / stride;
+    }
+
+    std::string_view String(std::uint32_t offset) const {
+        if (strings_size_ < sizeof(std::uint32_t) || offset > strings_size_ - sizeof(std::uint32_t)) {
+            return {};
+        }
+        std::uint32_t length;
+        std::memcpy(&length, strings_ + offset, sizeof(length));
+        const std::size_t begin = offset + sizeof(std::uint32_t);
+        if (length > strings_size_ - begin) {
+            return {};
+        }
+        return std::string_view(reinterpret_cast<const char*>(strings_ + begin), length);
+    }
+
+    void MoveFrom(ComputerArchive& other) {
+        mapped_ = std::exchange(other.mapped_, nullptr);
+        mapped_size_ = std::exchange(other.mapped_size_, 0);
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        records_ = std::exchange(other.records_, nullptr);
+        record_size_ = std::exchange(other.record_size_, 0);
+        count_ = std::exchange(other.count_, 0);
+        strings_ = std::exchange(other.strings_, nullptr);
+        strings_size_ = std::exchange(other.strings_size_, 0);
+        error_ = std::move(other.error_);
+    }
+
+    void* mapped_ = nullptr;  // Open() 建立的映射，Close() 时解除
+    std::size_t mapped_size_ = 0;
+    const unsigned char* base_ = nullptr;
+    std::size_t size_ = 0;
+    const unsigned char* records_ = nullptr;
+    std::size_t record_size_ = 0;
+    std::size_t count_ = 0;
+    const unsigned char* strings_ = nullptr;
+    std::size_t strings_size_ = 0;
+    std::string error_;
+};
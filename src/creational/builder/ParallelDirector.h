@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Builder.h"
+
+// ====================================
+// 并行指挥者：按目录批量构建产品（工作窃取）
+// ====================================
+// Director::Construct 在调用线程上一次构建一台。把一整份配置目录（数十万到数百万条规格）物化成产品时，
+// 每一条彼此独立，可以完全并行：
+// - ParallelDirector 持有一组常驻工作线程，调用 Construct / Run 的线程也参与构建；
+// - 下标区间 [0, count) 先按线程数均分；每个线程从自己区间的头部每次取一小段（grain），
+//   自己的区间取完后，从其他线程区间的尾部窃取剩余的一半，放进自己的区间继续处理。
+//   区间是打包在一个 64 位原子量里的 [begin, end)，取用与窃取都是一次 CAS，不加锁；
+// - 每个线程只创建一个建造者，在它处理的所有条目之间复用；
+// - 第 i 条规格的产品写入调用方预先分配的 out[i]，输出顺序与输入顺序一致，与由哪个线程构建无关。
+// 同一个 ParallelDirector 上的多次调用串行执行；一次调用最多 2^32 - 1 条。
+
+// 目录中的一条规格：一台电脑的四个组件名
+struct ComputerSpec {
+    std::string cpu;
+    std::string gpu;
+    std::string ram;
+    std::string storage;
+};
+
+// 按规格构建的建造者：Reset(spec) 后即可交给 CompactDirector，可以反复使用。
+// 组件 id 先查建造者私有的缓存，未命中时才访问全局驻留表（需要加读锁）。
+// 建造者本身不是线程安全的，每个线程使用自己的实例
+class SpecComputerBuilder final : public CompactComputerBuilder {
+public:
+    // spec 必须在构建期间保持有效
+    void Reset(const ComputerSpec& spec) { spec_ = &spec; }
+
+    void BuildCPU(CompactComputer& computer) const override { computer.cpu = Intern(spec_->cpu); }
+    void BuildGPU(CompactComputer& computer) const override { computer.gpu = Intern(spec_->gpu); }
+    void BuildRAM(CompactComputer& computer) const override { computer.ram = Intern(spec_->ram); }
+    void BuildStorage(CompactComputer& computer) const override {
+        computer.storage = Intern(spec_->storage);
+    }
+
+private:
+    ComponentId Intern(std::string_view text) const {
+        auto it = cache_.find(text);
+        if (it != cache_.end()) {
+            return it->second;
+        }
+        ComponentId id = ComponentTable::Intern(text);
+        cache_.emplace(ComponentTable::Name(id), id);  // 键指向驻留表中的字符串，永久有效
+        return id;
+    }
+
+    inline static const ComputerSpec kEmptySpec{};
+
+    const ComputerSpec* spec_ = &kEmptySpec;
+    mutable std::unordered_map<std::string_view, ComponentId> cache_;
+};
+
+struct ParallelConstructStats {
+    unsigned threads = 0;     // 参与构建的线程数（含调用线程）
+    std::size_t steals = 0;   // 成功窃取的次数
+};
+
+class ParallelDirector {
+public:
+    // threads 为 0 时取硬件线程数；会额外启动 threads - 1 个工作线程
+    explicit ParallelDirector(unsigned threads = 0)
+        : threads_(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads),
+          ranges_(new PaddedRange[threads_]) {
+        workers_.reserve(threads_ - 1);
+        for (unsigned id = 1; id < threads_; ++id) {
+            workers_.emplace_back([this, id] { WorkerLoop(id); });
+        }
+    }
+
+    ~ParallelDirector() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ParallelDirector(const ParallelDirector&) = delete;
+    ParallelDirector& operator=(const ParallelDirector&) = delete;
+
+    unsigned Threads() const { return threads_; }
+
+    // 构建 specs[0, count) 到 out[0, count)
+    ParallelConstructStats Construct(const ComputerSpec* specs, std::size_t count,
+                                     CompactComputer* out) {
+        const CompactDirector director;
+        return Run(
+            count, [] { return SpecComputerBuilder(); },
+            [&](SpecComputerBuilder& builder, std::size_t i) {
+                builder.Reset(specs[i]);
+                director.Construct(builder, out[i]);
+            });
+    }
+
+    // 通用版本：每个线程调用一次 make_builder() 得到自己的建造者，
+    // 之后对分到的每个下标 i 调用 build(builder, i)。
+    // build 抛出异常时，其余线程在当前这一段结束后停止，第一个异常在所有线程停止后重新抛出，
+    // 此时只有部分下标被处理过
+    template <typename MakeBuilder, typename Build>
+    ParallelConstructStats Run(std::size_t count, MakeBuilder make_builder, Build build) {
+        if (count > kMaxCount) {
+            throw std::length_error("ParallelDirector: too many items in one call");
+        }
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+
+        for (unsigned t = 0; t < threads_; ++t) {
+            std::size_t begin = count * t / threads_;
+            std::size_t end = count * (t + 1) / threads_;
+            ranges_[t].value.store(Pack(begin, end), std::memory_order_relaxed);
+        }
+        // 每个线程约 64 段：段越小，负载越均衡，但 CAS 次数越多
+        const std::size_t grain = std::clamp<std::size_t>(count / (threads_ * 64u), 1, 1024);
+
+        std::atomic<std::size_t> steals{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto body = [&](unsigned worker) {
+            try {
+                auto builder = make_builder();
+                std::size_t begin = 0;
+                std::size_t end = 0;
+                while (!failed.load(std::memory_order_relaxed) &&
+                       Next(worker, grain, begin, end, steals)) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        build(builder, i);
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        };
+        Dispatch(body);
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        ParallelConstructStats stats;
+        stats.threads = threads_;
+        stats.steals = steals.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr std::size_t kMaxCount = 0xFFFFFFFFu;
+
+    // [begin, end)：begin 在低 32 位，end 在高 32 位
+    struct alignas(64) PaddedRange {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    static std::uint64_t Pack(std::size_t begin, std::size_t end) {
+        return (static_cast<std::uint64_t>(end) << 32) | static_cast<std::uint64_t>(begin);
+    }
+    static std::size_t Begin(std::uint64_t range) { return static_cast<std::uint32_t>(range); }
+    static std::size_t End(std::uint64_t range) { return static_cast<std::size_t>(range >> 32); }
+
+    // 取下一段 [begin, end)：先取自己区间的头部，取完后窃取；所有区间都空时返回 false
+    bool Next(unsigned worker, std::size_t grain, std::size_t& begin, std::size_t& end,
+              std::atomic<std::size_t>& steals) {
+        do {
+            if (TakeOwn(worker, grain, begin, end)) {
+                return true;
+            }
+        } while (Steal(worker, steals));
+        return false;
+    }
+
+    bool TakeOwn(unsigned worker, std::size_t grain, std::size_t& begin, std::size_t& end) {
+        std::atomic<std::uint64_t>& slot = ranges_[worker].value;
+        std::uint64_t range = slot.load(std::memory_order_acquire);
+        for (;;) {
+            std::size_t b = Begin(range);
+            std::size_t e = End(range);
+            if (b >= e) {
+                return false;
+            }
+            std::size_t next = b + std::min(grain, e - b);
+            if (slot.compare_exchange_weak(range, Pack(next, e), std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                begin = b;
+                end = next;
+                return true;
+            }
+        }
+    }
+
+    // 从其他线程区间的尾部窃取剩余的一半（只剩一个时整个拿走），放进自己的区间。
+    // 自己的区间只由自己写入新值，其他线程只会把它缩短；被取空的区间不会被再次 CAS，
+    // 新装入的区间与旧值不可能相同（旧区间的下标已全部处理），因此没有 ABA 问题
+    bool Steal(unsigned thief, std::atomic<std::size_t>& steals) {
+        for (unsigned k = 1; k < threads_; ++k) {
+            std::atomic<std::uint64_t>& slot = ranges_[(thief + k) % threads_].value;
+            std::uint64_t range = slot.load(std::memory_order_acquire);
+            for (;;) {
+                std::size_t b = Begin(range);
+                std::size_t e = End(range);
+                if (b >= e) {
+                    break;
+                }
+                std::size_t mid = b + (e - b) / 2;
+                if (slot.compare_exchange_weak(range, Pack(b, mid), std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                    ranges_[thief].value.store(Pack(mid, e), std::memory_order_release);
+                    steals.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // 让所有工作线程执行 body(id)，调用线程执行 body(0)，等全部完成后返回。body 不能抛出异常
+    template <typename Body>
+    void Dispatch(Body& body) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = [](void* context, unsigned worker) { (*static_cast<Body*>(context))(worker); };
+            job_context_ = &body;
+            pending_ = threads_ - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+        body(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    void WorkerLoop(unsigned id) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            void (*job)(void*, unsigned) = nullptr;
+            void* context = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+                job = job_;
+                context = job_context_;
+            }
+            job(context, id);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    const unsigned threads_;
+    std::unique_ptr<PaddedRange[]> ranges_;
+    std::vector<std::thread> workers_;
+
+    std::mutex run_mutex_;  // 串行化 Run 调用
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    std::uint64_t generation_ = 0;
+    unsigned pending_ = 0;
+    void (*job_)(void*, unsigned) = nullptr;
+    void* job_context_ = nullptr;
+};
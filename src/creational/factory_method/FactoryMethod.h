@@ -1,10 +1,24 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <new>
+#include <string>
 #include <functional>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "ProductKey.h"
+#include "ProductPool.h"
 
 // 工厂方法模式（Factory Method）示例
 // ----------------------------------
@@ -44,6 +58,8 @@ public:
 // 具体产品 A
 class ConcreteProductA : public Product {
 public:
+    static constexpr std::string_view kTypeName = "A";  // StaticFactory 与埋点使用的产品名
+
     void Use() override {
         std::cout << "Use ConcreteProductA" << std::endl;
     }
@@ -52,40 +68,471 @@ public:
 // 具体产品 B
 class ConcreteProductB : public Product {
 public:
+    static constexpr std::string_view kTypeName = "B";  // StaticFactory 与埋点使用的产品名
+
     void Use() override {
         std::cout << "Use ConcreteProductB" << std::endl;
     }
 };
 
+// ====================================
+// 创建埋点的挂载点（埋点实现见 FactoryMetrics.h）
+// ====================================
+// 埋点在这里调用，但不依赖埋点的实现：FactoryMetrics 开启时安装一张函数表，关闭时卸下，
+// 未安装时每次创建 / 销毁只多一次原子读取。两类挂载点：
+// - 创建数与耗时：ProductRegistry 在调用工厂函数（create / create_many）前后记录，按注册名统计；
+//   Creator::Create()（AnOperation 经过它）在调用 CreateProduct() 前后记录，按 TraceTag() 统计。
+//   工厂函数返回 make_unique 还是对象池产品都会被统计；
+// - 存活数：MakePooledProduct<T>、ProductBatch::Create<T> 与对应的删除器记录构造与销毁的对象数，
+//   按产品类型名统计（make_unique 的产品不经过这里，没有存活数）。
+// 每个名字有一个 ProductTraceTag，埋点实现把它为该名字分配的编号缓存在 tag 中；
+// 同名的 tag（例如注册名 "A" 与 ConcreteProductA::kTypeName）计入同一个类型。
+
+// 产品类型在存活数中的名字：有 kTypeName 成员时使用它，否则使用 typeid 名
+template <typename T, typename = void>
+struct HasProductTypeName : std::false_type {};
+
+template <typename T>
+struct HasProductTypeName<T, std::void_t<decltype(T::kTypeName)>> : std::true_type {};
+
+struct ProductTraceTag {
+    static constexpr std::uint32_t kUnassigned = 0xFFFFFFFFu;
+
+    std::string_view name;
+    std::atomic<std::uint32_t> id{kUnassigned};  // 埋点实现分配的类型编号
+};
+
+template <typename T>
+ProductTraceTag& ProductTraceTagOf() {
+    static ProductTraceTag tag{[] {
+        if constexpr (HasProductTypeName<T>::value) {
+            return std::string_view(T::kTypeName);
+        } else {
+            return std::string_view(typeid(T).name());
+        }
+    }()};
+    return tag;
+}
+
+struct ProductTraceHooks {
+    std::uint64_t (*begin_create)();  // 本次创建需要计时时返回起点读数，否则返回 0
+    // 一次工厂调用创建了 count 个产品：计数，start 非 0 时记录平均每个产品的耗时
+    void (*end_create)(ProductTraceTag& type, std::uint64_t start, std::uint64_t count);
+    void (*constructed)(ProductTraceTag& type, std::uint64_t count);  // 存活数：构造
+    void (*destroyed)(ProductTraceTag& type, std::uint64_t count);    // 存活数：销毁
+};
+
+class ProductTrace {
+public:
+    // 当前安装的函数表；未开启埋点时为 nullptr
+    static const ProductTraceHooks* Hooks() { return hooks_.load(std::memory_order_acquire); }
+
+    static void Install(const ProductTraceHooks* hooks) {
+        hooks_.store(hooks, std::memory_order_release);
+    }
+
+    // 调用 create 并记录创建数与耗时；count_of(result) 为本次创建的产品数（失败时为 0，不计数）
+    template <typename Create, typename CountOf>
+    static std::invoke_result_t<Create> Traced(ProductTraceTag& type, Create create,
+                                               CountOf count_of) {
+        const ProductTraceHooks* hooks = Hooks();
+        if (hooks == nullptr) {
+            return create();
+        }
+        const std::uint64_t start = hooks->begin_create();
+        auto result = create();
+        if (const std::uint64_t count = count_of(result)) {
+            hooks->end_create(type, start, count);
+        }
+        return result;
+    }
+
+private:
+    inline static std::atomic<const ProductTraceHooks*> hooks_{nullptr};
+};
+
+// ====================================
+// 产品指针：可定制销毁方式的 unique_ptr
+// ====================================
+// 工厂返回 ProductPtr：unique_ptr<Product, ProductDeleter>。
+// - 普通的 std::unique_ptr<Product>（default_delete）可以隐式转换为 ProductPtr，
+//   删除器退化为 delete，因此返回 make_unique 的工厂函数无需修改；
+// - 删除器也可以带一个回收函数，由它负责析构并释放内存，例如对象池分配的产品
+//   （MakePooledProduct）把内存还给池，不经过全局分配器。
+
+class ProductDeleter {
+public:
+    using Recycler = void (*)(Product*);
+
+    ProductDeleter() = default;
+
+    // 接管 default_delete 管理的对象：销毁时直接 delete
+    template <typename T, typename = std::enable_if_t<std::is_convertible_v<T*, Product*>>>
+    ProductDeleter(const std::default_delete<T>&) {}
+
+    // 销毁时调用 recycle（负责析构与释放）
+    explicit ProductDeleter(Recycler recycle) : recycle_(recycle) {}
+
+    void operator()(Product* product) const {
+        if (recycle_ != nullptr) {
+            recycle_(product);
+        } else {
+            delete product;
+        }
+    }
+
+    // 是否由回收函数销毁（例如对象池分配的产品）
+    bool IsPooled() const { return recycle_ != nullptr; }
+
+private:
+    Recycler recycle_ = nullptr;
+};
+
+using ProductPtr = std::unique_ptr<Product, ProductDeleter>;
+
+// ====================================
+// 性能优化：对象池分配的产品（ObjectPool 见 ProductPool.h）
+// ====================================
+// 内置的具体工厂（ConcreteCreatorA/B、PooledCreator<T>）与 ProductRegistry::RegisterType<T>
+// 都经过 MakePooledProduct<T>()：从 ObjectPool<T> 取内存并构造，删除器带着回收函数，
+// 销毁时析构对象后把块还给池，不经过全局分配器。构造与销毁都经过埋点挂载点（ProductTrace，存活数）。
+
+template <typename T>
+void RecyclePooledProduct(Product* product) {
+    T* object = static_cast<T*>(product);
+    object->~T();
+    ObjectPool<T>::Instance().Deallocate(object);
+    if (const ProductTraceHooks* hooks = ProductTrace::Hooks()) {
+        hooks->destroyed(ProductTraceTagOf<T>(), 1);
+    }
+}
+
+// 在 ObjectPool<T> 中构造产品；构造函数抛出异常时内存归还给池
+template <typename T, typename... Args>
+ProductPtr MakePooledProduct(Args&&... args) {
+    static_assert(std::is_base_of_v<Product, T>, "T must derive from Product");
+    ObjectPool<T>& pool = ObjectPool<T>::Instance();
+    void* block = pool.Allocate();
+    T* object = nullptr;
+    try {
+        object = ::new (block) T(std::forward<Args>(args)...);
+    } catch (...) {
+        pool.Deallocate(block);
+        throw;
+    }
+    if (const ProductTraceHooks* hooks = ProductTrace::Hooks()) {
+        hooks->constructed(ProductTraceTagOf<T>(), 1);
+    }
+    return ProductPtr(object, ProductDeleter(&RecyclePooledProduct<T>));
+}
+
+// ====================================
+// 性能优化：批量创建（连续存储）
+// ====================================
+// 逐个 CreateProduct() 得到 N 个分散在堆上的对象和 N 次虚函数调用。
+// ProductBatch 持有一批产品，按具体类型 T 分配时：
+// - 一次分配一整块内存，N 个 T 首尾相接（步长 sizeof(T)），遍历时按地址顺序访问，预取友好；
+// - UseAll() 在已知 T 的循环里以限定名调用 T::Use()，不经过虚函数表。
+// 不知道具体类型时（例如注册表里只有一个返回 ProductPtr 的工厂函数），FromProducts 退化为
+// 逐个创建、按指针访问，接口不变但没有连续存储的收益，可用 IsContiguous() 区分。
+
+class ProductBatch {
+public:
+    // 前向迭代器，解引用得到 Product&
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Product;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Product*;
+        using reference = Product&;
+
+        Iterator(const ProductBatch* batch, char* pos) : batch_(batch), pos_(pos) {}
+
+        Product& operator*() const { return *batch_->ElementAt(pos_); }
+        Product* operator->() const { return batch_->ElementAt(pos_); }
+
+        Iterator& operator++() {
+            pos_ += batch_->stride_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return pos_ == other.pos_; }
+        bool operator!=(const Iterator& other) const { return pos_ != other.pos_; }
+
+    private:
+        const ProductBatch* batch_;
+        char* pos_;
+    };
+
+    ProductBatch() = default;
+
+    // 连续构造 n 个 T（每个都以 args 构造）；任一构造函数抛出异常时，已构造的对象析构、内存释放
+    template <typename T, typename... Args>
+    static ProductBatch Create(std::size_t n, const Args&... args) {
+        static_assert(std::is_base_of_v<Product, T>, "T must derive from Product");
+        ProductBatch batch;
+        if (n == 0) {
+            return batch;
+        }
+        char* data = static_cast<char*>(AllocateStorage<T>(n));
+        std::size_t built = 0;
+        try {
+            for (; built < n; ++built) {
+                ::new (data + built * sizeof(T)) T(args...);
+            }
+        } catch (...) {
+            DestroyAll<T>(data, built);
+            FreeStorage<T>(data);
+            throw;
+        }
+        batch.data_ = data;
+        batch.stride_ = sizeof(T);
+        batch.size_ = n;
+        // Product 子对象在 T 内的偏移（单继承时为 0）
+        Product* first = reinterpret_cast<T*>(data);
+        batch.base_offset_ = reinterpret_cast<char*>(first) - data;
+        batch.destroy_ = [](char* storage, std::size_t count) {
+            DestroyAll<T>(storage, count);
+            FreeStorage<T>(storage);
+            if (const ProductTraceHooks* hooks = ProductTrace::Hooks()) {
+                hooks->destroyed(ProductTraceTagOf<T>(), count);
+            }
+        };
+        batch.use_all_ = [](char* storage, std::size_t count) {
+            T* objects = reinterpret_cast<T*>(storage);
+            for (std::size_t i = 0; i < count; ++i) {
+                objects[i].T::Use();
+            }
+        };
+        if (const ProductTraceHooks* hooks = ProductTrace::Hooks()) {
+            hooks->constructed(ProductTraceTagOf<T>(), n);
+        }
+        return batch;
+    }
+
+    // 接管一组独立分配的产品（非连续存储）
+    static ProductBatch FromProducts(std::vector<ProductPtr> products) {
+        ProductBatch batch;
+        batch.owned_ = std::move(products);
+        batch.pointers_.reserve(batch.owned_.size());
+        for (const auto& product : batch.owned_) {
+            batch.pointers_.push_back(product.get());
+        }
+        batch.BindPointers();
+        return batch;
+    }
+
+    ProductBatch(ProductBatch&& other) noexcept { MoveFrom(other); }
+
+    ProductBatch& operator=(ProductBatch&& other) noexcept {
+        if (this != &other) {
+            Release();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    ProductBatch(const ProductBatch&) = delete;
+    ProductBatch& operator=(const ProductBatch&) = delete;
+
+    ~ProductBatch() { Release(); }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    Product& operator[](std::size_t i) const { return *ElementAt(data_ + i * stride_); }
+
+    Iterator begin() const { return Iterator(this, data_); }
+    Iterator end() const { return Iterator(this, data_ + size_ * stride_); }
+
+    // 是否为同一具体类型的连续存储
+    bool IsContiguous() const { return destroy_ != nullptr; }
+
+    // 对每个产品调用 Use()；连续存储时不经过虚函数表
+    void UseAll() const {
+        if (use_all_ != nullptr) {
+            use_all_(data_, size_);
+            return;
+        }
+        for (Product* product : pointers_) {
+            product->Use();
+        }
+    }
+
+private:
+    // n * sizeof(T) 溢出时抛出 std::bad_array_new_length，避免回绕成一块过小的内存
+    template <typename T>
+    static void* AllocateStorage(std::size_t n) {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(n * sizeof(T), std::align_val_t(alignof(T)));
+        } else {
+            return ::operator new(n * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static void FreeStorage(void* storage) {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(storage, std::align_val_t(alignof(T)));
+        } else {
+            ::operator delete(storage);
+        }
+    }
+
+    template <typename T>
+    static void DestroyAll(char* storage, std::size_t count) {
+        for (std::size_t i = count; i > 0; --i) {
+            reinterpret_cast<T*>(storage + (i - 1) * sizeof(T))->~T();
+        }
+    }
+
+    Product* ElementAt(char* pos) const {
+        if (destroy_ != nullptr) {
+            return reinterpret_cast<Product*>(pos + base_offset_);
+        }
+        return *reinterpret_cast<Product* const*>(pos);
+    }
+
+    // 非连续存储：按指针数组遍历
+    void BindPointers() {
+        data_ = reinterpret_cast<char*>(pointers_.data());
+        stride_ = sizeof(Product*);
+        size_ = pointers_.size();
+    }
+
+    void MoveFrom(ProductBatch& other) {
+        stride_ = other.stride_;
+        size_ = other.size_;
+        base_offset_ = other.base_offset_;
+        destroy_ = other.destroy_;
+        use_all_ = other.use_all_;
+        owned_ = std::move(other.owned_);
+        pointers_ = std::move(other.pointers_);
+        if (destroy_ != nullptr) {
+            data_ = other.data_;
+        } else {
+            BindPointers();
+        }
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.destroy_ = nullptr;
+        other.use_all_ = nullptr;
+        other.pointers_.clear();
+        other.owned_.clear();
+    }
+
+    void Release() {
+        if (destroy_ != nullptr) {
+            destroy_(data_, size_);
+        }
+        pointers_.clear();
+        owned_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        destroy_ = nullptr;
+        use_all_ = nullptr;
+    }
+
+    char* data_ = nullptr;
+    std::size_t stride_ = 0;
+    std::size_t size_ = 0;
+    std::ptrdiff_t base_offset_ = 0;
+    void (*destroy_)(char*, std::size_t) = nullptr;   // 连续存储：析构并释放整块内存
+    void (*use_all_)(char*, std::size_t) = nullptr;   // 连续存储：按具体类型批量调用 Use()
+    std::vector<ProductPtr> owned_;                   // 非连续存储：持有各个产品
+    std::vector<Product*> pointers_;                  // 非连续存储：遍历用的指针数组
+};
+
 // 抽象工厂（工厂方法所在的基类）
 class Creator {
 public:
     virtual ~Creator() = default;
 
     // 工厂方法：由子类决定具体创建哪种产品
-    virtual std::unique_ptr<Product> CreateProduct() const = 0;
+    virtual ProductPtr CreateProduct() const = 0;
+
+    // 批量创建 n 个产品。默认实现逐个调用 CreateProduct()（非连续存储）；
+    // 知道具体产品类型的子类应覆盖为 ProductBatch::Create<T>(n)，得到连续存储
+    virtual ProductBatch CreateBatch(std::size_t n) const {
+        std::vector<ProductPtr> products;
+        products.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            products.push_back(CreateProduct());
+        }
+        return ProductBatch::FromProducts(std::move(products));
+    }
+
+    // 调用 CreateProduct() 并记录创建埋点（按 TraceTag() 统计创建数与耗时）
+    ProductPtr Create() const {
+        return ProductTrace::Traced(
+            TraceTag(), [this] { return CreateProduct(); },
+            [](const ProductPtr& product) { return product != nullptr ? 1u : 0u; });
+    }
 
     // 通用业务逻辑：依赖抽象产品，不关心具体产品类型
     void AnOperation() const {
-        auto product = CreateProduct();
+        auto product = Create();
         product->Use();
     }
+
+protected:
+    // 创建埋点中的名字；默认所有工厂计入 "<creator>"，具体工厂覆盖为所创建产品的名字
+    virtual ProductTraceTag& TraceTag() const {
+        static ProductTraceTag tag{"<creator>"};
+        return tag;
+    }
 };
 
-// 具体工厂 A：创建 ConcreteProductA
+// 具体工厂 A：创建 ConcreteProductA（内存来自对象池）
 class ConcreteCreatorA : public Creator {
 public:
-    std::unique_ptr<Product> CreateProduct() const override {
-        return std::make_unique<ConcreteProductA>();
+    ProductPtr CreateProduct() const override {
+        return MakePooledProduct<ConcreteProductA>();
+    }
+
+    ProductBatch CreateBatch(std::size_t n) const override {
+        return ProductBatch::Create<ConcreteProductA>(n);
     }
+
+protected:
+    ProductTraceTag& TraceTag() const override { return ProductTraceTagOf<ConcreteProductA>(); }
 };
 
-// 具体工厂 B：创建 ConcreteProductB
+// 具体工厂 B：创建 ConcreteProductB（内存来自对象池）
 class ConcreteCreatorB : public Creator {
 public:
-    std::unique_ptr<Product> CreateProduct() const override {
-        return std::make_unique<ConcreteProductB>();
+    ProductPtr CreateProduct() const override {
+        return MakePooledProduct<ConcreteProductB>();
     }
+
+    ProductBatch CreateBatch(std::size_t n) const override {
+        return ProductBatch::Create<ConcreteProductB>(n);
+    }
+
+protected:
+    ProductTraceTag& TraceTag() const override { return ProductTraceTagOf<ConcreteProductB>(); }
+};
+
+// 通用的具体工厂：CreateProduct 从对象池分配 T，CreateBatch 连续存储
+template <typename T>
+class PooledCreator : public Creator {
+public:
+    ProductPtr CreateProduct() const override { return MakePooledProduct<T>(); }
+
+    ProductBatch CreateBatch(std::size_t n) const override { return ProductBatch::Create<T>(n); }
+
+protected:
+    ProductTraceTag& TraceTag() const override { return ProductTraceTagOf<T>(); }
 };
 
 // 演示函数：客户端只依赖抽象 Creator 和 Product
@@ -105,43 +552,335 @@ inline void RunFactoryMethodDemo() {
 // ====================================
 // 使用函数指针或 lambda 注册工厂，避免为每个产品创建工厂类
 // 优点：灵活、减少类层次、支持动态注册
+//
+// 读优化：冻结为不可变快照（Freeze）
+// - 注册阶段（启动时）：Register / Create 都在 std::mutex 保护下访问可变的 table_；
+// - Freeze() 之后：把 table_ 拷贝成一份不可变快照，用原子指针发布。
+//   Create 只做一次 acquire 读取 + 查表，不加锁，多线程调用互不阻塞；
+// - 冻结后仍可 Register（迟到的插件注册）：写时复制 —— 拷贝当前快照、插入、再原子发布新快照。
+//   旧快照可能仍被并发的 Create 读取，因此不立即释放，而是保留到程序结束
+//   （迟到注册次数很少，这点内存可以忽略；注册频繁的场景不适合冻结）。
+//
+// 键（见 ProductKey.h）：
+// - Create(std::string_view)：字面量不再构造临时 std::string；
+// - Create(TypeKey)         ：哈希已预先算好（constexpr TypeKey 在编译期完成）；
+// - Create(ProductHandle)   ：Register / Lookup 返回的整数句柄，按下标直接取工厂函数；
+// - Freeze(KeyIndex::kPerfectHash)：冻结时额外构建完美哈希表，查找没有探测循环。
+//
+// 批量创建：CreateMany(type, n) 返回 ProductBatch；用 RegisterType<T> 注册的类型连续存储。
+//
+// 延迟注册：RegisterDeferred(type, resolve) 启动时只插入一个占位条目，第一次 Create 该类型时
+//   才调用 resolve() 取得真正的工厂函数（共享库插件即以此实现，见 ProductPlugin.h）。
+//   resolve() 不在 mutex_ 内执行：未冻结时 Create 在锁内查到占位条目后只取出 binding，
+//   释放锁再解析（dlopen 和插件的静态初始化可能再调用 Register，也可能很慢）。
+//   解析成功后立即把占位条目换成直接的工厂函数（冻结状态下以写时复制发布新快照），
+//   之后按名字 / 句柄创建的开销与直接注册的类型相同。
+//   解析失败时 Create 返回 nullptr（与未注册的类型一样）。
+//
+// 创建埋点：每次调用工厂函数（create / create_many）前后经过 ProductTrace，按注册名统计创建数与耗时；
+//   每个注册名有一个 ProductTraceTag（重复注册同一类型时沿用），冻结快照中的条目指向同一个 tag。
 
 class ProductRegistry {
 public:
-    using FactoryFunction = std::function<std::unique_ptr<Product>()>;
+    using FactoryFunction = std::function<ProductPtr()>;
+    using BatchFunction = std::function<ProductBatch(std::size_t)>;
 
-    // 注册产品工厂函数
-    static void Register(const std::string& type, FactoryFunction factory) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        registry_[type] = std::move(factory);
+    // 一个类型的工厂函数；create_many 为空时 CreateMany 逐个调用 create（非连续存储）
+    struct Factories {
+        FactoryFunction create;
+        BatchFunction create_many;
+    };
+
+    // 延迟注册的解析函数：返回真正的工厂函数，create 为空表示解析失败
+    using Resolver = std::function<Factories()>;
+
+    // 冻结快照使用的名字索引
+    enum class KeyIndex { kLinearProbing, kPerfectHash };
+
+    // 注册产品工厂函数，返回该类型的句柄（重复注册同一类型时覆盖工厂、句柄不变）
+    static ProductHandle Register(std::string_view type, FactoryFunction factory) {
+        return Register(type, Factories{std::move(factory), nullptr});
+    }
+
+    static ProductHandle Register(std::string_view type, Factories factories) {
+        return Insert(type, Registration{std::move(factories), nullptr});
+    }
+
+    // 按具体类型注册：单个产品从对象池分配，CreateMany 连续存储
+    template <typename T>
+    static ProductHandle RegisterType(std::string_view type) {
+        return Register(type, Factories{[] { return MakePooledProduct<T>(); },
+                                        [](std::size_t n) { return ProductBatch::Create<T>(n); }});
+    }
+
+    // 延迟注册：第一次 Create / CreateMany 该类型时才调用 resolve()（只调用一次）
+    static ProductHandle RegisterDeferred(std::string_view type, Resolver resolve) {
+        auto binding = std::make_shared<DeferredBinding>(type, std::move(resolve));
+        return Insert(type, Registration{Factories{[binding] { return CreateDeferred(*binding); },
+                                                   [binding](std::size_t n) {
+                                                       return CreateManyDeferred(*binding, n);
+                                                   }},
+                                         binding});
+    }
+
+    // 查询已注册类型的句柄；未注册时返回无效句柄
+    static ProductHandle Lookup(TypeKey key) {
+        return WithTable([&key](const Table& table) {
+            return ProductHandle{table.Find(key.hash, key.name)};
+        });
     }
 
+    static ProductHandle Lookup(std::string_view type) { return Lookup(TypeKey(type)); }
+
     // 根据类型创建产品
-    static std::unique_ptr<Product> Create(const std::string& type) {
+    static ProductPtr Create(TypeKey key) {
+        const auto find = [&key](const Table& table) {
+            return table.At(table.Find(key.hash, key.name));
+        };
+        return Dispatch(find, [](const Factories& factories) { return factories.create(); });
+    }
+
+    static ProductPtr Create(std::string_view type) { return Create(TypeKey(type)); }
+
+    // 按句柄创建：一次下标访问取出工厂函数
+    static ProductPtr Create(ProductHandle handle) {
+        return Dispatch([handle](const Table& table) { return table.At(handle.index); },
+                        [](const Factories& factories) { return factories.create(); });
+    }
+
+    // 批量创建 n 个同类型产品；类型未注册时返回空批次
+    static ProductBatch CreateMany(TypeKey key, std::size_t n) {
+        const auto find = [&key](const Table& table) {
+            return table.At(table.Find(key.hash, key.name));
+        };
+        return Dispatch(find, [n](const Factories& factories) { return InvokeMany(factories, n); });
+    }
+
+    static ProductBatch CreateMany(std::string_view type, std::size_t n) {
+        return CreateMany(TypeKey(type), n);
+    }
+
+    static ProductBatch CreateMany(ProductHandle handle, std::size_t n) {
+        return Dispatch([handle](const Table& table) { return table.At(handle.index); },
+                        [n](const Factories& factories) { return InvokeMany(factories, n); });
+    }
+
+    // 注册阶段结束后调用：此后 Create 不再加锁。
+    // 可重复调用；传入不同的 index 会按新的索引方式重新发布快照
+    static void Freeze(KeyIndex index = KeyIndex::kLinearProbing) {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = registry_.find(type);
-        if (it != registry_.end()) {
-            return it->second();
+        if (snapshot_.load(std::memory_order_relaxed) == nullptr || index != key_index_) {
+            key_index_ = index;
+            PublishLocked();
         }
-        return nullptr;
+    }
+
+    static bool IsFrozen() { return snapshot_.load(std::memory_order_acquire) != nullptr; }
+
+    // 当前快照是否使用完美哈希（未冻结或构建失败时为 false）
+    static bool UsesPerfectHash() {
+        const Table* snapshot = snapshot_.load(std::memory_order_acquire);
+        return snapshot != nullptr && snapshot->HasPerfectHash();
     }
 
 private:
+    // 延迟注册的条目：解析结果只写一次（call_once），之后只读
+    struct DeferredBinding {
+        DeferredBinding(std::string_view type_name, Resolver resolver)
+            : type(type_name), resolve(std::move(resolver)) {}
+
+        const std::string type;
+        Resolver resolve;
+        std::once_flag once;
+        Factories factories;                // 只在 call_once 内写入
+        std::atomic<bool> resolved{false};  // 解析成功（release 之后可以读 factories）
+        std::atomic<bool> promoted{false};  // 已换成直接的工厂函数
+    };
+
+    struct Registration {
+        Factories factories;
+        std::shared_ptr<DeferredBinding> deferred;  // 非空表示尚未替换的延迟条目
+        ProductTraceTag* trace = nullptr;           // 埋点 tag，由 InsertLocked 填入
+    };
+
+    // 注册名对应的埋点 tag；tag.name 指向 name，存放在 deque 中，地址不随插入改变
+    struct TypeTrace {
+        explicit TypeTrace(std::string_view type) : name(type) { tag.name = name; }
+
+        std::string name;
+        ProductTraceTag tag;
+    };
+
+    using Table = KeyTable<Registration>;
+
+    // 调用 binding.resolve（每个条目只执行一次），解析失败时返回 nullptr
+    static const Factories* Resolve(DeferredBinding& binding) {
+        std::call_once(binding.once, [&binding] {
+            Factories factories = binding.resolve();
+            if (factories.create) {
+                binding.factories = std::move(factories);
+                binding.resolved.store(true, std::memory_order_release);
+            }
+        });
+        return binding.resolved.load(std::memory_order_acquire) ? &binding.factories : nullptr;
+    }
+
+    // 把占位条目换成直接的工厂函数（只换一次）；调用方不持有 mutex_。
+    // 条目已被重新注册（其他线程或 resolve() 内部调用了 Register）时保留新的注册
+    static void Promote(DeferredBinding& binding) {
+        if (binding.promoted.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::uint64_t hash = Fnv1a64(binding.type);
+        const Table::Entry* entry = table_.At(table_.Find(hash, binding.type));
+        if (entry == nullptr || entry->value.deferred.get() != &binding) {
+            return;
+        }
+        table_.Insert(binding.type, hash,
+                      Registration{binding.factories, nullptr, entry->value.trace});
+        if (snapshot_.load(std::memory_order_relaxed) != nullptr) {
+            PublishLocked();  // 冻结后：写时复制
+        }
+    }
+
+    static ProductPtr CreateDeferred(DeferredBinding& binding) {
+        const Factories* factories = Resolve(binding);
+        if (factories == nullptr) {
+            return nullptr;
+        }
+        Promote(binding);
+        return factories->create();
+    }
+
+    static ProductBatch CreateManyDeferred(DeferredBinding& binding, std::size_t n) {
+        const Factories* factories = Resolve(binding);
+        if (factories == nullptr) {
+            return ProductBatch();
+        }
+        Promote(binding);
+        return InvokeMany(*factories, n);
+    }
+
+    static ProductHandle Insert(std::string_view type, Registration registration) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ProductHandle handle{InsertLocked(type, Fnv1a64(type), std::move(registration))};
+        if (snapshot_.load(std::memory_order_relaxed) != nullptr) {
+            PublishLocked();  // 冻结后：写时复制
+        }
+        return handle;
+    }
+
+    // 插入或覆盖条目：覆盖时沿用原条目的埋点 tag，新类型分配一个
+    static std::uint32_t InsertLocked(std::string_view type, std::uint64_t hash,
+                                      Registration registration) {
+        const Table::Entry* existing = table_.At(table_.Find(hash, type));
+        registration.trace =
+            existing != nullptr ? existing->value.trace : &traces_.emplace_back(type).tag;
+        return table_.Insert(type, hash, std::move(registration));
+    }
+
+    // 在当前可读的表上执行 fn：冻结后无锁读取不可变快照，否则在 mutex_ 保护下读取 table_
+    template <typename Fn>
+    static std::invoke_result_t<Fn, const Table&> WithTable(Fn fn) {
+        if (const Table* snapshot = snapshot_.load(std::memory_order_acquire)) {
+            return fn(*snapshot);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        return fn(table_);
+    }
+
+    // 查找条目（find）并用它的工厂函数执行 invoke（经过创建埋点）；条目不存在时返回空结果。
+    // 冻结后无锁读取快照。未冻结时在 mutex_ 保护下查找：普通条目直接在锁内调用，
+    // 延迟条目只在锁内复制 binding，释放锁之后再解析、创建
+    template <typename Find, typename Fn>
+    static std::invoke_result_t<Fn, const Factories&> Dispatch(Find find, Fn invoke) {
+        using Result = std::invoke_result_t<Fn, const Factories&>;
+        if (const Table* snapshot = snapshot_.load(std::memory_order_acquire)) {
+            const Table::Entry* entry = find(*snapshot);
+            return entry != nullptr ? Traced(*entry->value.trace, entry->value.factories, invoke)
+                                    : Result();
+        }
+        std::shared_ptr<DeferredBinding> deferred;
+        ProductTraceTag* trace = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const Table::Entry* entry = find(table_);
+            if (entry == nullptr) {
+                return Result();
+            }
+            if (entry->value.deferred == nullptr) {
+                return Traced(*entry->value.trace, entry->value.factories, invoke);
+            }
+            deferred = entry->value.deferred;
+            trace = entry->value.trace;
+        }
+        const Factories* factories = Resolve(*deferred);
+        if (factories == nullptr) {
+            return Result();
+        }
+        Promote(*deferred);
+        return Traced(*trace, *factories, invoke);
+    }
+
+    template <typename Fn>
+    static std::invoke_result_t<Fn, const Factories&> Traced(ProductTraceTag& trace,
+                                                             const Factories& factories,
+                                                             Fn& invoke) {
+        return ProductTrace::Traced(
+            trace, [&] { return invoke(factories); },
+            [](const auto& result) { return CountOf(result); });
+    }
+
+    static std::size_t CountOf(const ProductPtr& product) { return product != nullptr ? 1 : 0; }
+    static std::size_t CountOf(const ProductBatch& batch) { return batch.size(); }
+
+    static ProductBatch InvokeMany(const Factories& factories, std::size_t n) {
+        if (factories.create_many) {
+            return factories.create_many(n);
+        }
+        std::vector<ProductPtr> products;
+        products.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            products.push_back(factories.create());
+        }
+        return ProductBatch::FromProducts(std::move(products));
+    }
+
+    // 发布 table_ 的一份不可变拷贝；旧快照保留到程序结束。
+    // 发布前把已经解析成功的延迟条目换成直接的工厂函数
+    static void PublishLocked() {
+        for (std::uint32_t i = 0; i < table_.Size(); ++i) {
+            const Table::Entry* entry = table_.At(i);
+            const std::shared_ptr<DeferredBinding> deferred = entry->value.deferred;
+            if (deferred != nullptr && deferred->resolved.load(std::memory_order_acquire)) {
+                deferred->promoted.store(true, std::memory_order_relaxed);
+                table_.Insert(entry->name, entry->hash,
+                              Registration{deferred->factories, nullptr, entry->value.trace});
+            }
+        }
+        auto snapshot = std::make_unique<Table>(table_);
+        if (key_index_ == KeyIndex::kPerfectHash) {
+            snapshot->BuildPerfectHash();
+        }
+        snapshots_.push_back(std::move(snapshot));
+        snapshot_.store(snapshots_.back().get(), std::memory_order_release);
+    }
+
     // C++17: inline static 简化静态成员定义
-    inline static std::unordered_map<std::string, FactoryFunction> registry_;
-    inline static std::mutex mutex_; // 线程安全保护
+    inline static Table table_;
+    inline static std::mutex mutex_; // 线程安全保护（注册阶段与所有写操作）
+    inline static KeyIndex key_index_ = KeyIndex::kLinearProbing;
+    inline static std::atomic<const Table*> snapshot_{nullptr};  // 冻结后发布的快照
+    inline static std::vector<std::unique_ptr<const Table>> snapshots_;  // 已发布的全部快照
+    inline static std::deque<TypeTrace> traces_;  // 各注册名的埋点 tag（只增不减）
 };
 
 // 注册示例（可在程序初始化时执行）
 inline void InitProductRegistry() {
-    // C++11: lambda 表达式注册工厂
-    ProductRegistry::Register("A", []() -> std::unique_ptr<Product> {
-        return std::make_unique<ConcreteProductA>();
-    });
-    
-    ProductRegistry::Register("B", []() -> std::unique_ptr<Product> {
-        return std::make_unique<ConcreteProductB>();
-    });
+    // 按具体类型注册：单个产品来自对象池，批量创建时连续存储
+    ProductRegistry::RegisterType<ConcreteProductA>("A");
+    ProductRegistry::RegisterType<ConcreteProductB>("B");
 }
 
 // 使用注册表模式
@@ -149,6 +888,7 @@ inline void RunRegistryDemo() {
     std::cout << "\n--- Factory Registry Demo ---" << std::endl;
     
     InitProductRegistry();
+    ProductRegistry::Freeze();  // 注册完成，此后 Create 无锁
     
     auto productA = ProductRegistry::Create("A");
     if (productA) productA->Use();
@@ -160,7 +900,7 @@ inline void RunRegistryDemo() {
 /* C++20 版本：使用 concepts 约束工厂接口
 template<typename T>
 concept ProductFactory = requires(T t) {
-    { t.CreateProduct() } -> std::convertible_to<std::unique_ptr<Product>>;
+    { t.CreateProduct() } -> std::convertible_to<ProductPtr>;
 };
 
 template<ProductFactory Factory>
@@ -0,0 +1,542 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "FactoryMethod.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define FACTORY_METRICS_HAS_RDTSC 1
+#endif
+
+// ===========================
+// 工厂创建埋点：按类型名统计创建数、存活数与创建耗时分布
+// ===========================
+// 默认关闭，FactoryMetrics::Instance().Enable() 之后才记录；关闭时每次创建只多一次原子读取。
+//
+// - 记录点：通过 FactoryMethod.h 中的埋点挂载点（ProductTrace）接入，Enable() 安装函数表，
+//   Disable() 卸下。
+//   创建数与耗时：ProductRegistry 每次调用工厂函数（按注册名，包括 Register(name, fn) 注册的
+//   make_unique 工厂与延迟加载的插件）以及 Creator::Create() / AnOperation()（按工厂的 TraceTag()）；
+//   耗时是工厂函数本身的执行时间，批量创建（CreateMany）按平均每个产品的耗时记一个样本。
+//   存活数：MakePooledProduct<T>、ProductBatch::Create<T> 与对应的删除器记录构造 / 销毁的对象数，
+//   按产品类型名（kTypeName）统计；注册名与 kTypeName 相同时（例如内置的 "A" / "B"）合并为一行。
+// - 按线程分片：每个线程写自己的分片，计数只由所属线程写入（load + store，无原子读改写、
+//   无共享缓存行），汇总时才遍历所有分片；线程退出后分片交给下一个新线程继续使用。
+// - 耗时直方图：对数-线性分桶（HDR 风格），每个 2 的幂区间再分 8 个子桶，相对误差约 12.5%；
+//   计时用 rdtsc（其他平台退化为纳秒），导出时再换算为纳秒。一次 rdtsc 本身就要约 10~20ns
+//   （虚拟机中更慢），因此默认每个线程每 16 次创建计时一次（SetSamplePeriod 可调，1 为每次计时），
+//   其余创建只计数，平均开销保持在几个纳秒。
+// - 导出：ToJson() / ToPrometheus()（Prometheus 文本格式，可交给 node_exporter 的 textfile collector），
+//   WriteJson(path) / WritePrometheus(path) 写入本地文件。
+//
+// 注意：Enable() 之前创建、之后销毁的对象会让 live 偏小（甚至为负），建议在启动时开启。
+
+class FactoryMetrics {
+public:
+    static constexpr std::size_t kMaxTypes = 256;  // 超出的类型统一计入 "<other>"
+    static constexpr std::size_t kSubBuckets = 8;  // 每个 2 的幂区间的子桶数
+    static constexpr unsigned kMaxExponent = 47;   // 超过 2^48 个时钟周期的样本计入最后一个桶
+    static constexpr std::size_t kBuckets = (kMaxExponent - 2) * kSubBuckets + kSubBuckets;
+
+    // 单个类型的汇总结果（耗时单位均为纳秒）
+    struct TypeStats {
+        std::string type;
+        std::uint64_t created = 0;    // 工厂函数创建的产品数
+        std::uint64_t destroyed = 0;  // 对象池 / 连续存储中销毁的产品数
+        std::int64_t live = 0;        // 对象池 / 连续存储中构造且尚未销毁的产品数
+        std::uint64_t samples = 0;    // 有耗时记录的工厂调用次数（按采样周期抽样）
+        double mean_ns = 0;
+        double p50_ns = 0;
+        double p90_ns = 0;
+        double p99_ns = 0;
+        double max_ns = 0;
+        std::vector<std::pair<double, std::uint64_t>> buckets;  // 非空桶：(上界 ns, 样本数)
+    };
+
+    // 故意不析构：线程退出、静态析构阶段仍可能有产品被销毁并记录
+    static FactoryMetrics& Instance() {
+        static FactoryMetrics* metrics = new FactoryMetrics();
+        return *metrics;
+    }
+
+    FactoryMetrics(const FactoryMetrics&) = delete;
+    FactoryMetrics& operator=(const FactoryMetrics&) = delete;
+
+    static bool Enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    void Enable() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_.load(std::memory_order_relaxed)) {
+            calibrate_ticks_ = Now();
+            calibrate_time_ = std::chrono::steady_clock::now();
+            enabled_.store(true, std::memory_order_relaxed);
+            ProductTrace::Install(TraceHooks());
+        }
+    }
+
+    void Disable() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ProductTrace::Install(nullptr);
+        enabled_.store(false, std::memory_order_relaxed);
+    }
+
+    // 当前时钟读数（rdtsc 周期或纳秒）
+    static std::uint64_t Now() {
+#if defined(FACTORY_METRICS_HAS_RDTSC)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+#endif
+    }
+
+    // 为类型名分配编号；同名返回同一编号
+    std::uint32_t Intern(std::string_view type) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 0; i < names_.size(); ++i) {
+            if (names_[i] == type) {
+                return static_cast<std::uint32_t>(i);
+            }
+        }
+        if (names_.size() >= kOtherType) {
+            if (names_.size() == kOtherType) {
+                names_.emplace_back("<other>");
+            }
+            return kOtherType;
+        }
+        names_.emplace_back(type);
+        return static_cast<std::uint32_t>(names_.size() - 1);
+    }
+
+    // 每 period 次创建计时一次（按线程计数）；1 表示每次都计时。创建数与销毁数始终精确
+    static void SetSamplePeriod(std::uint32_t period) {
+        sample_period_.store(period == 0 ? 1 : period, std::memory_order_relaxed);
+    }
+
+    static std::uint32_t SamplePeriod() { return sample_period_.load(std::memory_order_relaxed); }
+
+    // 开始一次创建：本次需要计时时返回起点读数，否则返回 0
+    static std::uint64_t BeginCreate() {
+        Shard* shard = LocalShard();
+        if (shard == nullptr || --shard->countdown != 0) {
+            return 0;
+        }
+        shard->countdown = SamplePeriod();
+        return Now();
+    }
+
+    // 结束一次创建：计入 count 个产品，start 非 0 时记录平均每个产品的耗时
+    static void EndCreate(std::uint32_t type, std::uint64_t start, std::uint64_t count = 1) {
+        const std::uint64_t ticks = start != 0 ? (Now() - start) / count : 0;
+        Record(type, [start, ticks, count](TypeCounters& c) {
+            Add(c.created, count);
+            if (start != 0) {
+                Add(c.ticks_sum, ticks);
+                Add(c.buckets[BucketOf(ticks)], 1);
+                if (ticks > c.ticks_max.load(std::memory_order_relaxed)) {
+                    c.ticks_max.store(ticks, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // 存活数：对象池 / 连续存储中构造了 count 个产品
+    static void RecordConstructed(std::uint32_t type, std::uint64_t count = 1) {
+        Record(type, [count](TypeCounters& c) { Add(c.constructed, count); });
+    }
+
+    static void RecordDestroyed(std::uint32_t type, std::uint64_t count = 1) {
+        Record(type, [count](TypeCounters& c) { Add(c.destroyed, count); });
+    }
+
+    // 挂载点上的类型名对应的编号：第一次遇到该类型时分配，之后缓存在 tag 中
+    std::uint32_t IdOf(ProductTraceTag& tag) {
+        std::uint32_t id = tag.id.load(std::memory_order_relaxed);
+        if (id == ProductTraceTag::kUnassigned) {
+            id = Intern(tag.name);  // 并发时多个线程得到同一编号
+            tag.id.store(id, std::memory_order_relaxed);
+        }
+        return id;
+    }
+
+    // 汇总所有线程分片（按类型编号顺序）
+    std::vector<TypeStats> Snapshot() const {
+        const double ticks_per_ns = TicksPerNs();  // 可能临时测量，不持有 mutex_
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<TypeStats> result;
+        std::vector<std::uint64_t> buckets(kBuckets);
+        for (std::size_t id = 0; id < names_.size(); ++id) {
+            TypeStats stats;
+            stats.type = names_[id];
+            std::fill(buckets.begin(), buckets.end(), 0);
+            std::uint64_t constructed = 0;
+            std::uint64_t ticks_sum = 0;
+            std::uint64_t ticks_max = 0;
+            auto merge = [&](const Shard& shard) {
+                const TypeCounters* c = shard.types[id].load(std::memory_order_acquire);
+                if (c == nullptr) {
+                    return;
+                }
+                stats.created += c->created.load(std::memory_order_relaxed);
+                stats.destroyed += c->destroyed.load(std::memory_order_relaxed);
+                constructed += c->constructed.load(std::memory_order_relaxed);
+                ticks_sum += c->ticks_sum.load(std::memory_order_relaxed);
+                ticks_max = std::max(ticks_max, c->ticks_max.load(std::memory_order_relaxed));
+                for (std::size_t b = 0; b < kBuckets; ++b) {
+                    buckets[b] += c->buckets[b].load(std::memory_order_relaxed);
+                }
+            };
+            for (const Shard* shard : shards_) {
+                merge(*shard);
+            }
+            merge(orphan_);
+            stats.live = static_cast<std::int64_t>(constructed - stats.destroyed);
+            for (std::uint64_t n : buckets) {
+                stats.samples += n;
+            }
+            if (stats.samples > 0) {
+                stats.mean_ns = static_cast<double>(ticks_sum) / stats.samples / ticks_per_ns;
+                stats.max_ns = static_cast<double>(ticks_max) / ticks_per_ns;
+                stats.p50_ns = Percentile(buckets, stats.samples, 0.50) / ticks_per_ns;
+                stats.p90_ns = Percentile(buckets, stats.samples, 0.90) / ticks_per_ns;
+                stats.p99_ns = Percentile(buckets, stats.samples, 0.99) / ticks_per_ns;
+                for (std::size_t b = 0; b < kBuckets; ++b) {
+                    if (buckets[b] > 0) {
+                        stats.buckets.emplace_back(BucketUpper(b) / ticks_per_ns, buckets[b]);
+                    }
+                }
+            }
+            result.push_back(std::move(stats));
+        }
+        return result;
+    }
+
+    std::string ToJson() const {
+        std::ostringstream out;
+        out << "{\"types\":[";
+        bool first = true;
+        for (const TypeStats& s : Snapshot()) {
+            out << (first ? "" : ",") << "{\"type\":\"" << Escape(s.type) << "\",\"created\":"
+                << s.created << ",\"destroyed\":" << s.destroyed << ",\"live\":" << s.live
+                << ",\"latency_ns\":{\"count\":" << s.samples << ",\"mean\":" << s.mean_ns
+                << ",\"p50\":" << s.p50_ns << ",\"p90\":" << s.p90_ns << ",\"p99\":" << s.p99_ns
+                << ",\"max\":" << s.max_ns << ",\"buckets\":[";
+            for (std::size_t i = 0; i < s.buckets.size(); ++i) {
+                out << (i == 0 ? "" : ",") << "[" << s.buckets[i].first << ","
+                    << s.buckets[i].second << "]";
+            }
+            out << "]}}";
+            first = false;
+        }
+        out << "]}\n";
+        return out.str();
+    }
+
+    std::string ToPrometheus() const {
+        std::vector<TypeStats> all = Snapshot();
+        std::ostringstream out;
+        out << "# HELP factory_products_created_total Products created by factory functions, by "
+               "type.\n"
+            << "# TYPE factory_products_created_total counter\n";
+        for (const TypeStats& s : all) {
+            out << "factory_products_created_total{type=\"" << Escape(s.type) << "\"} "
+                << s.created << "\n";
+        }
+        out << "# HELP factory_products_live Pooled or batched products currently alive, by type.\n"
+            << "# TYPE factory_products_live gauge\n";
+        for (const TypeStats& s : all) {
+            out << "factory_products_live{type=\"" << Escape(s.type) << "\"} " << s.live << "\n";
+        }
+        out << "# HELP factory_create_duration_seconds Time spent in a factory function, per "
+               "product.\n"
+            << "# TYPE factory_create_duration_seconds histogram\n";
+        for (const TypeStats& s : all) {
+            const std::string label = "type=\"" + Escape(s.type) + "\"";
+            std::uint64_t cumulative = 0;
+            for (const auto& bucket : s.buckets) {
+                cumulative += bucket.second;
+                out << "factory_create_duration_seconds_bucket{" << label << ",le=\""
+                    << bucket.first * 1e-9 << "\"} " << cumulative << "\n";
+            }
+            out << "factory_create_duration_seconds_bucket{" << label << ",le=\"+Inf\"} "
+                << s.samples << "\n"
+                << "factory_create_duration_seconds_sum{" << label << "} "
+                << s.mean_ns * static_cast<double>(s.samples) * 1e-9 << "\n"
+                << "factory_create_duration_seconds_count{" << label << "} " << s.samples << "\n";
+        }
+        return out.str();
+    }
+
+    bool WriteJson(const std::string& path) const { return WriteFile(path, ToJson()); }
+
+    bool WritePrometheus(const std::string& path) const { return WriteFile(path, ToPrometheus()); }
+
+    // 对数-线性分桶：[0, 8) 每个值一个桶，之后每个 [2^e, 2^(e+1)) 区间分 8 个子桶
+    static std::size_t BucketOf(std::uint64_t ticks) {
+        if (ticks < kSubBuckets) {
+            return static_cast<std::size_t>(ticks);
+        }
+        unsigned e = HighestBit(ticks);
+        if (e > kMaxExponent) {
+            return kBuckets - 1;
+        }
+        return (e - 2) * kSubBuckets + ((ticks >> (e - 3)) & (kSubBuckets - 1));
+    }
+
+    // 桶的上界（不含）
+    static std::uint64_t BucketUpper(std::size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket + 1;
+        }
+        unsigned e = static_cast<unsigned>(bucket / kSubBuckets) + 2;
+        std::uint64_t sub = bucket % kSubBuckets;
+        return (kSubBuckets + sub + 1) << (e - 3);
+    }
+
+private:
+    // Enable() 安装到 ProductTrace 的函数表
+    static const ProductTraceHooks* TraceHooks() {
+        static const ProductTraceHooks hooks{
+            &BeginCreate,
+            [](ProductTraceTag& type, std::uint64_t start, std::uint64_t count) {
+                EndCreate(Instance().IdOf(type), start, count);
+            },
+            [](ProductTraceTag& type, std::uint64_t count) {
+                RecordConstructed(Instance().IdOf(type), count);
+            },
+            [](ProductTraceTag& type, std::uint64_t count) {
+                RecordDestroyed(Instance().IdOf(type), count);
+            }};
+        return &hooks;
+    }
+
+    static constexpr std::uint32_t kOtherType = kMaxTypes - 1;
+
+    using Counter = std::atomic<std::uint64_t>;
+
+    struct TypeCounters {
+        TypeCounters() {
+            for (auto& bucket : buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        Counter created{0};
+        Counter constructed{0};
+        Counter destroyed{0};
+        Counter ticks_sum{0};
+        Counter ticks_max{0};
+        std::array<Counter, kBuckets> buckets;
+    };
+
+    // 一个线程的分片：每个类型的计数在首次记录时分配，之后只由持有分片的线程写入
+    struct alignas(64) Shard {
+        Shard() {
+            for (auto& type : types) {
+                type.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<bool> in_use{false};
+        std::uint32_t countdown = 1;  // 距离下一次计时还剩几次创建（只由持有分片的线程读写）
+        std::array<std::atomic<TypeCounters*>, kMaxTypes> types;
+    };
+
+    // 线程退出时把分片标记为空闲，留给下一个线程
+    struct ShardLease {
+        explicit ShardLease(FactoryMetrics& owner) : shard(owner.Acquire()) {}
+
+        ~ShardLease() {
+            CachedShard() = nullptr;
+            LeaseExited() = true;
+            shard->in_use.store(false, std::memory_order_release);
+        }
+
+        Shard* shard;
+    };
+
+    FactoryMetrics() { names_.reserve(kMaxTypes); }
+
+    static void Add(Counter& counter, std::uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static unsigned HighestBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static bool& LeaseExited() {
+        thread_local bool exited = false;
+        return exited;
+    }
+
+    // 常量初始化的 thread_local 指针，访问时没有初始化检查；首次访问才走 AttachShard
+    static Shard*& CachedShard() {
+        thread_local Shard* shard = nullptr;
+        return shard;
+    }
+
+    static Shard* LocalShard() {
+        Shard* shard = CachedShard();
+        return shard != nullptr ? shard : AttachShard();
+    }
+
+    static Shard* AttachShard() {
+        if (LeaseExited()) {
+            return nullptr;  // 线程退出阶段
+        }
+        thread_local ShardLease lease(Instance());
+        CachedShard() = lease.shard;
+        return lease.shard;
+    }
+
+    Shard* Acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Shard* shard : shards_) {
+            bool expected = false;
+            if (shard->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return shard;
+            }
+        }
+        shards_.push_back(new Shard());
+        shards_.back()->in_use.store(true, std::memory_order_relaxed);
+        return shards_.back();
+    }
+
+    static TypeCounters& CountersOf(Shard& shard, std::uint32_t type) {
+        TypeCounters* counters = shard.types[type].load(std::memory_order_relaxed);
+        if (counters == nullptr) {
+            counters = new TypeCounters();
+            shard.types[type].store(counters, std::memory_order_release);
+        }
+        return *counters;
+    }
+
+    template <typename Fn>
+    static void Record(std::uint32_t type, Fn fn) {
+        if (Shard* shard = LocalShard()) {
+            fn(CountersOf(*shard, type));
+            return;
+        }
+        // 线程退出阶段：写入共享的孤儿分片
+        FactoryMetrics& metrics = Instance();
+        std::lock_guard<std::mutex> lock(metrics.mutex_);
+        fn(CountersOf(metrics.orphan_, type));
+    }
+
+    static double Percentile(const std::vector<std::uint64_t>& buckets, std::uint64_t total,
+                             double q) {
+        std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < buckets.size(); ++b) {
+            seen += buckets[b];
+            if (seen >= rank) {
+                return static_cast<double>(BucketUpper(b));
+            }
+        }
+        return static_cast<double>(BucketUpper(buckets.size() - 1));
+    }
+
+    // 时钟读数与纳秒的换算，只校准一次：Enable() 以来已超过 10ms 时直接用这段时长，否则临时测量 10ms。
+    // 测量（sleep）不持有 mutex_：否则首次创建产品（分配分片）或遇到新类型（Intern）的线程会在
+    // 工厂调用中被阻塞 10ms。只在读取起点与保存结果时短暂加锁
+    double TicksPerNs() const {
+#if defined(FACTORY_METRICS_HAS_RDTSC)
+        std::uint64_t start_ticks = 0;
+        std::chrono::steady_clock::time_point start_time;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (ticks_per_ns_ > 0) {
+                return ticks_per_ns_;
+            }
+            start_ticks = calibrate_ticks_;
+            start_time = calibrate_time_;
+        }
+        auto ns = [](std::chrono::steady_clock::duration d) {
+            return static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+        };
+        std::uint64_t ticks = Now() - start_ticks;
+        double elapsed = ns(std::chrono::steady_clock::now() - start_time);
+        if (start_ticks == 0 || elapsed < 1e7) {
+            auto t0 = std::chrono::steady_clock::now();
+            std::uint64_t c0 = Now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ticks = Now() - c0;
+            elapsed = ns(std::chrono::steady_clock::now() - t0);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ticks_per_ns_ <= 0) {  // 并发的 Snapshot 可能已先保存了结果
+            ticks_per_ns_ = elapsed > 0 ? static_cast<double>(ticks) / elapsed : 1.0;
+        }
+        return ticks_per_ns_;
+#else
+        return 1.0;
+#endif
+    }
+
+    static std::string Escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (c == '\n') {
+                out += "\\n";
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    static bool WriteFile(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+        return static_cast<bool>(file);
+    }
+
+    inline static std::atomic<bool> enabled_{false};
+    inline static std::atomic<std::uint32_t> sample_period_{16};
+
+    mutable std::mutex mutex_;  // 保护 names_、shards_ 列表、孤儿分片与校准数据（测量本身不加锁）
+    std::vector<std::string> names_;
+    std::vector<Shard*> shards_;  // 分片只增不减，线程退出后复用
+    Shard orphan_;
+    std::uint64_t calibrate_ticks_ = 0;
+    std::chrono::steady_clock::time_point calibrate_time_;
+    mutable double ticks_per_ns_ = 0;  // 0 表示尚未校准
+};
+
+template <typename T>
+std::uint32_t ProductMetricId() {
+    return FactoryMetrics::Instance().IdOf(ProductTraceTagOf<T>());
+}
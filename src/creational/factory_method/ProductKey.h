@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// ===========================
+// 注册表的键：编译期哈希、整数句柄与（可选的）完美哈希表
+// ===========================
+// ProductRegistry 原来以 std::string 为键：调用方用字面量查找时先构造一个临时 std::string，
+// 然后每次调用都对整个字符串求哈希。本文件提供三种更便宜的键：
+//
+// 1）std::string_view：不再构造临时字符串，但仍在运行期求哈希；
+// 2）TypeKey：名字 + 预先算好的 64 位 FNV-1a 哈希。声明为 constexpr 时哈希在编译期完成：
+//      static constexpr TypeKey kProductA{"A"};
+//      ProductRegistry::Create(kProductA);   // 运行期只剩查表
+// 3）ProductHandle：注册时分配的连续整数编号（interned handle），
+//    Create(handle) 直接按下标取出工厂函数，不求哈希、不比较字符串。
+//
+// KeyTable<Value> 是注册表内部使用的查找表：条目按注册顺序连续存放（下标即句柄），
+// 名字索引是开放寻址（线性探测）哈希表；冻结时可以额外构建一张完美哈希表（CHD 风格的
+// “哈希 + 位移”）：每个桶搜索一个种子，使所有键落到互不冲突的槽位，查找时只需计算一次槽位、
+// 比较一次哈希与名字，没有探测循环，适合成千上万种产品类型的注册表。
+
+// 64 位 FNV-1a 哈希，可在编译期求值
+constexpr std::uint64_t Fnv1a64(std::string_view text) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 预先计算哈希的类型键
+struct TypeKey {
+    constexpr explicit TypeKey(std::string_view type_name)
+        : name(type_name), hash(Fnv1a64(type_name)) {}
+
+    std::string_view name;
+    std::uint64_t hash;
+};
+
+// 注册时分配的产品句柄（条目在注册表中的下标）
+struct ProductHandle {
+    static constexpr std::uint32_t kInvalid = 0xFFFFFFFFu;
+
+    std::uint32_t index = kInvalid;
+
+    constexpr bool IsValid() const { return index != kInvalid; }
+};
+
+template <typename Value>
+class KeyTable {
+public:
+    static constexpr std::uint32_t kNone = ProductHandle::kInvalid;
+
+    struct Entry {
+        std::string name;
+        std::uint64_t hash;
+        Value value;
+    };
+
+    // 插入或覆盖；返回条目下标（覆盖时下标不变，已发出的句柄仍然有效）
+    std::uint32_t Insert(std::string_view name, std::uint64_t hash, Value value) {
+        std::uint32_t index = Find(hash, name);
+        if (index != kNone) {
+            entries_[index].value = std::move(value);
+            return index;
+        }
+        index = static_cast<std::uint32_t>(entries_.size());
+        entries_.push_back(Entry{std::string(name), hash, std::move(value)});
+        if (entries_.size() * 2 > slots_.size()) {
+            Rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        } else {
+            Place(index);
+        }
+        seeds_.clear();  // 条目变化后完美哈希表失效，需要重新构建
+        perfect_.clear();
+        return index;
+    }
+
+    std::uint32_t Find(std::uint64_t hash, std::string_view name) const {
+        if (!perfect_.empty()) {
+            std::uint32_t index = perfect_[PerfectSlot(hash, seeds_[Bucket(hash)])];
+            return index != kNone && Matches(entries_[index], hash, name) ? index : kNone;
+        }
+        if (slots_.empty()) {
+            return kNone;
+        }
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask) {
+            std::uint32_t index = slots_[i];
+            if (index == kNone || Matches(entries_[index], hash, name)) {
+                return index;
+            }
+        }
+    }
+
+    const Entry* At(std::uint32_t index) const {
+        return index < entries_.size() ? &entries_[index] : nullptr;
+    }
+
+    std::size_t Size() const { return entries_.size(); }
+
+    bool HasPerfectHash() const { return !perfect_.empty(); }
+
+    // 构建完美哈希表；极少数情况下（例如 64 位哈希完全相同的两个名字）构建失败，
+    // 此时返回 false 并继续使用线性探测
+    bool BuildPerfectHash() {
+        const std::size_t n = entries_.size();
+        if (n == 0) {
+            return false;
+        }
+        std::size_t buckets = NextPowerOfTwo(std::max<std::size_t>(1, n / 4));
+        std::size_t table_size = NextPowerOfTwo(n + n / 4 + 1);
+        for (int attempt = 0; attempt < 4; ++attempt, table_size *= 2) {
+            if (TryBuildPerfectHash(buckets, table_size)) {
+                return true;
+            }
+        }
+        seeds_.clear();
+        perfect_.clear();
+        return false;
+    }
+
+private:
+    static constexpr std::uint32_t kMaxSeed = 1u << 16;
+
+    static std::size_t NextPowerOfTwo(std::size_t n) {
+        std::size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static bool Matches(const Entry& entry, std::uint64_t hash, std::string_view name) {
+        return entry.hash == hash && std::string_view(entry.name) == name;
+    }
+
+    // splitmix64 的收尾混合，用于由 (哈希, 种子) 得到完美哈希槽位
+    static std::uint64_t Mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    std::size_t Bucket(std::uint64_t hash) const {
+        return static_cast<std::size_t>(hash >> 32) & (seeds_.size() - 1);
+    }
+
+    std::size_t PerfectSlot(std::uint64_t hash, std::uint32_t seed) const {
+        return static_cast<std::size_t>(Mix(hash ^ (seed * 0x9E3779B97F4A7C15ull))) &
+               (perfect_.size() - 1);
+    }
+
+    void Place(std::uint32_t index) {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t i = static_cast<std::size_t>(entries_[index].hash) & mask;
+        while (slots_[i] != kNone) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = index;
+    }
+
+    void Rehash(std::size_t size) {
+        slots_.assign(size, kNone);
+        for (std::uint32_t i = 0; i < entries_.size(); ++i) {
+            Place(i);
+        }
+    }
+
+    // 按桶大小从大到小为每个桶搜索种子，使桶内所有键落到空闲且互不相同的槽位
+    bool TryBuildPerfectHash(std::size_t bucket_count, std::size_t table_size) {
+        seeds_.assign(bucket_count, 0);
+        perfect_.assign(table_size, kNone);
+        std::vector<std::vector<std::uint32_t>> buckets(bucket_count);
+        for (std::uint32_t i = 0; i < entries_.size(); ++i) {
+            buckets[Bucket(entries_[i].hash)].push_back(i);
+        }
+        std::vector<std::size_t> order(bucket_count);
+        for (std::size_t b = 0; b < bucket_count; ++b) {
+            order[b] = b;
+        }
+        std::sort(order.begin(), order.end(), [&buckets](std::size_t a, std::size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        std::vector<std::size_t> slots;
+        for (std::size_t b : order) {
+            const auto& keys = buckets[b];
+            if (keys.empty()) {
+                break;
+            }
+            bool placed = false;
+            for (std::uint32_t seed = 1; seed < kMaxSeed && !placed; ++seed) {
+                slots.clear();
+                placed = true;
+                for (std::uint32_t key : keys) {
+                    std::size_t slot = PerfectSlot(entries_[key].hash, seed);
+                    if (perfect_[slot] != kNone ||
+                        std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        placed = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (placed) {
+                    seeds_[b] = seed;
+                    for (std::size_t k = 0; k < keys.size(); ++k) {
+                        perfect_[slots[k]] = keys[k];
+                    }
+                }
+            }
+            if (!placed) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<std::uint32_t> slots_;    // 线性探测索引，长度为 2 的幂，负载不超过 1/2
+    std::vector<std::uint32_t> seeds_;    // 完美哈希：每个桶的种子
+    std::vector<std::uint32_t> perfect_;  // 完美哈希：槽位 -> 条目下标
+};
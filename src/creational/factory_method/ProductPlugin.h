@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#define PRODUCT_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+#include <dlfcn.h>
+#define PRODUCT_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+#include "FactoryMethod.h"
+
+// ===========================
+// 插件共享库：按路径缓存、首次使用时加载、永不卸载
+// ===========================
+// 产品注册表可以把某些类型登记为“由某个共享库提供”（见下文的 RegisterProductPlugin），
+// 启动时只记下库的路径，直到第一次创建该类型的产品才 dlopen。这样不常用的产品连同它们的
+// 代码、静态数据和静态构造函数都不会拖慢启动。
+//
+// - 同一路径在进程内只对应一个 PluginLibrary，Load() 只真正执行一次（并发调用者等待同一次加载），
+//   失败也只尝试一次，原因见 Error()；
+// - 以 RTLD_NOW 加载：符号在加载时全部解析完，之后的调用不再经过延迟绑定；
+// - 库一旦加载就不再卸载：插件创建的产品、它们的虚函数表和删除器都指向库内的代码。
+
+class PluginLibrary {
+public:
+    // 取得 path 对应的库对象（不触发加载）；返回的引用在程序结束前一直有效
+    static PluginLibrary& Get(const std::string& path) {
+        static auto* mutex = new std::mutex;
+        static auto* libraries = new std::map<std::string, std::unique_ptr<PluginLibrary>>;
+        std::lock_guard<std::mutex> lock(*mutex);
+        auto& library = (*libraries)[path];
+        if (!library) {
+            library.reset(new PluginLibrary(path));
+        }
+        return *library;
+    }
+
+    PluginLibrary(const PluginLibrary&) = delete;
+    PluginLibrary& operator=(const PluginLibrary&) = delete;
+
+    // 加载共享库（幂等、线程安全），返回是否已成功加载
+    bool Load() {
+        std::call_once(once_, [this] {
+#if defined(_WIN32)
+            void* handle = reinterpret_cast<void*>(::LoadLibraryA(path_.c_str()));
+            if (handle == nullptr) {
+                error_ = "LoadLibrary failed: " + path_;
+            }
+#else
+            void* handle = ::dlopen(path_.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (handle == nullptr) {
+                const char* message = ::dlerror();
+                error_ = message != nullptr ? message : "dlopen failed: " + path_;
+            }
+#endif
+            handle_.store(handle, std::memory_order_release);
+        });
+        return IsLoaded();
+    }
+
+    bool IsLoaded() const { return handle_.load(std::memory_order_acquire) != nullptr; }
+
+    // 查找导出符号；库未加载或符号不存在时返回 nullptr
+    void* Symbol(const char* name) const {
+        void* handle = handle_.load(std::memory_order_acquire);
+        if (handle == nullptr) {
+            return nullptr;
+        }
+#if defined(_WIN32)
+        return reinterpret_cast<void*>(::GetProcAddress(static_cast<HMODULE>(handle), name));
+#else
+        return ::dlsym(handle, name);
+#endif
+    }
+
+    const std::string& Path() const { return path_; }
+
+    // 加载失败的原因（Load() 返回 false 之后有效）
+    const std::string& Error() const { return error_; }
+
+private:
+    explicit PluginLibrary(std::string path) : path_(std::move(path)) {}
+
+    const std::string path_;
+    std::once_flag once_;
+    std::atomic<void*> handle_{nullptr};
+    std::string error_;  // 只在 call_once 内写入
+};
+
+// ====================================
+// 产品插件接口（共享库导出的工厂表）
+// ====================================
+// 插件是一个共享库，用与宿主相同的 ProductPlugin.h 编译，导出一个 extern "C" 入口函数
+// kProductPluginEntry，返回它提供的产品工厂表：
+//
+//   PRODUCT_PLUGIN_EXPORT const ProductPluginExports* GetProductPluginExports() {
+//       static const ProductPluginFactory factories[] = {
+//           ProductPluginFactoryOf<MyProduct>("my.product"),
+//       };
+//       static const ProductPluginExports exports{kProductPluginAbiVersion, 1, factories};
+//       return &exports;
+//   }
+//
+// 工厂表里是函数指针（不是 std::function），插件内不需要任何动态初始化即可返回它。
+// ProductPtr / ProductBatch 按值跨越库边界，因此宿主与插件必须使用同一编译器与同一版本的头文件，
+// kProductPluginAbiVersion 不一致的插件会被拒绝。
+
+inline constexpr std::uint32_t kProductPluginAbiVersion = 1;
+inline constexpr char kProductPluginEntry[] = "GetProductPluginExports";
+
+struct ProductPluginFactory {
+    const char* type;
+    ProductPtr (*create)();
+    ProductBatch (*create_many)(std::size_t n);
+};
+
+struct ProductPluginExports {
+    std::uint32_t abi_version;
+    std::size_t count;
+    const ProductPluginFactory* factories;
+};
+
+using ProductPluginEntry = const ProductPluginExports* (*)();
+
+// 按具体类型生成工厂表项：单个产品从对象池分配，批量创建时连续存储
+template <typename T>
+constexpr ProductPluginFactory ProductPluginFactoryOf(const char* type) {
+    return ProductPluginFactory{type, [] { return MakePooledProduct<T>(); },
+                                [](std::size_t n) { return ProductBatch::Create<T>(n); }};
+}
+
+// 加载 library 并取出它的工厂表；加载失败、缺少入口或 ABI 版本不符时返回 nullptr
+inline const ProductPluginExports* LoadProductPluginExports(PluginLibrary& library) {
+    if (!library.Load()) {
+        return nullptr;
+    }
+    auto entry = reinterpret_cast<ProductPluginEntry>(library.Symbol(kProductPluginEntry));
+    const ProductPluginExports* exports = entry != nullptr ? entry() : nullptr;
+    return exports != nullptr && exports->abi_version == kProductPluginAbiVersion ? exports
+                                                                                  : nullptr;
+}
+
+// ====================================
+// 把插件中的产品注册到 ProductRegistry
+// ====================================
+// - LoadProductPlugin(library)：立即加载共享库并注册它导出的全部类型；
+// - RegisterProductPlugin(type, library)：延迟注册（ProductRegistry::RegisterDeferred），
+//   启动时只插入一个占位条目，第一次 Create 该类型时才加载共享库；
+//   加载失败或库中没有该类型时 Create 返回 nullptr，加载失败的原因见 PluginLibrary::Error()。
+
+inline ProductRegistry::Factories ProductPluginFactories(const ProductPluginFactory& factory) {
+    return ProductRegistry::Factories{factory.create, factory.create_many};
+}
+
+inline ProductHandle RegisterProductPlugin(std::string_view type, const std::string& library) {
+    PluginLibrary* plugin = &PluginLibrary::Get(library);
+    return ProductRegistry::RegisterDeferred(type, [plugin, name = std::string(type)] {
+        const ProductPluginExports* exports = LoadProductPluginExports(*plugin);
+        for (std::size_t i = 0; exports != nullptr && i < exports->count; ++i) {
+            if (name == exports->factories[i].type) {
+                return ProductPluginFactories(exports->factories[i]);
+            }
+        }
+        return ProductRegistry::Factories{};
+    });
+}
+
+// 返回注册的类型数（加载失败时为 0）
+inline std::size_t LoadProductPlugin(const std::string& library) {
+    const ProductPluginExports* exports = LoadProductPluginExports(PluginLibrary::Get(library));
+    if (exports == nullptr) {
+        return 0;
+    }
+    for (std::size_t i = 0; i < exports->count; ++i) {
+        ProductRegistry::Register(exports->factories[i].type,
+                                  ProductPluginFactories(exports->factories[i]));
+    }
+    return exports->count;
+}
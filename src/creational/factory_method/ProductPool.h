@@ -0,0 +1,266 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// ===========================
+// 按类型划分、带线程缓存的对象池
+// ===========================
+// 工厂每次 make_unique 都要走一次全局分配器；大量短命产品反复创建/销毁时，
+// 分配与释放本身就成了热点。ObjectPool<T> 为每种具体类型维护一组大小固定的内存块：
+//
+// - 线程缓存：每个线程持有一条私有空闲链表，Allocate / Deallocate 在缓存内完成时不加锁、
+//   不做原子读改写；
+// - 全局空闲链表：线程缓存为空时一次从全局取 kBatch 块，缓存超过 kCacheLimit 时一次归还
+//   kBatch 块（例如生产者/消费者线程不同的场景），这两条慢路径才加锁；
+// - 线程退出时，缓存中的块全部还给全局链表；全局链表为空时才向系统分配器申请新块（miss）。
+//
+// 池只管理内存，不负责构造/析构，也不依赖产品类型；工厂通过 FactoryMethod.h 中的
+// MakePooledProduct 使用它。块在 Trim() 之前不会还给系统。
+
+// 对象池统计（Stats() 返回的是各线程计数的汇总，多线程运行时只是近似快照）
+struct PoolStats {
+    std::uint64_t hits = 0;      // 从线程缓存或全局空闲链表取到块
+    std::uint64_t misses = 0;    // 向系统分配器申请新块
+    std::uint64_t releases = 0;  // 归还到池中的次数
+    std::size_t owned = 0;       // 池当前持有的块数（存活对象 + 空闲块）
+    std::size_t high_water = 0;  // owned 的历史峰值，即池占用内存的高水位
+
+    // 当前存活的对象数
+    std::uint64_t Live() const { return hits + misses - releases; }
+
+    double HitRate() const {
+        std::uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+template <typename T>
+class ObjectPool {
+public:
+    static constexpr std::size_t kBatch = 32;       // 线程缓存与全局链表之间一次搬运的块数
+    static constexpr std::size_t kCacheLimit = 128;  // 线程缓存的空闲块上限
+
+    // 故意不析构：线程退出时要把缓存还给池，池必须比所有线程（包括主线程的 thread_local）活得更久
+    static ObjectPool& Instance() {
+        static ObjectPool* pool = new ObjectPool();
+        return *pool;
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // 取一块可以放下 T 的未初始化内存
+    void* Allocate() {
+        ThreadCache* cache = LocalCache();
+        if (cache == nullptr) {
+            return AllocateShared();  // 线程缓存已销毁（线程退出阶段）
+        }
+        if (cache->head == nullptr) {
+            Refill(*cache);
+        }
+        if (Node* node = cache->head) {
+            cache->head = node->next;
+            --cache->count;
+            Bump(cache->hits);
+            return node;
+        }
+        Bump(cache->misses);
+        return AllocateBlock();
+    }
+
+    // 归还 Allocate() 得到的内存（对象必须已经析构）；可以在任意线程归还
+    void Deallocate(void* block) noexcept {
+        ThreadCache* cache = LocalCache();
+        if (cache == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++retired_.releases;
+            PushShared(::new (block) Node{nullptr});
+            return;
+        }
+        cache->head = ::new (block) Node{cache->head};
+        Bump(cache->releases);
+        if (++cache->count > kCacheLimit) {
+            Spill(*cache, kBatch);
+        }
+    }
+
+    PoolStats Stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PoolStats stats;
+        stats.hits = retired_.hits;
+        stats.misses = retired_.misses;
+        stats.releases = retired_.releases;
+        for (const ThreadCache* cache : caches_) {
+            stats.hits += cache->hits.load(std::memory_order_relaxed);
+            stats.misses += cache->misses.load(std::memory_order_relaxed);
+            stats.releases += cache->releases.load(std::memory_order_relaxed);
+        }
+        stats.owned = owned_.load(std::memory_order_relaxed);
+        stats.high_water = high_water_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // 把当前线程缓存和全局空闲链表中的块还给系统，返回释放的块数
+    std::size_t Trim() {
+        if (ThreadCache* cache = LocalCache()) {
+            Spill(*cache, cache->count);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t freed = 0;
+        while (Node* node = free_head_) {
+            free_head_ = node->next;
+            FreeBlock(node);
+            ++freed;
+        }
+        owned_.fetch_sub(freed, std::memory_order_relaxed);
+        return freed;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    // 计数只由所属线程写入，用 load + store 代替 fetch_add，避免原子读改写的开销
+    using Counter = std::atomic<std::uint64_t>;
+
+    struct ThreadCache {
+        explicit ThreadCache(ObjectPool& owner) : pool(owner) { pool.Attach(this); }
+
+        ~ThreadCache() {
+            pool.Detach(this);
+            CacheExited() = true;
+        }
+
+        ObjectPool& pool;
+        Node* head = nullptr;
+        std::size_t count = 0;
+        Counter hits{0};
+        Counter misses{0};
+        Counter releases{0};
+    };
+
+    struct Totals {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t releases = 0;
+    };
+
+    static constexpr std::size_t kBlockSize = sizeof(T) > sizeof(Node) ? sizeof(T) : sizeof(Node);
+    static constexpr std::size_t kBlockAlign =
+        alignof(T) > alignof(Node) ? alignof(T) : alignof(Node);
+
+    ObjectPool() = default;
+
+    static void Bump(Counter& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static bool& CacheExited() {
+        thread_local bool exited = false;
+        return exited;
+    }
+
+    // 当前线程的缓存；线程退出、缓存已经析构后返回 nullptr
+    static ThreadCache* LocalCache() {
+        if (CacheExited()) {
+            return nullptr;
+        }
+        thread_local ThreadCache cache(Instance());
+        return &cache;
+    }
+
+    void* AllocateBlock() {
+        std::size_t owned = owned_.fetch_add(1, std::memory_order_relaxed) + 1;
+        std::size_t peak = high_water_.load(std::memory_order_relaxed);
+        while (owned > peak &&
+               !high_water_.compare_exchange_weak(peak, owned, std::memory_order_relaxed)) {
+        }
+        if constexpr (kBlockAlign > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(kBlockSize, std::align_val_t(kBlockAlign));
+        } else {
+            return ::operator new(kBlockSize);
+        }
+    }
+
+    static void FreeBlock(void* block) noexcept {
+        if constexpr (kBlockAlign > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(block, std::align_val_t(kBlockAlign));
+        } else {
+            ::operator delete(block);
+        }
+    }
+
+    void* AllocateShared() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (Node* node = free_head_) {
+                free_head_ = node->next;
+                ++retired_.hits;
+                return node;
+            }
+            ++retired_.misses;
+        }
+        return AllocateBlock();
+    }
+
+    // 调用方持有 mutex_
+    void PushShared(Node* node) {
+        node->next = free_head_;
+        free_head_ = node;
+    }
+
+    void Refill(ThreadCache& cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 0; i < kBatch && free_head_ != nullptr; ++i) {
+            Node* node = free_head_;
+            free_head_ = node->next;
+            node->next = cache.head;
+            cache.head = node;
+            ++cache.count;
+        }
+    }
+
+    void Spill(ThreadCache& cache, std::size_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::size_t i = 0; i < n && cache.head != nullptr; ++i) {
+            Node* node = cache.head;
+            cache.head = node->next;
+            --cache.count;
+            PushShared(node);
+        }
+    }
+
+    void Attach(ThreadCache* cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        caches_.push_back(cache);
+    }
+
+    // 线程退出：空闲块还给全局链表，计数并入 retired_
+    void Detach(ThreadCache* cache) {
+        Spill(*cache, cache->count);
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.hits += cache->hits.load(std::memory_order_relaxed);
+        retired_.misses += cache->misses.load(std::memory_order_relaxed);
+        retired_.releases += cache->releases.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < caches_.size(); ++i) {
+            if (caches_[i] == cache) {
+                caches_[i] = caches_.back();
+                caches_.pop_back();
+                break;
+            }
+        }
+    }
+
+    mutable std::mutex mutex_;  // 保护全局空闲链表、caches_ 与 retired_
+    Node* free_head_ = nullptr;
+    std::vector<ThreadCache*> caches_;  // 仍存活的线程缓存（用于汇总统计）
+    Totals retired_;                    // 已退出线程的计数
+    std::atomic<std::size_t> owned_{0};
+    std::atomic<std::size_t> high_water_{0};
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "FactoryMethod.h"
+#include "ProductKey.h"
+
+// ===========================
+// 编译期封闭集合工厂：StaticFactory<Ps...>
+// ===========================
+// 产品集合在编译期已知时，可以不要继承体系、不要堆分配：
+// - 产品直接构造在 std::variant<std::monostate, Ps...> 里（按值返回，存放在栈上或调用方的对象中）；
+// - 调用 Use() 通过 std::visit 分派，每个分支以限定名 P::Use() 调用，不经过虚函数表；
+// - 按名字创建时，名字的 FNV-1a 哈希在编译期算好，运行期只比较哈希（编译器生成比较链或跳转表），
+//   命中后再比较一次名字；Find 本身是 constexpr，可以在 static_assert 中使用。
+//
+//   using Factory = StaticFactory<ConcreteProductA, ConcreteProductB>;
+//   auto product = Factory::Create("A");     // variant，持有 ConcreteProductA
+//   Factory::Use(product);                   // std::visit 分派
+//   static_assert(Factory::Find("B") == 1);
+//
+// 产品名取自 ProductTypeName<P>，默认使用 P::kTypeName。
+// 代价：新增产品必须重新编译（开闭原则让位于性能），variant 的大小是最大产品的大小。
+
+// 产品类型名；没有 kTypeName 成员的类型可以特化此模板
+template <typename P>
+struct ProductTypeName {
+    static constexpr std::string_view value = P::kTypeName;
+};
+
+// 编译期检查：名字两两不同，且哈希不冲突（否则 Find 无法只靠哈希区分）
+template <typename... Ps>
+constexpr bool DistinctProductNames() {
+    constexpr std::string_view names[] = {ProductTypeName<Ps>::value...};
+    for (std::size_t i = 0; i < sizeof...(Ps); ++i) {
+        for (std::size_t j = i + 1; j < sizeof...(Ps); ++j) {
+            if (names[i] == names[j] || Fnv1a64(names[i]) == Fnv1a64(names[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename... Ps>
+class StaticFactory {
+public:
+    static_assert(sizeof...(Ps) > 0, "StaticFactory needs at least one product type");
+
+    // 未知名字或下标时得到 std::monostate
+    using Variant = std::variant<std::monostate, Ps...>;
+
+    static constexpr std::size_t kCount = sizeof...(Ps);
+    static constexpr std::size_t kNotFound = kCount;
+
+    static constexpr std::array<std::string_view, kCount> kNames = {ProductTypeName<Ps>::value...};
+
+    // 按名字查找产品下标（按模板参数顺序），找不到返回 kNotFound
+    static constexpr std::size_t Find(std::string_view name) {
+        return FindImpl(name, Fnv1a64(name), std::index_sequence_for<Ps...>{});
+    }
+
+    // 按类型标签创建
+    template <typename P, typename... Args>
+    static Variant Create(Args&&... args) {
+        return Variant(std::in_place_type<P>, std::forward<Args>(args)...);
+    }
+
+    // 按下标创建（0 对应第一个产品类型）
+    static Variant Create(std::size_t index) {
+        return index < kCount ? kMakers[index]() : Variant();
+    }
+
+    // 按名字创建
+    static Variant Create(std::string_view name) { return Create(Find(name)); }
+
+    static constexpr bool IsValid(const Variant& product) { return product.index() != 0; }
+
+    // 当前持有的产品下标（monostate 时为 kNotFound）
+    static constexpr std::size_t IndexOf(const Variant& product) {
+        return product.index() == 0 ? kNotFound : product.index() - 1;
+    }
+
+    // 对持有的产品调用 Use()（非虚调用）；monostate 时什么也不做
+    static void Use(Variant& product) {
+        std::visit(
+            [](auto& p) {
+                using P = std::decay_t<decltype(p)>;
+                if constexpr (!std::is_same_v<P, std::monostate>) {
+                    p.P::Use();
+                }
+            },
+            product);
+    }
+
+private:
+    static_assert(DistinctProductNames<Ps...>(), "product names (and their hashes) must be distinct");
+
+    static constexpr std::array<std::uint64_t, kCount> kHashes = {
+        Fnv1a64(ProductTypeName<Ps>::value)...};
+
+    template <std::size_t... Is>
+    static constexpr std::size_t FindImpl(std::string_view name, std::uint64_t hash,
+                                          std::index_sequence<Is...>) {
+        std::size_t index = kNotFound;
+        // 展开为 hash == kHashes[0] || hash == kHashes[1] || ...，各分支的常量在编译期已知
+        static_cast<void>(((hash == kHashes[Is] ? (index = Is, true) : false) || ...));
+        return index != kNotFound && kNames[index] == name ? index : kNotFound;
+    }
+
+    template <typename P>
+    static Variant Make() {
+        return Variant(std::in_place_type<P>);
+    }
+
+    using Maker = Variant (*)();
+    static constexpr Maker kMakers[kCount] = {&Make<Ps>...};
+};
+
+// 示例产品的封闭集合工厂：产品按值存放在 std::variant 中，不分配堆内存
+using ProductVariantFactory = StaticFactory<ConcreteProductA, ConcreteProductB>;
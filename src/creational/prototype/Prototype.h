@@ -1,8 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 // 原型模式（Prototype）示例
 // ---------------------------
@@ -14,6 +22,8 @@
 // - 创建对象成本较高（如复杂初始化、深层对象图等）；
 // - 需要频繁创建“大致相同但略有差异”的对象。
 
+class PrototypeBatch;
+
 // 抽象原型
 class Prototype {
 public:
@@ -22,6 +32,221 @@ public:
     // 克隆接口：返回一个新的堆对象，由调用者负责管理（这里用智能指针）
     virtual std::unique_ptr<Prototype> Clone() const = 0;
     virtual void Show() const = 0;
+
+    // 批量克隆（可选）：每个克隆占 CloneSize() 字节，按 CloneAlign() 对齐。
+    // 默认返回 0，表示不支持原地克隆：CloneN 退回到逐个 Clone()，只实现 Clone() 的原型无需修改
+    virtual std::size_t CloneSize() const { return 0; }
+    virtual std::size_t CloneAlign() const { return alignof(std::max_align_t); }
+
+    // 在调用方提供的未初始化存储上连续构造 n 个克隆（storage 至少 n * CloneSize() 字节，
+    // 按 CloneAlign() 对齐），返回第一个克隆；第 i 个克隆位于 storage + i * CloneSize()。
+    // 克隆由调用方负责析构。某个克隆构造失败时，已构造的克隆会先被析构，再重新抛出异常。
+    // CloneSize() 为 0 的原型不支持，默认实现抛出 std::logic_error
+    virtual Prototype* CloneInto(void* /*storage*/, std::size_t /*n*/) const {
+        throw std::logic_error("Prototype: CloneInto is not supported, use Clone()");
+    }
+
+    // 克隆 n 次：一次虚调用、一次分配，n 个克隆连续存放
+    PrototypeBatch CloneN(std::size_t n) const;
+};
+
+// ====================================
+// 批量克隆：一次分配，连续存放
+// ====================================
+// 逐个调用 Clone() 克隆 n 次需要 n 次虚调用、n 次堆分配，克隆散落在堆上。
+// CloneN(n) 只做一次虚调用：具体原型已知自己的类型，在一块连续内存上按 sizeof 步长直接拷贝构造。
+// 拷贝构造不会抛出异常时，CloneCopiesInto 在编译期选择快速路径：
+// 从局部快照复制，循环中没有异常处理与回滚记录，编译器可以把固定大小的状态复制展开或向量化。
+// 状态可平凡复制的 TrivialPrototype 更进一步：每个克隆只构造（写入虚表指针），再把载荷 memcpy 进去。
+// 没有覆盖 CloneSize() 的原型，CloneN 退回到逐个 Clone()，结果同样装在 PrototypeBatch 里。
+
+// CloneN 的结果：持有一块连续内存和其中的 n 个克隆，只能移动
+class PrototypeBatch {
+public:
+    PrototypeBatch() = default;
+    PrototypeBatch(PrototypeBatch&& other) noexcept { Swap(other); }
+    PrototypeBatch& operator=(PrototypeBatch&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            Swap(other);
+        }
+        return *this;
+    }
+    PrototypeBatch(const PrototypeBatch&) = delete;
+    PrototypeBatch& operator=(const PrototypeBatch&) = delete;
+    ~PrototypeBatch() { Reset(); }
+
+    std::size_t Size() const { return size_; }
+    bool Empty() const { return size_ == 0; }
+    // 相邻两个克隆的地址差（即具体原型的 sizeof）；逐个 Clone() 得到的批次为 0
+    std::size_t Stride() const { return stride_; }
+
+    Prototype& operator[](std::size_t i) { return *At(i); }
+    const Prototype& operator[](std::size_t i) const { return *At(i); }
+
+    // 析构全部克隆并释放内存
+    void Reset() noexcept {
+        if (storage_ != nullptr) {
+            for (std::size_t i = 0; i < size_; ++i) {
+                At(i)->~Prototype();
+            }
+            ::operator delete(storage_, std::align_val_t(align_));
+        }
+        storage_ = nullptr;
+        clones_.reset();
+        size_ = 0;
+        stride_ = 0;
+    }
+
+private:
+    friend class Prototype;
+
+    Prototype* At(std::size_t i) const {
+        if (storage_ == nullptr) {
+            return clones_[i].get();
+        }
+        return reinterpret_cast<Prototype*>(storage_ + i * stride_ + base_offset_);
+    }
+
+    void Swap(PrototypeBatch& other) noexcept {
+        std::swap(storage_, other.storage_);
+        std::swap(clones_, other.clones_);
+        std::swap(size_, other.size_);
+        std::swap(stride_, other.stride_);
+        std::swap(align_, other.align_);
+        std::swap(base_offset_, other.base_offset_);
+    }
+
+    unsigned char* storage_ = nullptr;
+    std::unique_ptr<std::unique_ptr<Prototype>[]> clones_;  // 不支持原地克隆时逐个 Clone() 的结果
+    std::size_t size_ = 0;
+    std::size_t stride_ = 0;
+    std::size_t align_ = alignof(std::max_align_t);
+    std::size_t base_offset_ = 0;  // Prototype 基类子对象在克隆中的偏移
+};
+
+inline PrototypeBatch Prototype::CloneN(std::size_t n) const {
+    PrototypeBatch batch;
+    if (n == 0) {
+        return batch;
+    }
+    const std::size_t stride = CloneSize();
+    if (stride == 0) {
+        batch.clones_.reset(new std::unique_ptr<Prototype>[n]);
+        for (std::size_t i = 0; i < n; ++i) {
+            batch.clones_[i] = Clone();
+        }
+        batch.size_ = n;
+        return batch;
+    }
+    if (n > static_cast<std::size_t>(-1) / stride) {
+        throw std::bad_array_new_length();
+    }
+    const std::size_t align = CloneAlign();
+    auto* storage =
+        static_cast<unsigned char*>(::operator new(n * stride, std::align_val_t(align)));
+    Prototype* first = nullptr;
+    try {
+        first = CloneInto(storage, n);
+    } catch (...) {
+        ::operator delete(storage, std::align_val_t(align));
+        throw;
+    }
+    batch.storage_ = storage;
+    batch.size_ = n;
+    batch.stride_ = stride;
+    batch.align_ = align;
+    batch.base_offset_ =
+        static_cast<std::size_t>(reinterpret_cast<unsigned char*>(first) - storage);
+    return batch;
+}
+
+// 供具体原型实现 CloneInto：在 storage 上构造 prototype 的 n 个副本
+template <typename T>
+Prototype* CloneCopiesInto(const T& prototype, void* storage, std::size_t n) {
+    auto* slots = static_cast<T*>(storage);
+    if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+        // 快速路径：拷贝不会失败，无需回滚。从局部快照复制，
+        // 避免编译器因 prototype 可能与目标内存重叠而在每次迭代重新读取源对象
+        const T snapshot(prototype);
+        for (std::size_t i = 0; i < n; ++i) {
+            ::new (static_cast<void*>(slots + i)) T(snapshot);
+        }
+    } else {
+        std::size_t constructed = 0;
+        try {
+            for (; constructed < n; ++constructed) {
+                ::new (static_cast<void*>(slots + constructed)) T(prototype);
+            }
+        } catch (...) {
+            while (constructed > 0) {
+                slots[--constructed].~T();
+            }
+            throw;
+        }
+    }
+    return slots;
+}
+
+// 状态放在 Payload 中的原型（CRTP）：Clone / CloneSize / CloneAlign / CloneInto 由基类实现。
+// Payload 可平凡复制（编译期检测）且 Derived 用 using TrivialPrototype::TrivialPrototype;
+// 继承基类构造函数、不再添加成员时，CloneInto 走 memcpy 快速路径；否则逐个拷贝构造。
+// 要求：走快速路径的 Derived 不得自定义拷贝构造函数（编译期无法检测）。快速路径不调用它，
+// 自定义的拷贝逻辑只在 Clone() 中生效，CloneN 的结果会与 Clone() 不同；需要自定义拷贝时
+// 不要继承 CloneSlot 构造函数，CloneInto 会改为逐个拷贝构造
+template <typename Derived, typename Payload>
+class TrivialPrototype : public Prototype {
+    // 只有基类能创建的标签：批量克隆时构造不复制载荷的空壳
+    struct CloneSlot {
+        explicit CloneSlot() = default;
+    };
+
+public:
+    // 批量克隆专用：只构造对象（写入虚表指针），载荷随后由 CloneInto 复制
+    explicit TrivialPrototype(CloneSlot) {}
+
+    std::unique_ptr<Prototype> Clone() const override {
+        return std::make_unique<Derived>(static_cast<const Derived&>(*this));
+    }
+    std::size_t CloneSize() const override { return sizeof(Derived); }
+    std::size_t CloneAlign() const override { return alignof(Derived); }
+    Prototype* CloneInto(void* storage, std::size_t n) const override {
+        // 在函数体内判断：类模板实例化时 Derived 还不完整
+        constexpr bool kFillsPayload = std::is_trivially_copyable_v<Payload> &&
+                                       std::is_default_constructible_v<Payload> &&
+                                       std::is_constructible_v<Derived, CloneSlot> &&
+                                       sizeof(Derived) == sizeof(TrivialPrototype);
+        if constexpr (kFillsPayload) {
+            FillClones(static_cast<Derived*>(storage), n);
+            return static_cast<Derived*>(storage);
+        } else {
+            return CloneCopiesInto(static_cast<const Derived&>(*this), storage, n);
+        }
+    }
+
+    const Payload& Data() const { return payload_; }
+    Payload& MutableData() { return payload_; }
+
+protected:
+    explicit TrivialPrototype(const Payload& payload) : payload_(payload) {}
+
+private:
+    // 先构造空壳（只写入虚表指针），再把载荷逐个 memcpy 进每个克隆的 payload_ 子对象。
+    // 只写载荷本身：克隆是多态对象、不可平凡复制，不能整段复制跨过虚表指针与填充的字节。
+    // 载荷大小是编译期常量，memcpy 由编译器展开为定长的加载 / 存储；源是局部快照，留在寄存器或 L1 中
+    void FillClones(Derived* slots, std::size_t n) const {
+        const Payload snapshot = payload_;
+        for (std::size_t i = 0; i < n; ++i) {
+            ::new (static_cast<void*>(slots + i)) Derived(CloneSlot{});
+            std::memcpy(&PayloadOf(slots[i]), &snapshot, sizeof(Payload));
+        }
+    }
+
+    static Payload& PayloadOf(Derived& clone) {
+        return static_cast<TrivialPrototype&>(clone).payload_;
+    }
+
+    Payload payload_;
 };
 
 // 具体原型
@@ -35,10 +260,22 @@ public:
         return std::make_unique<ConcretePrototype>(*this);
     }
 
+    std::size_t CloneSize() const override { return sizeof(ConcretePrototype); }
+    std::size_t CloneAlign() const override { return alignof(ConcretePrototype); }
+    Prototype* CloneInto(void* storage, std::size_t n) const override {
+        // 复制 name_ 可能分配内存并抛出异常：走带回滚的路径
+        return CloneCopiesInto(*this, storage, n);
+    }
+
     void Show() const override {
         std::cout << "ConcretePrototype{name=" << name_ << ", value=" << value_ << "}" << std::endl;
     }
 
+    const std::string& Name() const { return name_; }
+    int Value() const { return value_; }
+    void SetName(std::string name) { name_ = std::move(name); }
+    void SetValue(int value) { value_ = value; }
+
 private:
     std::string name_;
     int value_;
@@ -53,3 +290,120 @@ inline void RunPrototypeDemo() {
     auto p2 = p1->Clone();
     p2->Show();
 }
+
+// ====================================
+// 性能优化：写时复制（COW）原型
+// ====================================
+// ConcretePrototype::Clone() 深拷贝全部成员（name_ 超过 SSO 长度时还有一次堆分配），
+// 而大多数克隆出来的对象从未被修改。写时复制把对象的状态放进一个引用计数的状态块：
+// - Clone() 只复制一个指针并把引用计数加一，与状态大小无关（O(1)）；
+// - 只读访问直接读共享的状态块；
+// - 第一次修改时，如果状态块仍被共享，先复制一份再修改，之后的修改直接在私有副本上进行。
+// 引用计数是原子的：不同线程可以各自持有共享同一状态块的克隆；单个对象本身仍不是线程安全的。
+
+// 写时复制句柄：持有引用计数的 T。拷贝只增加计数；Mutable() 在共享时先复制。
+// 不提供移动操作：移动退化为拷贝（同样只增加计数），被移动后的句柄仍指向原状态块，
+// 因此句柄永远非空，被移动后的 CowPrototype 仍可正常克隆与读写
+template <typename T>
+class CowPtr {
+public:
+    explicit CowPtr(T value) : block_(new Block(std::move(value))) {}
+
+    CowPtr(const CowPtr& other) noexcept : block_(other.block_) {
+        block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CowPtr& operator=(const CowPtr& other) noexcept {
+        if (block_ != other.block_) {
+            other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+            Release();
+            block_ = other.block_;
+        }
+        return *this;
+    }
+
+    ~CowPtr() { Release(); }
+
+    const T& operator*() const { return block_->value; }
+    const T* operator->() const { return &block_->value; }
+
+    // 可写引用：状态块被共享时先复制一份私有副本（只在第一次写入时发生）
+    T& Mutable() {
+        // acquire：与其他持有者释放时的 release 配对，确认独占后才能原地修改
+        if (block_->refs.load(std::memory_order_acquire) != 1) {
+            Block* copy = new Block(block_->value);
+            Release();
+            block_ = copy;
+        }
+        return block_->value;
+    }
+
+    bool IsShared() const { return block_->refs.load(std::memory_order_acquire) != 1; }
+    bool SharesWith(const CowPtr& other) const { return block_ == other.block_; }
+
+private:
+    struct Block {
+        explicit Block(T v) : value(std::move(v)) {}
+        std::atomic<std::uint32_t> refs{1};
+        T value;
+    };
+
+    void Release() noexcept {
+        if (block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete block_;
+        }
+    }
+
+    Block* block_;
+};
+
+// 写时复制原型基类（CRTP）：Derived 的状态全部放在 State 中，
+// Derived 只读访问用 Read()，修改前调用 Write()；Clone() 由基类实现
+template <typename Derived, typename State>
+class CowPrototype : public Prototype {
+public:
+    std::unique_ptr<Prototype> Clone() const override {
+        return std::make_unique<Derived>(static_cast<const Derived&>(*this));
+    }
+    std::size_t CloneSize() const override { return sizeof(Derived); }
+    std::size_t CloneAlign() const override { return alignof(Derived); }
+    // 每个克隆只复制状态块指针并增加计数：n 个克隆共享同一个状态块
+    Prototype* CloneInto(void* storage, std::size_t n) const override {
+        return CloneCopiesInto(static_cast<const Derived&>(*this), storage, n);
+    }
+
+    // 是否与 other 共享同一个状态块（测试与诊断用）
+    bool SharesStateWith(const CowPrototype& other) const { return state_.SharesWith(other.state_); }
+
+protected:
+    explicit CowPrototype(State state) : state_(std::move(state)) {}
+
+    const State& Read() const { return *state_; }
+    State& Write() { return state_.Mutable(); }
+
+private:
+    CowPtr<State> state_;
+};
+
+struct ConcretePrototypeState {
+    std::string name;
+    int value = 0;
+};
+
+// 具体原型（写时复制版本）：接口与输出和 ConcretePrototype 相同
+class CowConcretePrototype final
+    : public CowPrototype<CowConcretePrototype, ConcretePrototypeState> {
+public:
+    CowConcretePrototype(std::string name, int value)
+        : CowPrototype(ConcretePrototypeState{std::move(name), value}) {}
+
+    void Show() const override {
+        std::cout << "ConcretePrototype{name=" << Read().name << ", value=" << Read().value << "}"
+                  << std::endl;
+    }
+
+    const std::string& Name() const { return Read().name; }
+    int Value() const { return Read().value; }
+    void SetName(std::string name) { Write().name = std::move(name); }
+    void SetValue(int value) { Write().value = value; }
+};
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "Prototype.h"
+
+// ====================================
+// 预热原型池：后台补充的原型注册表
+// ====================================
+// 延迟敏感的请求路径按需调用 Clone() 时，要在请求线程上付出构造与分配的全部开销。
+// PrototypePool 为每个注册的原型预先克隆好 capacity 个对象：
+// - Acquire(id) 从该原型的无锁栈弹出一个现成的克隆，请求线程上没有构造、没有分配、不加锁；
+// - 池中剩余数量跌破低水位时唤醒后台线程，由它调用 Clone() 补满；
+// - 池子被取空时（突发超过容量、后台还没补上）Acquire 退回到在调用线程上直接 Clone()。
+// 取出的克隆是普通的堆对象，与 Clone() 的返回值一样由调用者持有和释放，不归还给池。
+//
+// 每个池的槽位数组固定为 capacity 个，分别挂在两个 Treiber 栈上：
+// ready（装着克隆）与 free（空槽位）。
+// 栈顶是打包在 64 位原子量里的 {槽位下标, 版本号}，每次修改版本号加一，
+// 槽位被弹出又压回（ABA）时 CAS 会因版本号不同而失败。
+
+class PrototypePool {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct Stats {
+        std::size_t capacity = 0;
+        std::size_t ready = 0;     // 当前池中的克隆数（近似值）
+        std::size_t hits = 0;      // Acquire 从池中取到克隆的次数
+        std::size_t misses = 0;    // 池子为空、在调用线程上 Clone() 的次数
+        std::size_t refilled = 0;  // 后台线程补充的克隆数
+    };
+
+    // max_prototypes：最多可以注册的原型数
+    explicit PrototypePool(std::size_t max_prototypes = 64)
+        : max_pools_(max_prototypes), pools_(new std::unique_ptr<Pool>[max_prototypes]) {
+        replenisher_ = std::thread([this] { ReplenishLoop(); });
+    }
+
+    ~PrototypePool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        replenisher_.join();
+    }
+
+    PrototypePool(const PrototypePool&) = delete;
+    PrototypePool& operator=(const PrototypePool&) = delete;
+
+    // 注册原型并在调用线程上把池子填满 capacity 个克隆，返回 Acquire 使用的 id。
+    // 剩余数量低于 low_watermark 时开始后台补充（默认为容量的一半）。
+    // 可以与 Acquire 并发调用；名字重复或超过 max_prototypes 时抛出异常
+    std::size_t Register(std::string name, std::unique_ptr<Prototype> prototype,
+                         std::size_t capacity, std::size_t low_watermark = npos) {
+        if (!prototype) {
+            throw std::invalid_argument("PrototypePool: null prototype");
+        }
+        if (capacity == 0 || capacity >= kNone) {
+            throw std::invalid_argument("PrototypePool: invalid capacity");
+        }
+        std::lock_guard<std::mutex> lock(register_mutex_);
+        const std::size_t id = count_.load(std::memory_order_relaxed);
+        if (id == max_pools_) {
+            throw std::length_error("PrototypePool: too many prototypes");
+        }
+        if (ids_.count(name) != 0) {
+            throw std::invalid_argument("PrototypePool: duplicate prototype name " + name);
+        }
+        auto pool = std::make_unique<Pool>(std::move(prototype), capacity,
+                                           low_watermark == npos ? capacity / 2 : low_watermark);
+        for (std::uint32_t i = 0; i < capacity; ++i) {
+            pool->free.Push(pool->slots.get(), i);
+        }
+        Fill(*pool);
+        ids_.emplace(std::move(name), id);
+        pools_[id] = std::move(pool);
+        count_.store(id + 1, std::memory_order_release);  // 发布给后台线程
+        return id;
+    }
+
+    // 按名字查找 id，找不到时返回 npos（加锁，不要放在请求路径上）
+    std::size_t Find(std::string_view name) const {
+        std::lock_guard<std::mutex> lock(register_mutex_);
+        auto it = ids_.find(std::string(name));
+        return it == ids_.end() ? npos : it->second;
+    }
+
+    std::size_t Size() const { return count_.load(std::memory_order_acquire); }
+
+    // 取一个克隆：优先从池中弹出，池空时在调用线程上 Clone()。
+    // id 必须来自 Register，且 Register 与本次调用之间有 happens-before 关系
+    // （例如在同一线程上，或通过锁 / 原子量把 id 交给请求线程）
+    std::unique_ptr<Prototype> Acquire(std::size_t id) {
+        Pool& pool = *pools_[id];
+        std::uint32_t slot = 0;
+        if (pool.ready.Pop(pool.slots.get(), slot)) {
+            Prototype* object = pool.slots[slot].object;
+            pool.free.Push(pool.slots.get(), slot);
+            pool.hits.fetch_add(1, std::memory_order_relaxed);
+            if (pool.ready_count.fetch_sub(1, std::memory_order_relaxed) <= pool.low_watermark) {
+                RequestRefill();
+            }
+            return std::unique_ptr<Prototype>(object);
+        }
+        pool.misses.fetch_add(1, std::memory_order_relaxed);
+        RequestRefill();
+        return pool.prototype->Clone();
+    }
+
+    Stats GetStats(std::size_t id) const {
+        const Pool& pool = *pools_[id];
+        Stats stats;
+        stats.capacity = pool.capacity;
+        stats.ready = pool.ready_count.load(std::memory_order_relaxed);
+        stats.hits = pool.hits.load(std::memory_order_relaxed);
+        stats.misses = pool.misses.load(std::memory_order_relaxed);
+        stats.refilled = pool.refilled.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Slot {
+        Prototype* object = nullptr;
+        std::atomic<std::uint32_t> next{kNone};  // 栈中下一个槽位；弹出时可能与其他线程并发读写
+    };
+
+    // 以槽位下标为元素的 Treiber 栈：栈顶低 32 位是下标，高 32 位是版本号
+    class IndexStack {
+    public:
+        // release：压栈前对槽位的写入（克隆指针）对弹出它的线程可见
+        void Push(Slot* slots, std::uint32_t index) {
+            std::uint64_t head = head_.load(std::memory_order_relaxed);
+            do {
+                slots[index].next.store(Index(head), std::memory_order_relaxed);
+            } while (!head_.compare_exchange_weak(head, Pack(index, Tag(head) + 1),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        }
+
+        bool Pop(Slot* slots, std::uint32_t& index) {
+            std::uint64_t head = head_.load(std::memory_order_acquire);
+            for (;;) {
+                const std::uint32_t top = Index(head);
+                if (top == kNone) {
+                    return false;
+                }
+                // 读到的 next 可能已过期（槽位被别的线程弹出又压回），
+                // 此时版本号已变，CAS 失败后重试
+                const std::uint32_t next = slots[top].next.load(std::memory_order_relaxed);
+                if (head_.compare_exchange_weak(head, Pack(next, Tag(head) + 1),
+                                                std::memory_order_acquire,
+                                                std::memory_order_acquire)) {
+                    index = top;
+                    return true;
+                }
+            }
+        }
+
+    private:
+        static std::uint64_t Pack(std::uint32_t index, std::uint32_t tag) {
+            return (static_cast<std::uint64_t>(tag) << 32) | index;
+        }
+        static std::uint32_t Index(std::uint64_t head) { return static_cast<std::uint32_t>(head); }
+        static std::uint32_t Tag(std::uint64_t head) {
+            return static_cast<std::uint32_t>(head >> 32);
+        }
+
+        alignas(64) std::atomic<std::uint64_t> head_{Pack(kNone, 0)};
+    };
+
+    struct Pool {
+        Pool(std::unique_ptr<Prototype> p, std::size_t cap, std::size_t low)
+            : prototype(std::move(p)), capacity(cap), low_watermark(low), slots(new Slot[cap]) {}
+
+        // 析构时池中的克隆随之释放（此时已没有并发访问）
+        ~Pool() {
+            std::uint32_t slot = 0;
+            while (ready.Pop(slots.get(), slot)) {
+                delete slots[slot].object;
+            }
+        }
+
+        const std::unique_ptr<Prototype> prototype;
+        const std::size_t capacity;
+        const std::size_t low_watermark;
+        std::unique_ptr<Slot[]> slots;
+        IndexStack ready;
+        IndexStack free;
+        alignas(64) std::atomic<std::size_t> ready_count{0};
+        std::atomic<std::size_t> hits{0};
+        std::atomic<std::size_t> misses{0};
+        std::atomic<std::size_t> refilled{0};
+    };
+
+    // 用空槽位装入新克隆，直到池满。只由注册线程（发布前）或后台线程调用，free 栈只有一个弹出者。
+    // Clone() 抛出异常时停止本轮补充，空槽位放回 free 栈，下次唤醒再试
+    static std::size_t Fill(Pool& pool) {
+        std::size_t filled = 0;
+        std::uint32_t slot = 0;
+        while (pool.free.Pop(pool.slots.get(), slot)) {
+            try {
+                pool.slots[slot].object = pool.prototype->Clone().release();
+            } catch (...) {
+                pool.free.Push(pool.slots.get(), slot);
+                break;
+            }
+            // 先加计数再压栈：计数不会小于实际数量，请求线程减一时不会回绕
+            pool.ready_count.fetch_add(1, std::memory_order_relaxed);
+            pool.ready.Push(pool.slots.get(), slot);
+            ++filled;
+        }
+        return filled;
+    }
+
+    // 只有把标志从 false 改为 true 的线程发出通知，并在通知前短暂持有 wake_mutex_：
+    // 后台线程检查条件与开始等待都在锁内，通知不会落在两者之间而丢失，后台线程可以无限期睡眠。
+    // 已有未处理的请求时只读一次标志，不做原子写也不加锁（低于低水位后每次取用都会走到这里）
+    void RequestRefill() {
+        if (!refill_pending_.load(std::memory_order_relaxed) &&
+            !refill_pending_.exchange(true, std::memory_order_acq_rel)) {
+            { std::lock_guard<std::mutex> lock(wake_mutex_); }
+            wake_.notify_one();
+        }
+    }
+
+    void ReplenishLoop() {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        for (;;) {
+            wake_.wait(lock, [this] {
+                return stop_ || refill_pending_.load(std::memory_order_acquire);
+            });
+            if (stop_) {
+                return;
+            }
+            refill_pending_.store(false, std::memory_order_release);
+            lock.unlock();
+            const std::size_t count = count_.load(std::memory_order_acquire);
+            for (std::size_t id = 0; id < count; ++id) {
+                Pool& pool = *pools_[id];
+                pool.refilled.fetch_add(Fill(pool), std::memory_order_relaxed);
+            }
+            lock.lock();
+        }
+    }
+
+    const std::size_t max_pools_;
+    std::unique_ptr<std::unique_ptr<Pool>[]> pools_;  // 固定长度，注册时不搬移已有的池
+    std::atomic<std::size_t> count_{0};
+
+    mutable std::mutex register_mutex_;  // 串行化 Register，保护 ids_
+    std::unordered_map<std::string, std::size_t> ids_;
+
+    std::atomic<bool> refill_pending_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::thread replenisher_;
+};
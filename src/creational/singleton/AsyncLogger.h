@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+// ===========================
+// 异步无锁日志单例 AsyncLogger
+// ===========================
+// 背景：Singletons.h 中每个 Log() 都是 `std::cout << ... << std::endl`，
+// 所有线程在流锁上串行，并且 endl 每条消息都触发一次 flush（write 系统调用）。
+//
+// 设计：
+// 1）生产者（任意线程）把一条记录拷贝进有界 MPSC 环形缓冲区，不加锁、不做系统调用；
+//    环形缓冲区采用“每个槽位一个序号”的经典无锁队列（Dmitry Vyukov 的 bounded queue），
+//    生产者之间只在 enqueue_pos_ 上做一次 CAS，槽位按缓存行对齐避免伪共享。
+// 2）唯一的后台线程按顺序取出已提交的记录，拼接到本地批量缓冲区，攒满或队列暂时为空时
+//    一次 write() 写入文件描述符（默认标准输出）。队列持续为空时后台线程在条件变量上挂起，
+//    生产者只在它挂起时才去唤醒（见 Park / Wake），空闲时不占用 CPU。
+// 3）队列满时的处理由 OverflowPolicy 决定：
+//    - kBlock：自旋/让出 CPU 直到有空位（不丢日志，但生产者可能被拖慢）；
+//    - kDrop ：直接丢弃，不做任何记账（生产者延迟最稳定）；
+//    - kCount：丢弃并计数，后台线程会输出一行“dropped N messages”提示。
+// 4）单条记录最长 kMaxRecordBytes 字节，超长部分被截断。
+//
+// 注意：AsyncLogger 是 Meyers 单例，程序退出时析构函数会排空队列并回收后台线程；
+// 静态对象的析构函数中不要再调用 Log()。
+enum class OverflowPolicy { kBlock, kDrop, kCount };
+
+class AsyncLogger {
+public:
+    static constexpr std::size_t kCapacity = 8192;  // 槽位数，必须是 2 的幂
+    static constexpr std::size_t kSlotBytes = 256;  // 每个槽位（含序号与长度）占用的字节数
+
+    struct Stats {
+        std::uint64_t written = 0;  // 已写出的记录数
+        std::uint64_t dropped = 0;  // kCount 策略下丢弃的记录数
+        std::uint64_t batches = 0;  // write() 调用次数
+        std::uint64_t parks = 0;    // 后台线程因空闲挂起的次数
+    };
+
+    static AsyncLogger& Instance() {
+        static AsyncLogger instance;
+        return instance;
+    }
+
+    // 提交一条日志：prefix + message + '\n'。返回 false 表示按溢出策略被丢弃
+    bool Log(std::string_view prefix, std::string_view message) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &slots_[pos & kMask];
+            std::size_t seq = slot->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                // seq_cst：与 Park() 中对 sleeping_ 的写入、对 enqueue_pos_ 的读取构成全序，
+                // 要么后台线程看到这个槽位而不挂起，要么这里看到它已挂起并唤醒它
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // 队列已满
+                OverflowPolicy policy = policy_.load(std::memory_order_relaxed);
+                if (policy == OverflowPolicy::kDrop) {
+                    return false;
+                }
+                if (policy == OverflowPolicy::kCount) {
+                    // 与提交记录相同：seq_cst 计数后检查 sleeping_，和 Park() 中对 dropped_ 的
+                    // 再次检查配对，后台线程不会带着未写出的丢弃提示挂起
+                    dropped_.fetch_add(1, std::memory_order_seq_cst);
+                    if (sleeping_.load(std::memory_order_seq_cst)) {
+                        Wake();
+                    }
+                    return false;
+                }
+                std::this_thread::yield();
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t len = std::min(prefix.size(), kMaxRecordBytes - 1);
+        std::memcpy(slot->data, prefix.data(), len);
+        std::size_t body = std::min(message.size(), kMaxRecordBytes - 1 - len);
+        std::memcpy(slot->data + len, message.data(), body);
+        len += body;
+        slot->data[len++] = '\n';
+        slot->len = static_cast<std::uint32_t>(len);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        if (sleeping_.load(std::memory_order_seq_cst)) {
+            Wake();
+        }
+        return true;
+    }
+
+    // 阻塞直到调用前已提交的记录（以及 kCount 策略的丢弃提示）全部写出
+    void Flush() {
+        std::size_t target = enqueue_pos_.load(std::memory_order_acquire);
+        std::uint64_t dropped = dropped_.load(std::memory_order_acquire);
+        while (flushed_pos_.load(std::memory_order_acquire) < target ||
+               flushed_dropped_.load(std::memory_order_acquire) < dropped) {
+            // 还没追上时后台线程不该挂起；万一已挂起就叫醒它，而不是干等下一条日志
+            if (sleeping_.load(std::memory_order_seq_cst)) {
+                Wake();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    void SetOverflowPolicy(OverflowPolicy policy) {
+        policy_.store(policy, std::memory_order_relaxed);
+    }
+
+    OverflowPolicy GetOverflowPolicy() const { return policy_.load(std::memory_order_relaxed); }
+
+    // 切换输出的文件描述符；已经在批量缓冲区里的记录可能仍写往旧的描述符，需要时先 Flush()
+    void SetOutputFd(int fd) { fd_.store(fd, std::memory_order_relaxed); }
+
+    Stats GetStats() const {
+        Stats stats;
+        stats.written = written_.load(std::memory_order_relaxed);
+        stats.dropped = dropped_.load(std::memory_order_relaxed);
+        stats.batches = batches_.load(std::memory_order_relaxed);
+        stats.parks = parks_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+private:
+    static constexpr std::size_t kMask = kCapacity - 1;
+    static constexpr std::size_t kHeaderBytes = sizeof(std::atomic<std::size_t>) + sizeof(std::uint32_t);
+    static constexpr std::size_t kMaxRecordBytes = kSlotBytes - kHeaderBytes - 4;
+    static constexpr std::size_t kBatchBytes = 64 * 1024;
+    static_assert((kCapacity & kMask) == 0, "kCapacity must be a power of two");
+
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> seq;
+        std::uint32_t len;
+        char data[kMaxRecordBytes];
+    };
+
+    AsyncLogger() : slots_(new Slot[kCapacity]), batch_(new char[kBatchBytes]) {
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        worker_ = std::thread([this] { Run(); });
+    }
+
+    ~AsyncLogger() {
+        running_.store(false, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+        wake_.notify_one();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    // 后台线程：批量取出记录并写出；空闲时先让出 CPU 若干轮，仍没有新记录就挂起
+    void Run() {
+        std::size_t pos = 0;
+        int idle_rounds = 0;
+        for (;;) {
+            bool stopping = !running_.load(std::memory_order_acquire);
+            std::size_t used = 0;
+            std::size_t taken = 0;
+            ReportDropped(used);  // 先写提示，批量缓冲区为空时一定放得下
+            for (;;) {
+                Slot& slot = slots_[pos & kMask];
+                if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+                    break;
+                }
+                if (used + slot.len > kBatchBytes) {
+                    break;
+                }
+                std::memcpy(batch_.get() + used, slot.data, slot.len);
+                used += slot.len;
+                slot.seq.store(pos + kCapacity, std::memory_order_release);
+                ++pos;
+                ++taken;
+            }
+
+            if (used > 0) {
+                WriteAll(batch_.get(), used);
+                batches_.fetch_add(1, std::memory_order_relaxed);
+                written_.fetch_add(taken, std::memory_order_relaxed);
+            }
+            flushed_pos_.store(pos, std::memory_order_release);
+            flushed_dropped_.store(reported_dropped_, std::memory_order_release);
+
+            if (taken > 0) {
+                idle_rounds = 0;
+                continue;
+            }
+            if (stopping) {
+                break;
+            }
+            ++idle_rounds;
+            if (idle_rounds < 64) {
+                std::this_thread::yield();
+            } else {
+                Park(pos);
+                idle_rounds = 0;
+            }
+        }
+    }
+
+    // 挂起后台线程，直到生产者提交新记录、丢弃计数增加或析构。pos 是下一个要读取的位置
+    void Park(std::size_t pos) {
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        sleeping_.store(true, std::memory_order_seq_cst);
+        // 声明挂起之后再检查一次：这期间申请到槽位或计入丢弃的生产者一定会看到 sleeping_ 并唤醒
+        if (enqueue_pos_.load(std::memory_order_seq_cst) != pos ||
+            dropped_.load(std::memory_order_seq_cst) != reported_dropped_ ||
+            !running_.load(std::memory_order_seq_cst)) {
+            sleeping_.store(false, std::memory_order_relaxed);
+            return;
+        }
+        parks_.fetch_add(1, std::memory_order_relaxed);
+        wake_.wait(lock, [this] { return !sleeping_.load(std::memory_order_relaxed); });
+    }
+
+    // 只有把 sleeping_ 从 true 改为 false 的线程去通知；先取一次锁，
+    // 保证后台线程已经在 wait 中（它从声明挂起到开始等待一直持有锁），通知不会丢失
+    void Wake() {
+        if (sleeping_.exchange(false, std::memory_order_seq_cst)) {
+            { std::lock_guard<std::mutex> lock(park_mutex_); }
+            wake_.notify_one();
+        }
+    }
+
+    // kCount 策略：把新增的丢弃数作为一行提示写到批量缓冲区开头
+    void ReportDropped(std::size_t& used) {
+        std::uint64_t dropped = dropped_.load(std::memory_order_acquire);
+        if (dropped == reported_dropped_) {
+            return;
+        }
+        std::string note = "[AsyncLogger] dropped " + std::to_string(dropped - reported_dropped_) +
+                           " messages\n";
+        std::memcpy(batch_.get() + used, note.data(), note.size());
+        used += note.size();
+        reported_dropped_ = dropped;
+    }
+
+    void WriteAll(const char* data, std::size_t size) {
+        int fd = fd_.load(std::memory_order_relaxed);
+        while (size > 0) {
+#if defined(_WIN32)
+            int n = _write(fd, data, static_cast<unsigned>(size));
+#else
+            ssize_t n = ::write(fd, data, size);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            if (n <= 0) {
+                return;  // 输出端不可写时放弃本批，避免后台线程卡死
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<char[]> batch_;
+    std::thread worker_;
+
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> flushed_pos_{0};
+    alignas(64) std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> batches_{0};
+    std::atomic<std::uint64_t> flushed_dropped_{0};  // 已写出提示的丢弃数，供 Flush() 等待
+    std::uint64_t reported_dropped_ = 0;  // 仅后台线程访问
+    std::atomic<OverflowPolicy> policy_{OverflowPolicy::kBlock};
+    std::atomic<int> fd_{1};
+    std::atomic<bool> running_{true};
+
+    alignas(64) std::atomic<bool> sleeping_{false};  // 后台线程已挂起（或正要挂起）
+    std::atomic<std::uint64_t> parks_{0};
+    std::mutex park_mutex_;
+    std::condition_variable wake_;
+};
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ===========================
+// 可热更新的 RCU 单例 RcuSingleton<T, Tag>
+// ===========================
+// 场景：配置等“读极多、偶尔整体替换”的全局对象需要在负载下热更新。
+// AtomicSingleton 替换实例时读者要在 shared_mutex 上排队；这里采用 RCU（Read-Copy-Update）：
+//
+// - 读者：Read() 返回 ReadGuard，在 guard 存活期间看到的是一个不可变快照。
+//   进入时把当前全局纪元（epoch）写进本线程独占的读者记录（缓存行对齐），
+//   然后读取已发布的指针 —— 读路径上没有锁、没有共享的原子读改写，写者替换时读者也不会等待。
+// - 写者：Update() / Modify() 先原子地交换指针发布新版本，再把全局纪元 +1，
+//   旧版本连同“退休纪元”放入待回收列表。写者之间用互斥量串行。
+// - 宽限期回收：旧版本退休于纪元 R 时，只有纪元 <= R 的活跃读者可能还持有它；
+//   当所有读者记录都是空闲（0）或纪元 > R 时，宽限期结束，旧版本被 delete。
+//   每次 Update() 都会顺带尝试回收；Synchronize() 等待所有已退休版本回收完毕。
+//
+// 注意：
+// 1）ReadGuard 只能在创建它的线程内使用，不要跨线程传递，也不要长期持有（会阻止回收）；
+// 2）不要在持有 ReadGuard 时调用 Synchronize()（会等待自己，造成死锁）；
+// 3）同一线程可以嵌套 Read()，只有最外层 guard 会发布/清除纪元。
+template <typename T, typename Tag = void>
+class RcuSingleton {
+    struct alignas(64) ReaderRecord {
+        std::atomic<std::uint64_t> epoch{0};  // 0 表示当前不在读临界区
+        std::atomic<bool> in_use{false};
+        ReaderRecord* next = nullptr;
+    };
+
+public:
+    // 读快照：存活期间指向的对象不会被回收
+    class ReadGuard {
+    public:
+        const T& operator*() const { return *ptr_; }
+        const T* operator->() const { return ptr_; }
+        const T* get() const { return ptr_; }
+
+        ~ReadGuard() { owner_->ExitRead(); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        friend class RcuSingleton;
+        ReadGuard(const RcuSingleton* owner, const T* ptr) : owner_(owner), ptr_(ptr) {}
+
+        const RcuSingleton* owner_;
+        const T* ptr_;
+    };
+
+    static RcuSingleton& Instance() {
+        static RcuSingleton instance;
+        return instance;
+    }
+
+    ReadGuard Read() const {
+        EnterRead();
+        return ReadGuard(this, current_.load(std::memory_order_seq_cst));
+    }
+
+    // 发布新版本；旧版本在宽限期结束后回收
+    void Update(std::unique_ptr<T> next) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        PublishLocked(next.release());
+    }
+
+    // 拷贝当前版本，调用 fn(T&) 修改后作为新版本发布
+    template <typename F>
+    void Modify(F&& fn) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        auto copy = std::make_unique<T>(*current_.load(std::memory_order_relaxed));
+        std::forward<F>(fn)(*copy);
+        PublishLocked(copy.release());
+    }
+
+    // 等待所有已退休的旧版本被回收
+    void Synchronize() {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(writer_mutex_);
+                ReclaimLocked();
+                if (retired_.empty()) {
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // 尚未回收的旧版本数量
+    std::size_t PendingReclaim() const {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        return retired_.size();
+    }
+
+    // 已发布的版本号（每次 Update/Modify 加一）
+    std::uint64_t Version() const { return epoch_.load(std::memory_order_acquire) - 1; }
+
+    RcuSingleton(const RcuSingleton&) = delete;
+    RcuSingleton& operator=(const RcuSingleton&) = delete;
+
+private:
+    struct Retired {
+        T* ptr;
+        std::uint64_t epoch;
+    };
+
+    // 线程局部状态：本线程的读者记录与嵌套深度；线程退出时归还记录
+    struct LocalState {
+        ReaderRecord* record = nullptr;
+        unsigned nesting = 0;
+
+        ~LocalState() {
+            if (record != nullptr) {
+                record->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    RcuSingleton() : current_(new T()) {}
+
+    ~RcuSingleton() {
+        delete current_.load(std::memory_order_relaxed);
+        for (auto& r : retired_) {
+            delete r.ptr;
+        }
+        ReaderRecord* rec = readers_.load(std::memory_order_relaxed);
+        while (rec != nullptr) {
+            ReaderRecord* next = rec->next;
+            delete rec;
+            rec = next;
+        }
+    }
+
+    static LocalState& Local() {
+        thread_local LocalState state;
+        return state;
+    }
+
+    void EnterRead() const {
+        LocalState& local = Local();
+        if (local.nesting++ > 0) {
+            return;
+        }
+        if (local.record == nullptr) {
+            local.record = AcquireRecord();
+        }
+        // seq_cst 存储保证：写者扫描时要么看到本记录的纪元，要么本线程随后读到的一定是新指针
+        local.record->epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+    }
+
+    void ExitRead() const {
+        LocalState& local = Local();
+        if (--local.nesting == 0) {
+            local.record->epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    // 复用已退出线程留下的空闲记录，否则新建一条挂到无锁链表头部（每个线程只发生一次）
+    ReaderRecord* AcquireRecord() const {
+        for (ReaderRecord* rec = readers_.load(std::memory_order_acquire); rec != nullptr;
+             rec = rec->next) {
+            bool expected = false;
+            if (!rec->in_use.load(std::memory_order_relaxed) &&
+                rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                return rec;
+            }
+        }
+        auto* rec = new ReaderRecord();
+        rec->in_use.store(true, std::memory_order_relaxed);
+        ReaderRecord* head = readers_.load(std::memory_order_relaxed);
+        do {
+            rec->next = head;
+        } while (!readers_.compare_exchange_weak(head, rec, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        return rec;
+    }
+
+    void PublishLocked(T* next) {
+        T* old = current_.exchange(next, std::memory_order_seq_cst);
+        std::uint64_t retire_epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+        retired_.push_back(Retired{old, retire_epoch});
+        ReclaimLocked();
+    }
+
+    // 回收所有退休纪元小于最小活跃读者纪元的旧版本
+    void ReclaimLocked() {
+        if (retired_.empty()) {
+            return;
+        }
+        std::uint64_t min_active = UINT64_MAX;
+        for (ReaderRecord* rec = readers_.load(std::memory_order_acquire); rec != nullptr;
+             rec = rec->next) {
+            std::uint64_t e = rec->epoch.load(std::memory_order_seq_cst);
+            if (e != 0 && e < min_active) {
+                min_active = e;
+            }
+        }
+        std::size_t kept = 0;
+        for (auto& r : retired_) {
+            if (r.epoch < min_active) {
+                delete r.ptr;
+            } else {
+                retired_[kept++] = r;
+            }
+        }
+        retired_.resize(kept);
+    }
+
+    alignas(64) std::atomic<T*> current_;
+    alignas(64) std::atomic<std::uint64_t> epoch_{1};
+    mutable std::atomic<ReaderRecord*> readers_{nullptr};
+    mutable std::mutex writer_mutex_;
+    std::vector<Retired> retired_;
+};
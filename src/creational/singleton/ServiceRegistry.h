@@ -0,0 +1,387 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ===========================
+// 按依赖并行启动的单例服务注册表 ServiceRegistry
+// ===========================
+// 问题：大量饿汉式单例（HungrySingleton 风格）在静态初始化阶段一个接一个地构造，
+// 启动时间等于所有服务初始化时间之和，而且构造顺序由链接顺序决定、无法表达依赖。
+//
+// 做法：
+// 1）每个服务以名字注册，声明它依赖的服务名和一个工厂函数；
+// 2）Start() 先校验依赖图（未知依赖、环），校验失败时在报告中返回错误，不构造任何服务，
+//    注册表保持未启动状态：可以补充注册后再次 Start()；
+// 3）校验通过后按拓扑顺序调度：入度为 0 的服务进入就绪队列，线程池中的工作线程并发构造，
+//    一个服务构造完成后把其下游的入度减一，减到 0 的下游进入就绪队列；
+// 4）记录每个服务的开始/结束时间与所在线程，并在依赖图上按初始化耗时求最长路径（关键路径）——
+//    关键路径之和就是再多线程也无法突破的启动时间下限。
+//
+// 工厂函数在自己的依赖全部构造完成之后才会被调用，可以通过 Get<T>() 取得依赖：
+//
+//   ServiceRegistry& services = ServiceRegistry::Instance();
+//   services.Register<Database>("db", {}, [](ServiceRegistry&) { return std::make_unique<Database>(); });
+//   services.Register<UserCache>("cache", {"db"}, [](ServiceRegistry& r) {
+//       return std::make_unique<UserCache>(*r.Get<Database>("db"));
+//   });
+//   StartupReport report = services.Start();
+//   std::cout << report.ToString();
+//
+// 注意：
+// 1）工厂函数抛出异常时，该服务及其所有下游都不会构造，错误写入报告；
+// 2）Get<T>() 对未注册、尚未构造完成或类型不符的服务返回 nullptr；
+//    它不加锁，只应在工厂函数中或 Start() 返回之后调用，不要与 Register() 并发；
+// 3）通过校验的 Start() 只执行一次（之后不能再注册，再次 Start() 返回错误，
+//    即使有工厂函数失败也不会重试）；服务实例的生命周期与注册表相同。
+
+// 单个服务的初始化记录（时间相对于 Start() 开始时刻，单位毫秒）
+struct ServiceTiming {
+    std::string name;
+    double start_ms = 0.0;
+    double end_ms = 0.0;
+    double init_ms = 0.0;
+    unsigned worker = 0;            // 执行构造的工作线程编号
+    bool constructed = false;       // 因依赖失败被跳过的服务为 false
+    bool on_critical_path = false;
+};
+
+// 启动报告
+struct StartupReport {
+    bool ok = false;
+    std::string error;                       // ok 为 false 时的错误描述
+    unsigned threads = 0;
+    double wall_ms = 0.0;                    // 实际启动耗时
+    double total_init_ms = 0.0;              // 所有服务初始化耗时之和（串行启动所需时间）
+    double critical_path_ms = 0.0;           // 关键路径上的初始化耗时之和
+    std::vector<std::string> critical_path;  // 从最上游到最下游
+    std::vector<ServiceTiming> services;     // 按注册顺序
+
+    std::string ToString() const {
+        std::string out;
+        char line[256];
+        if (!ok) {
+            out += "startup failed: " + error + "\n";
+        }
+        std::snprintf(line, sizeof(line),
+                      "startup: %.2f ms wall on %u threads, %.2f ms total init, "
+                      "critical path %.2f ms\n",
+                      wall_ms, threads, total_init_ms, critical_path_ms);
+        out += line;
+        for (const auto& s : services) {
+            if (!s.constructed) {
+                std::snprintf(line, sizeof(line), "  %-24s skipped\n", s.name.c_str());
+            } else {
+                std::snprintf(line, sizeof(line), "  %-24s %9.2f -> %9.2f ms (%8.2f ms) worker %u%s\n",
+                              s.name.c_str(), s.start_ms, s.end_ms, s.init_ms, s.worker,
+                              s.on_critical_path ? "  *" : "");
+            }
+            out += line;
+        }
+        if (!critical_path.empty()) {
+            out += "critical path:";
+            for (std::size_t i = 0; i < critical_path.size(); ++i) {
+                out += (i == 0 ? " " : " -> ") + critical_path[i];
+            }
+            out += "\n";
+        }
+        return out;
+    }
+};
+
+class ServiceRegistry {
+public:
+    template <typename T>
+    using Factory = std::function<std::unique_ptr<T>(ServiceRegistry&)>;
+
+    // 全局注册表；也可以直接构造独立的 ServiceRegistry（例如在测试中）
+    static ServiceRegistry& Instance() {
+        static ServiceRegistry instance;
+        return instance;
+    }
+
+    ServiceRegistry() = default;
+    ServiceRegistry(const ServiceRegistry&) = delete;
+    ServiceRegistry& operator=(const ServiceRegistry&) = delete;
+
+    // 注册服务；名字重复或已经启动时返回 false
+    template <typename T>
+    bool Register(const std::string& name, std::vector<std::string> deps, Factory<T> factory) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (started_ || index_.count(name) != 0) {
+            return false;
+        }
+        auto node = std::make_unique<Node>();
+        node->name = name;
+        node->deps = std::move(deps);
+        node->type = &typeid(T);
+        node->factory = [factory = std::move(factory)](ServiceRegistry& registry) {
+            std::unique_ptr<T> p = factory(registry);
+            return std::shared_ptr<void>(std::move(p));
+        };
+        index_.emplace(name, nodes_.size());
+        nodes_.push_back(std::move(node));
+        return true;
+    }
+
+    // 取得已构造完成的服务
+    template <typename T>
+    T* Get(const std::string& name) const {
+        auto it = index_.find(name);
+        if (it == index_.end()) {
+            return nullptr;
+        }
+        const Node& node = *nodes_[it->second];
+        if (!node.ready.load(std::memory_order_acquire) || *node.type != typeid(T)) {
+            return nullptr;
+        }
+        return static_cast<T*>(node.instance.get());
+    }
+
+    std::size_t Size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return nodes_.size();
+    }
+
+    // 校验依赖图并用 threads 个工作线程并发构造所有服务（threads 为 0 时取硬件线程数）
+    StartupReport Start(unsigned threads = 0) {
+        StartupReport report;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        report.threads = threads;
+        std::vector<std::size_t> order;
+        {
+            // 校验期间持锁，Register() 与并发的 Start() 等待校验结束
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (started_) {
+                report.error = "registry already started";
+                return report;
+            }
+            for (const auto& node : nodes_) {
+                ServiceTiming timing;
+                timing.name = node->name;
+                report.services.push_back(timing);
+            }
+            if (!BuildGraph(report.error) || !TopologicalOrder(order, report.error)) {
+                return report;  // 未启动：可以补充注册后重试
+            }
+            started_ = true;
+        }
+        Run(threads, report);
+        ComputeCriticalPath(order, report);
+        return report;
+    }
+
+private:
+    struct Node {
+        std::string name;
+        std::vector<std::string> deps;
+        const std::type_info* type = nullptr;
+        std::function<std::shared_ptr<void>(ServiceRegistry&)> factory;
+
+        std::vector<std::size_t> dep_ids;
+        std::vector<std::size_t> dependents;
+        std::size_t pending = 0;  // 尚未构造完成的依赖数
+        bool failed = false;      // 自身或上游构造失败
+        std::shared_ptr<void> instance;
+        std::atomic<bool> ready{false};
+    };
+
+    // 把依赖名解析为下标，并建立“依赖 -> 下游”的反向边
+    // 每次重新建立（上一次校验失败时可能只建立了一部分）
+    bool BuildGraph(std::string& error) {
+        for (auto& node : nodes_) {
+            node->dep_ids.clear();
+            node->dependents.clear();
+        }
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            Node& node = *nodes_[i];
+            for (const auto& dep : node.deps) {
+                auto it = index_.find(dep);
+                if (it == index_.end()) {
+                    error = "service '" + node.name + "' depends on unknown service '" + dep + "'";
+                    return false;
+                }
+                node.dep_ids.push_back(it->second);
+                nodes_[it->second]->dependents.push_back(i);
+            }
+            node.pending = node.dep_ids.size();
+        }
+        return true;
+    }
+
+    // Kahn 算法：无法排序的剩余节点说明存在环
+    bool TopologicalOrder(std::vector<std::size_t>& order, std::string& error) const {
+        std::vector<std::size_t> indegree(nodes_.size());
+        std::vector<std::size_t> queue;
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            indegree[i] = nodes_[i]->dep_ids.size();
+            if (indegree[i] == 0) {
+                queue.push_back(i);
+            }
+        }
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            order.push_back(queue[head]);
+            for (std::size_t next : nodes_[queue[head]]->dependents) {
+                if (--indegree[next] == 0) {
+                    queue.push_back(next);
+                }
+            }
+        }
+        if (order.size() == nodes_.size()) {
+            return true;
+        }
+        error = "dependency cycle among services:";
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            if (indegree[i] != 0) {
+                error += " '" + nodes_[i]->name + "'";
+            }
+        }
+        return false;
+    }
+
+    // 调度：就绪队列 + 工作线程；一个服务完成后释放其下游
+    void Run(unsigned threads, StartupReport& report) {
+        using Clock = std::chrono::steady_clock;
+        std::mutex queue_mutex;
+        std::condition_variable cv;
+        std::deque<std::size_t> ready;
+        std::size_t remaining = nodes_.size();
+        std::string first_error;
+
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i]->pending == 0) {
+                ready.push_back(i);
+            }
+        }
+
+        const auto start = Clock::now();
+        auto ms_since_start = [start](Clock::time_point t) {
+            return std::chrono::duration<double, std::milli>(t - start).count();
+        };
+
+        auto worker = [&](unsigned worker_id) {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            for (;;) {
+                cv.wait(lock, [&] { return !ready.empty() || remaining == 0; });
+                if (ready.empty()) {
+                    return;
+                }
+                std::size_t id = ready.front();
+                ready.pop_front();
+                Node& node = *nodes_[id];
+                ServiceTiming& timing = report.services[id];
+
+                if (!node.failed) {
+                    lock.unlock();
+                    auto t0 = Clock::now();
+                    std::string error;
+                    try {
+                        node.instance = node.factory(*this);
+                        if (node.instance == nullptr) {
+                            error = "service '" + node.name + "' factory returned null";
+                        }
+                    } catch (const std::exception& e) {
+                        error = "service '" + node.name + "' threw: " + e.what();
+                    } catch (...) {
+                        error = "service '" + node.name + "' threw an unknown exception";
+                    }
+                    auto t1 = Clock::now();
+                    lock.lock();
+
+                    timing.start_ms = ms_since_start(t0);
+                    timing.end_ms = ms_since_start(t1);
+                    timing.init_ms = timing.end_ms - timing.start_ms;
+                    timing.worker = worker_id;
+                    if (error.empty()) {
+                        timing.constructed = true;
+                        node.ready.store(true, std::memory_order_release);
+                    } else {
+                        node.failed = true;
+                        node.instance.reset();
+                        if (first_error.empty()) {
+                            first_error = error;
+                        }
+                    }
+                }
+
+                // 失败沿依赖边向下游传播：下游仍按拓扑顺序出队，但不会被构造
+                for (std::size_t next : node.dependents) {
+                    Node& dependent = *nodes_[next];
+                    dependent.failed = dependent.failed || node.failed;
+                    if (--dependent.pending == 0) {
+                        ready.push_back(next);
+                    }
+                }
+                if (--remaining == 0 || !ready.empty()) {
+                    cv.notify_all();
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) {
+            pool.emplace_back(worker, t);
+        }
+        worker(0);  // 调用 Start() 的线程也参与构造
+        for (auto& t : pool) {
+            t.join();
+        }
+
+        report.wall_ms = ms_since_start(Clock::now());
+        report.ok = first_error.empty();
+        report.error = first_error;
+    }
+
+    // 以初始化耗时为权重，在拓扑序上求最长路径
+    void ComputeCriticalPath(const std::vector<std::size_t>& order, StartupReport& report) const {
+        std::vector<double> finish(nodes_.size(), 0.0);
+        std::vector<std::size_t> prev(nodes_.size(), nodes_.size());
+        std::size_t last = nodes_.size();
+        for (std::size_t id : order) {
+            double best = 0.0;
+            for (std::size_t dep : nodes_[id]->dep_ids) {
+                if (prev[id] == nodes_.size() || finish[dep] > best) {
+                    best = finish[dep];
+                    prev[id] = dep;
+                }
+            }
+            finish[id] = best + report.services[id].init_ms;
+            report.total_init_ms += report.services[id].init_ms;
+            if (last == nodes_.size() || finish[id] > finish[last]) {
+                last = id;
+            }
+        }
+        if (last == nodes_.size()) {
+            return;
+        }
+        report.critical_path_ms = finish[last];
+        std::vector<std::string> path;
+        for (std::size_t id = last; id != nodes_.size(); id = prev[id]) {
+            report.services[id].on_critical_path = true;
+            path.push_back(nodes_[id]->name);
+        }
+        report.critical_path.assign(path.rbegin(), path.rend());
+    }
+
+    mutable std::mutex mutex_;
+    bool started_ = false;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::unordered_map<std::string, std::size_t> index_;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// ===========================
+// 分片单例 ShardedSingleton<T, Reducer, Tag>
+// ===========================
+// 问题：用单例保存全局计数器/统计值时，所有写线程都在同一条缓存行上做原子操作，
+// 缓存行在核之间来回“乒乓”，写吞吐随线程数增加反而下降。
+//
+// 做法：
+// 1）实例内部持有 S 个按缓存行对齐的副本（分片），S = 不小于硬件线程数的 2 的幂；
+// 2）每个线程首次写入时分配一个固定的分片编号（轮询分配），之后只写自己的分片，
+//    线程数不超过 S 时每个分片只有一个写者，原子操作不会跨核争抢；
+// 3）读取时用 Reducer 把所有分片合并（求和 / 最小值 / 最大值 / 自定义），
+//    读比写贵（需要扫描 S 条缓存行），适合“写多读少”的统计场景。
+//
+// Reducer 需要提供：
+//   static T Identity();          // 单位元：合并的初始值，也是 Reset() 后的值
+//   T operator()(T a, T b) const;  // 满足结合律与交换律的合并操作
+//
+// 用 Tag 区分同一类型的多个独立单例，例如：
+//   struct RequestsTag {};
+//   ShardedSingleton<std::uint64_t, SumReducer<std::uint64_t>, RequestsTag>::Instance().Update(1);
+//
+// 注意：分片之间没有同步，Read() 得到的是各分片在扫描时刻的值，并发写入时不是原子快照。
+
+template <typename T>
+struct SumReducer {
+    static constexpr T Identity() { return T{}; }
+    constexpr T operator()(T a, T b) const { return a + b; }
+};
+
+template <typename T>
+struct MinReducer {
+    static constexpr T Identity() { return std::numeric_limits<T>::max(); }
+    constexpr T operator()(T a, T b) const { return b < a ? b : a; }
+};
+
+template <typename T>
+struct MaxReducer {
+    static constexpr T Identity() { return std::numeric_limits<T>::lowest(); }
+    constexpr T operator()(T a, T b) const { return a < b ? b : a; }
+};
+
+// 当前线程的分片编号（所有 ShardedSingleton 共用一个轮询序号）
+inline std::size_t ThisThreadShardIndex() {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+template <typename T, typename Reducer = SumReducer<T>, typename Tag = void>
+class ShardedSingleton {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ShardedSingleton stores T in std::atomic and requires a trivially copyable T");
+
+public:
+    static ShardedSingleton& Instance() {
+        static ShardedSingleton instance;
+        return instance;
+    }
+
+    // 把 value 合并进当前线程的分片
+    void Update(T value) {
+        std::atomic<T>& shard = shards_[ThisThreadShardIndex() & mask_].value;
+        if constexpr (std::is_integral<T>::value && std::is_same<Reducer, SumReducer<T>>::value) {
+            shard.fetch_add(value, std::memory_order_relaxed);
+        } else {
+            T current = shard.load(std::memory_order_relaxed);
+            while (!shard.compare_exchange_weak(current, reducer_(current, value),
+                                                std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    // 合并所有分片
+    T Read() const {
+        T result = Reducer::Identity();
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            result = reducer_(result, shards_[i].value.load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+    // 所有分片恢复为单位元
+    void Reset() {
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            shards_[i].value.store(Reducer::Identity(), std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t ShardCount() const { return shard_count_; }
+
+    ShardedSingleton(const ShardedSingleton&) = delete;
+    ShardedSingleton& operator=(const ShardedSingleton&) = delete;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<T> value;
+    };
+
+    ShardedSingleton() : shard_count_(ShardCountFor(std::thread::hardware_concurrency())) {
+        mask_ = shard_count_ - 1;
+        shards_.reset(new Shard[shard_count_]);
+        Reset();
+    }
+
+    static std::size_t ShardCountFor(unsigned hardware_threads) {
+        std::size_t count = 1;
+        while (count < std::max(1u, hardware_threads)) {
+            count <<= 1;
+        }
+        return count;
+    }
+
+    const std::size_t shard_count_;
+    std::size_t mask_ = 0;
+    std::unique_ptr<Shard[]> shards_;
+    Reducer reducer_;
+};
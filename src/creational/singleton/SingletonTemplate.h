@@ -0,0 +1,288 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+// ===========================
+// 通用单例模板 Singleton<T, InitPolicy, LifetimePolicy>
+// ===========================
+// Singletons.h 中每个类都重复了同一套样板代码（私有构造、删除拷贝、静态实例、Instance()），
+// 差别只在“如何保证只初始化一次”。本文件把这两个维度拆成编译期策略：
+//
+// - InitPolicy（初始化策略，决定 Instance() 的热路径）：
+//   1）MeyersInit   ：函数内局部静态变量（magic static），热路径 = guard 字节检查 + 一次读取
+//   2）CallOnceInit ：std::call_once 保证只创建一次，热路径 = 一次 acquire 读取已发布的指针
+//   3）DCLInit      ：双重检查锁定，热路径 = 一次 acquire 读取（x86 上就是普通 mov）
+//   4）EagerInit    ：常量初始化的静态对象（C++20 下加 constinit），热路径 = 取地址，无任何检查；
+//                     编译期拒绝无法常量初始化的类型
+//   5）WeakRefInit  ：弱引用计数，无人使用时销毁、按需重建，返回 std::shared_ptr<T>；
+//                     读路径使用与 AtomicSingleton 相同的线程租约
+//
+// - LifetimePolicy（生命周期策略，决定实例何时销毁）：
+//   1）LeakyLifetime         ：永不销毁，彻底规避静态析构顺序问题（默认）
+//   2）DestroyAtExitLifetime ：通过 std::atexit 在程序退出时销毁
+//   EagerInit 的实例是静态对象、WeakRefInit 的实例随引用计数销毁，二者忽略生命周期策略。
+//
+// - Singleton<T, ...>::CachedInstance()：可选的线程局部缓存指针，
+//   在紧密循环中反复调用时连 guard 检查都省掉（只剩一次线程局部读取）。
+//
+// 被管理的类型 T 只需把构造函数设为私有并声明 `friend class SingletonAccess;`
+//（T 定义在命名空间内时要写 `friend class ::SingletonAccess;`，否则会声明出同名的新类）：
+//
+//   class Config {
+//       friend class SingletonAccess;
+//       Config() = default;
+//   public:
+//       int timeout_ms = 100;
+//   };
+//   using ConfigSingleton = Singleton<Config, DCLInit>;
+//   ConfigSingleton::Instance().timeout_ms = 200;
+//
+// 与 Singletons.h 中手写类的对应关系：
+//   LazySingletonDCL      ≈ Singleton<T, DCLInit>
+//   LazySingletonCallOnce ≈ Singleton<T, CallOnceInit>
+//   MeyersSingleton       ≈ Singleton<T, MeyersInit, DestroyAtExitLifetime>
+//   HungrySingleton       ≈ Singleton<T, EagerInit>（且没有静态初始化顺序问题）
+//   AtomicSingleton       ≈ Singleton<T, WeakRefInit>
+// 手写类保留在 Singletons.h 中，用于逐行对比各种机制；新代码应直接使用本模板。
+
+// 统一的构造/析构入口：T 只需要把它声明为友元
+class SingletonAccess {
+public:
+    template <typename T>
+    static T* New() {
+        return new T();
+    }
+
+    template <typename T>
+    static void Delete(T* p) {
+        delete p;
+    }
+
+    // 返回纯右值，C++17 保证拷贝消除，因此 T 不需要可拷贝/可移动
+    template <typename T>
+    static constexpr T Make() {
+        return T();
+    }
+};
+
+// 编译期检查：T 能否在常量表达式中默认构造（constexpr 构造函数 + 平凡析构）
+template <typename T, typename = void>
+struct IsConstantInitializable : std::false_type {};
+
+template <typename T>
+struct IsConstantInitializable<
+    T, std::void_t<std::integral_constant<bool, (SingletonAccess::Make<T>(), true)>>>
+    : std::true_type {};
+
+#if defined(__cpp_constinit)
+#define SINGLETON_CONSTINIT constinit
+#else
+#define SINGLETON_CONSTINIT
+#endif
+
+// ---------------------------
+// 生命周期策略
+// ---------------------------
+
+// 永不销毁：实例在整个进程期间有效，退出时由操作系统回收
+struct LeakyLifetime {
+    template <typename T>
+    static T* Create() {
+        return SingletonAccess::New<T>();
+    }
+};
+
+// 程序退出时销毁：每个 T 注册一个 atexit 回调
+struct DestroyAtExitLifetime {
+    template <typename T>
+    static T* Create() {
+        T* p = SingletonAccess::New<T>();
+        Slot<T>() = p;
+        std::atexit(&Destroy<T>);
+        return p;
+    }
+
+private:
+    template <typename T>
+    static T*& Slot() {
+        static T* instance = nullptr;  // 常量初始化，没有 guard
+        return instance;
+    }
+
+    template <typename T>
+    static void Destroy() {
+        SingletonAccess::Delete(Slot<T>());
+        Slot<T>() = nullptr;
+    }
+};
+
+// ---------------------------
+// 初始化策略
+// ---------------------------
+
+// Meyers：函数内局部静态变量，编译器生成线程安全的 guard
+template <typename T, typename Lifetime>
+struct MeyersInit {
+    static T& Get() {
+        static T* const instance = Lifetime::template Create<T>();
+        return *instance;
+    }
+};
+
+// call_once：创建过程交给 std::call_once，完成后发布指针，热路径只读指针
+template <typename T, typename Lifetime>
+struct CallOnceInit {
+    static T& Get() {
+        T* p = instance_.load(std::memory_order_acquire);
+        if (p == nullptr) {
+            std::call_once(flag_, [] {
+                instance_.store(Lifetime::template Create<T>(), std::memory_order_release);
+            });
+            p = instance_.load(std::memory_order_acquire);
+        }
+        return *p;
+    }
+
+private:
+    inline static std::atomic<T*> instance_{nullptr};
+    inline static std::once_flag flag_;
+};
+
+// DCL：acquire 读取 + 互斥量保护的二次检查
+template <typename T, typename Lifetime>
+struct DCLInit {
+    static T& Get() {
+        T* p = instance_.load(std::memory_order_acquire);
+        if (p == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            p = instance_.load(std::memory_order_relaxed);
+            if (p == nullptr) {
+                p = Lifetime::template Create<T>();
+                instance_.store(p, std::memory_order_release);
+            }
+        }
+        return *p;
+    }
+
+private:
+    inline static std::atomic<T*> instance_{nullptr};
+    inline static std::mutex mutex_;
+};
+
+// 常量初始化的饿汉式：实例在编译期确定、存放在 .data/.bss 中，
+// 不参与动态初始化，因此不存在静态初始化顺序问题，Instance() 就是取地址
+template <typename T, typename Lifetime>
+struct EagerInit {
+    static_assert(IsConstantInitializable<T>::value,
+                  "EagerInit requires T to be constant-initializable "
+                  "(constexpr default constructor and trivial destructor)");
+
+    static T& Get() { return instance_; }
+
+private:
+    SINGLETON_CONSTINIT inline static T instance_ = SingletonAccess::Make<T>();
+};
+
+// 弱引用计数 + 线程租约，返回 std::shared_ptr<T>；原理见 Singletons.h 中 AtomicSingleton 的说明，
+// AtomicSingleton 也直接使用本策略。Lifetime 不参与：实例寿命由引用计数决定
+template <typename T, typename Lifetime>
+struct WeakRefInit {
+    static std::shared_ptr<T> Get() {
+        // 快速路径：只操作线程私有的租约控制块
+        LocalState& local = Local();
+        if (std::shared_ptr<T> tmp = local.lease.lock()) {
+            local.reused = true;
+            return tmp;
+        }
+        return AcquireSlow(local);
+    }
+
+    static bool Alive() {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return !instance_.expired();
+    }
+
+private:
+    // 线程租约：持有实例的一份强引用，返回给调用者的 shared_ptr 共享租约的控制块
+    struct Lease {
+        std::shared_ptr<T> instance;
+    };
+
+    // 上一份租约没有被复用过时，接下来的慢速路径中每隔多少次才再试着建一次租约
+    static constexpr unsigned kLeaseRetryInterval = 64;
+
+    // 线程局部缓存：指向本线程租约控制块的 aliasing weak_ptr，以及租约是否派上过用场
+    struct LocalState {
+        std::weak_ptr<T> lease;
+        bool reused = true;    // 当前租约是否经快速路径复用过（首次调用总是建租约）
+        unsigned skipped = 0;  // 连续跳过建租约的次数
+    };
+
+    static LocalState& Local() {
+        thread_local LocalState local;
+        return local;
+    }
+
+    static std::shared_ptr<T> AcquireSlow(LocalState& local) {
+        std::shared_ptr<T> strong;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            strong = instance_.lock();
+        }
+        if (strong == nullptr) {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            strong = instance_.lock();
+            if (strong == nullptr) {
+                strong = std::shared_ptr<T>(SingletonAccess::New<T>(),
+                                            [](T* p) { SingletonAccess::Delete(p); });
+                instance_ = strong;
+            }
+        }
+        // 自适应：上一份租约从未被复用（调用方取用后立即丢弃），说明本线程是 one-shot 调用方式，
+        // 建租约（分配控制块 + 额外的引用计数操作）纯属额外开销，直接返回全局强引用，
+        // 开销与不带租约的实现相同；每隔 kLeaseRetryInterval 次再试一次，调用方式变了还能切回来
+        if (!local.reused && ++local.skipped < kLeaseRetryInterval) {
+            return strong;
+        }
+        local.reused = false;
+        local.skipped = 0;
+        auto lease = std::make_shared<Lease>(Lease{std::move(strong)});
+        std::shared_ptr<T> tmp(lease, lease->instance.get());
+        local.lease = tmp;
+        return tmp;
+    }
+
+    inline static std::weak_ptr<T> instance_;
+    inline static std::shared_mutex mutex_;
+};
+
+// ---------------------------
+// 单例模板本体
+// ---------------------------
+template <typename T, template <typename, typename> class InitPolicy = MeyersInit,
+          typename LifetimePolicy = LeakyLifetime>
+class Singleton {
+public:
+    using Policy = InitPolicy<T, LifetimePolicy>;
+
+    // 返回 T&（WeakRefInit 返回 std::shared_ptr<T>）
+    static decltype(auto) Instance() { return Policy::Get(); }
+
+    // 线程局部缓存的实例指针：首次调用走策略的热路径，之后只读取线程局部变量
+    static T& CachedInstance() {
+        static_assert(std::is_same<decltype(Policy::Get()), T&>::value,
+                      "CachedInstance() is only available for policies returning T&");
+        thread_local T* cached = nullptr;
+        if (cached == nullptr) {
+            cached = &Policy::Get();
+        }
+        return *cached;
+    }
+
+    Singleton() = delete;
+};
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <atomic>
 #include <memory>
 #include <shared_mutex>
 
+#include "AsyncLogger.h"
+#include "SingletonTemplate.h"
+
 // ===========================
 // 单例模式的多种典型实现
 // ===========================
@@ -17,9 +22,12 @@
 // 4）LazySingletonCallOnce   ：懒汉式，使用 std::call_once，线程安全（C++11+）
 // 5）HungrySingleton          ：饿汉式，程序启动时就创建实例，线程天然安全
 // 6）MeyersSingleton          ：C++11 推荐写法，函数内局部静态变量，线程安全
-// 7）AtomicSingleton          ：使用原子操作的高性能单例（C++11+）
+// 7）AtomicSingleton          ：弱引用单例，线程租约实现无共享竞争的读路径（C++11+）
+// 8）ConstinitSingleton       ：常量初始化单例，Instance() 只是取地址，没有 guard 也没有初始化顺序问题
 //
 // 所有类都使用中文注释详细说明其设计意图和实现要点，方便对比学习。
+// 各类的 Log() 默认同步写 std::cout，可通过 SetSingletonLogBackend(LogBackend::kAsync)
+// 切换到 AsyncLogger.h 中的异步无锁日志后端。
 //
 // ===========================
 // 线程安全与性能优化说明
@@ -40,6 +48,32 @@
 // C++20：std::atomic 改进，constinit 关键字
 // C++23：进一步优化原子操作性能
 
+// ===========================
+// 日志输出后端
+// ===========================
+// 各单例的 Log() 都通过 WriteSingletonLog() 输出：
+// - LogBackend::kStdout（默认）：std::cout + std::endl，同步输出、每条消息 flush 一次；
+// - LogBackend::kAsync        ：写入 AsyncLogger 的无锁环形缓冲区，由后台线程批量写出，
+//                               调用线程不再争抢流锁、也不做系统调用（输出顺序可能与 std::cout 交错）。
+enum class LogBackend { kStdout, kAsync };
+
+inline std::atomic<LogBackend>& SingletonLogBackend() {
+    static std::atomic<LogBackend> backend{LogBackend::kStdout};
+    return backend;
+}
+
+inline void SetSingletonLogBackend(LogBackend backend) {
+    SingletonLogBackend().store(backend, std::memory_order_relaxed);
+}
+
+inline void WriteSingletonLog(std::string_view prefix, const std::string& message) {
+    if (SingletonLogBackend().load(std::memory_order_relaxed) == LogBackend::kAsync) {
+        AsyncLogger::Instance().Log(prefix, message);
+        return;
+    }
+    std::cout << prefix << message << std::endl;
+}
+
 // 1. 懒汉式（不加锁）—— 多线程环境下不安全
 class LazySingletonUnsafe {
 public:
@@ -53,7 +87,7 @@ public:
     }
 
     void Log(const std::string& message) {
-        std::cout << "[LazyUnsafe] " << message << std::endl;
+        WriteSingletonLog("[LazyUnsafe] ", message);
     }
 
     // 禁止拷贝和赋值，防止产生多个实例
@@ -85,7 +119,7 @@ public:
     }
 
     void Log(const std::string& message) {
-        std::cout << "[LazyMutex] " << message << std::endl;
+        WriteSingletonLog("[LazyMutex] ", message);
     }
 
     LazySingletonMutex(const LazySingletonMutex&) = delete;
@@ -125,7 +159,7 @@ public:
     }
 
     void Log(const std::string& message) {
-        std::cout << "[LazyDCL] " << message << std::endl;
+        WriteSingletonLog("[LazyDCL] ", message);
     }
 
     LazySingletonDCL(const LazySingletonDCL&) = delete;
@@ -154,7 +188,7 @@ public:
     }
 
     void Log(const std::string& message) {
-        std::cout << "[LazyCallOnce] " << message << std::endl;
+        WriteSingletonLog("[LazyCallOnce] ", message);
     }
 
     LazySingletonCallOnce(const LazySingletonCallOnce&) = delete;
@@ -186,7 +220,7 @@ public:
     }
 
     void Log(const std::string& message) {
-        std::cout << "[Hungry] " << message << std::endl;
+        WriteSingletonLog("[Hungry] ", message);
     }
 
     HungrySingleton(const HungrySingleton&) = delete;
@@ -229,7 +263,7 @@ public:
     }
 
     void Log(const std::string& message) {
-        std::cout << "[Meyers] " << message << std::endl;
+        WriteSingletonLog("[Meyers] ", message);
     }
 
     MeyersSingleton(const MeyersSingleton&) = delete;
@@ -241,58 +275,89 @@ private:
 };
 
 // 7. 原子操作单例（高性能版本）
-// C++11+: 使用互斥量保护的原子操作单例
-// 优点：线程安全，性能较好
-// 注意：std::atomic<std::shared_ptr<T>> 在某些平台上可能不被支持，
-// 因为 shared_ptr 不是 trivially copyable 类型
+// 语义：实例由 weak_ptr 弱引用持有 —— 所有使用者都释放后实例自动销毁，下次访问时按需重建。
+// 读路径优化：每个线程持有一份“租约”（Lease），租约内部才真正持有实例的强引用。
+// - 快速路径：线程局部缓存的是借用租约控制块的 aliasing weak_ptr，一次 lock() 即得到返回值。
+//   所有原子读改写都落在本线程独占的租约控制块上，不会在线程之间来回争抢同一条缓存行，
+//   因此读路径随核数线性扩展（只要不把返回值交给别的线程释放，就不存在任何竞争）。
+// - 慢速路径：本线程没有有效租约（首次访问，或本线程拿到的引用已全部释放）时，
+//   在读写锁保护下从全局 weak_ptr 取得/重建实例，并为本线程创建新租约。
+// - 局限：租约只在本线程还持有引用时存活。“取用后立即丢弃”（Instance()->Log(...)）的调用方式
+//   留不住租约，每次调用都要走慢速路径、争抢全局控制块，无法随核数扩展。
+//   为了不比引入租约之前更慢，慢速路径发现上一份租约从未被复用时就不再建租约，直接返回
+//   全局强引用（开销与旧实现相同，见 bench_singleton 中的 1shot / base 两行）。
+//   想让租约跨调用存活就得推迟释放，那会让“无人使用时立即销毁”变成“稍后销毁”，因此没有这样做；
+//   需要可扩展读路径的线程应自己持有一份引用。
+// - 生命周期：线程局部缓存只保存租约的 weak_ptr，不会延长实例寿命；
+//   某线程的所有引用释放 → 租约销毁 → 释放一份全局强引用，全部线程都释放后实例销毁。
+// 注意：std::atomic<std::shared_ptr<T>> 在 C++20 之前不可用，且多数实现内部仍然带锁，
+// 因此这里没有使用它。
 class AtomicSingleton {
 public:
-    static std::shared_ptr<AtomicSingleton> Instance() {
-        // 使用互斥量保护的双重检查锁定模式
-        std::shared_ptr<AtomicSingleton> tmp = nullptr;
-        {
-            std::shared_lock<std::shared_mutex> lock(read_mutex_);
-            tmp = instance_.lock();  // 使用 weak_ptr::lock() 获取 shared_ptr
-        }
-        
-        if (tmp == nullptr) {
-            std::lock_guard<std::mutex> lock(write_mutex_);
-            tmp = instance_.lock();
-            if (tmp == nullptr) {
-                // 使用私有静态函数创建实例
-                tmp = CreateInstance();
-                instance_ = tmp;  // 存储为 weak_ptr
-            }
-        }
-        return tmp;
-    }
+    // 租约机制由 WeakRefInit（见 SingletonTemplate.h）实现，这里与 Singleton<T, WeakRefInit> 共用
+    static std::shared_ptr<AtomicSingleton> Instance() { return Policy::Get(); }
+
+    // 诊断用：当前是否存在存活的实例
+    static bool Alive() { return Policy::Alive(); }
 
     void Log(const std::string& message) {
-        std::cout << "[Atomic] " << message << std::endl;
+        WriteSingletonLog("[Atomic] ", message);
     }
 
     AtomicSingleton(const AtomicSingleton&) = delete;
     AtomicSingleton& operator=(const AtomicSingleton&) = delete;
 
 private:
+    friend class SingletonAccess;
+    using Policy = WeakRefInit<AtomicSingleton, LeakyLifetime>;
+
     // 私有构造函数和析构函数
     AtomicSingleton() { std::cout << "AtomicSingleton constructed" << std::endl; }
     ~AtomicSingleton() = default;
+};
 
-    // 私有静态函数，用于创建实例，使用默认删除器
-    static std::shared_ptr<AtomicSingleton> CreateInstance() {
-        return std::shared_ptr<AtomicSingleton>(new AtomicSingleton(), [](AtomicSingleton* p) { delete p; });
+// 8. 常量初始化单例（constinit / constexpr 构造）
+// 适用于能在编译期构造的类型：构造函数是 constexpr、析构函数是平凡的、成员都能常量初始化
+// （整数、指针、std::atomic、定长数组等）。
+// - 实例是常量初始化的静态对象：编译器直接把初始值写进 .data/.bss，不参与动态初始化，
+//   因此既没有 HungrySingleton 的静态初始化顺序问题，也没有 MeyersSingleton 每次调用的 guard 检查；
+// - Instance() 编译后就是一条取地址指令（x86-64 上为 lea rip 相对寻址），
+//   可以用 `cmake --build build --target disasm_singleton` 查看各实现的反汇编对比；
+// - 编译期检查：IsConstantInitializable<T>（见 SingletonTemplate.h）在编译期尝试常量构造一次，
+//   构造函数不是 constexpr 或析构函数不平凡时 static_assert 直接报错；
+//   C++20 下 SINGLETON_CONSTINIT 展开为 constinit，再由编译器对定义本身做一次同样的检查。
+// 代价：构造函数里不能做 I/O、分配内存等运行期操作（因此这里不打印 "constructed"），
+// 需要运行期状态时可以在首次使用时由成员函数按需设置。
+class ConstinitSingleton {
+public:
+    static ConstinitSingleton& Instance() { return instance_; }
+
+    void Log(const std::string& message) {
+        log_count_.fetch_add(1, std::memory_order_relaxed);
+        WriteSingletonLog("[Constinit] ", message);
     }
 
-    static std::weak_ptr<AtomicSingleton> instance_;  // 使用 weak_ptr 存储实例
-    static std::shared_mutex read_mutex_;             // 读取时使用的读写锁
-    static std::mutex write_mutex_;                   // 写入时使用的互斥量
+    // 已记录的日志条数（演示常量初始化的可变状态）
+    std::uint64_t LogCount() const { return log_count_.load(std::memory_order_relaxed); }
+
+    ConstinitSingleton(const ConstinitSingleton&) = delete;
+    ConstinitSingleton& operator=(const ConstinitSingleton&) = delete;
+
+private:
+    friend class SingletonAccess;
+    constexpr ConstinitSingleton() = default;
+
+    std::atomic<std::uint64_t> log_count_{0};
+
+    static ConstinitSingleton instance_;
 };
 
-// C++17: inline 简化定义
-inline std::weak_ptr<AtomicSingleton> AtomicSingleton::instance_;
-inline std::shared_mutex AtomicSingleton::read_mutex_;
-inline std::mutex AtomicSingleton::write_mutex_;
+static_assert(IsConstantInitializable<ConstinitSingleton>::value,
+              "ConstinitSingleton must be constant-initializable "
+              "(constexpr default constructor and trivial destructor)");
+
+// 常量初始化：没有动态初始化代码，也没有 guard 变量
+SINGLETON_CONSTINIT inline ConstinitSingleton ConstinitSingleton::instance_;
 
 /* C++20 版本可以使用 std::atomic<std::shared_ptr> 的特化：
 // C++20: std::atomic<std::shared_ptr> 提供了更好的性能
@@ -1,5 +1,27 @@
+#include "ServiceRegistry.h"
+#include "SingletonTemplate.h"
 #include "Singletons.h"
 
+#include <chrono>
+#include <thread>
+
+// 通用单例模板示例：只需把构造函数设为私有并把 SingletonAccess 声明为友元
+class AppConfig {
+    friend class SingletonAccess;
+    AppConfig() { std::cout << "AppConfig constructed" << std::endl; }
+
+public:
+    int timeout_ms = 100;
+};
+
+// 服务注册表示例：用 sleep 模拟初始化耗时（读配置、建连接、预热缓存）
+struct DemoService {
+    explicit DemoService(const char* n, int init_ms) : name(n) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(init_ms));
+    }
+    const char* name;
+};
+
 // 本示例的 main 函数只负责演示不同单例实现的使用方式
 // 具体实现细节都在 Singletons.h 中，便于在工程中复用和对比。
 int main() {
@@ -29,7 +51,40 @@ int main() {
     MeyersSingleton& ms2 = MeyersSingleton::Instance();
     ms1.Log("第一次调用 MeyersSingleton");
     ms2.Log("第二次调用 MeyersSingleton（同一实例）");
-    std::cout << "MeyersSingleton address: " << &ms1 << " , " << &ms2 << "\n";
+    std::cout << "MeyersSingleton address: " << &ms1 << " , " << &ms2 << "\n\n";
+
+    // 5. 常量初始化单例—— 编译期构造，Instance() 只是取地址
+    ConstinitSingleton& k1 = ConstinitSingleton::Instance();
+    ConstinitSingleton& k2 = ConstinitSingleton::Instance();
+    k1.Log("第一次调用 ConstinitSingleton");
+    k2.Log("第二次调用 ConstinitSingleton（同一实例）");
+    std::cout << "ConstinitSingleton address: " << &k1 << " , " << &k2
+              << " , log count = " << k2.LogCount() << "\n\n";
+
+    // 6. 通用单例模板—— 初始化策略与生命周期策略在编译期选择
+    using ConfigSingleton = Singleton<AppConfig, DCLInit>;
+    ConfigSingleton::Instance().timeout_ms = 200;
+    AppConfig& c1 = ConfigSingleton::Instance();
+    AppConfig& c2 = ConfigSingleton::CachedInstance();  // 线程局部缓存，紧密循环中使用
+    std::cout << "Singleton<AppConfig, DCLInit> timeout_ms = " << c1.timeout_ms << "\n";
+    std::cout << "Singleton<AppConfig, DCLInit> address: " << &c1 << " , " << &c2 << "\n\n";
+
+    // 7. 服务注册表—— 声明依赖，互不依赖的服务在线程池上并发构造，并输出关键路径
+    ServiceRegistry& services = ServiceRegistry::Instance();
+    services.Register<DemoService>("config", {}, [](ServiceRegistry&) {
+        return std::make_unique<DemoService>("config", 10);
+    });
+    services.Register<DemoService>("database", {"config"}, [](ServiceRegistry&) {
+        return std::make_unique<DemoService>("database", 30);
+    });
+    services.Register<DemoService>("metrics", {"config"}, [](ServiceRegistry&) {
+        return std::make_unique<DemoService>("metrics", 20);
+    });
+    services.Register<DemoService>("user_cache", {"database"}, [](ServiceRegistry&) {
+        return std::make_unique<DemoService>("user_cache", 15);
+    });
+    StartupReport report = services.Start(4);
+    std::cout << report.ToString();
 
     return 0;
 }
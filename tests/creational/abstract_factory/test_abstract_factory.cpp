@@ -1,5 +1,15 @@
 #include "../../../src/creational/abstract_factory/AbstractFactory.h"
+#include "../../../src/creational/abstract_factory/KernelFactory.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // 抽象工厂模式测试套件
 
@@ -93,4 +103,360 @@ TEST(AbstractFactoryTest, MultipleProductCreation) {
         ASSERT_NE(button, nullptr);
         ASSERT_NE(checkbox, nullptr);
     }
-}
\ No newline at end of file
+}
+
+// 捕获 fn 执行期间写入 std::cout 的内容
+template <typename Fn>
+std::string CaptureOutput(Fn fn) {
+    std::ostringstream out;
+    std::streambuf* console = std::cout.rdbuf(out.rdbuf());
+    fn();
+    std::cout.rdbuf(console);
+    return out.str();
+}
+
+// 测试静态产品族：按值返回具体产品，满足静态工厂约束
+TEST(AbstractFactoryTest, StaticFamily_CreatesConcreteProducts) {
+    static_assert(std::is_same_v<decltype(WindowsFamily::CreateButton()), WindowsButton>);
+    static_assert(std::is_same_v<decltype(WindowsFamily::CreateCheckbox()), WindowsCheckbox>);
+    static_assert(std::is_same_v<decltype(MacFamily::CreateButton()), MacButton>);
+    static_assert(std::is_same_v<decltype(MacFamily::CreateCheckbox()), MacCheckbox>);
+    static_assert(kIsStaticGUIFactory<WindowsFamily>);
+    static_assert(kIsStaticGUIFactory<MacFamily>);
+    static_assert(!kIsStaticGUIFactory<WindowsFactory>);  // 成员函数不是静态的
+    static_assert(!kIsStaticGUIFactory<int>);
+
+    EXPECT_EQ(CaptureOutput([] { MacFamily::CreateButton().Paint(); }), "Render Mac Button\n");
+}
+
+// 测试 RenderUI<Family>() 与虚接口版本的输出一致
+TEST(AbstractFactoryTest, RenderUI_StaticMatchesVirtual) {
+    WindowsFactory winFactory;
+    MacFactory macFactory;
+    EXPECT_EQ(CaptureOutput([] { RenderUI<WindowsFamily>(); }),
+              CaptureOutput([&] { RenderUI(winFactory); }));
+    EXPECT_EQ(CaptureOutput([] { RenderUI<MacFamily>(); }),
+              CaptureOutput([&] { RenderUI(macFactory); }));
+    EXPECT_EQ(CaptureOutput([] { RenderUI<MacFamily>(); }),
+              "Render Mac Button\nRender Mac Checkbox\n");
+}
+
+// 测试启动时按平台名选择静态产品族
+TEST(AbstractFactoryTest, SelectRenderUI_ByPlatformName) {
+    EXPECT_EQ(SelectRenderUI("windows"), &RenderUI<WindowsFamily>);
+    EXPECT_EQ(SelectRenderUI("mac"), &RenderUI<MacFamily>);
+    EXPECT_EQ(SelectRenderUI("linux"), nullptr);
+
+    RenderUIFunction render = SelectRenderUI("windows");
+    ASSERT_NE(render, nullptr);
+    EXPECT_EQ(CaptureOutput(render), "Render Windows Button\nRender Windows Checkbox\n");
+}
+
+// 测试渲染命令缓冲区：记录按输出行分组，每种控件的文本与逐个 Paint() 相同
+TEST(AbstractFactoryTest, RenderCommandBuffer_GroupsByPaintLine) {
+    WindowsFactory winFactory;
+    MacFactory macFactory;
+    EXPECT_EQ(CaptureOutput([&] { RenderUI(winFactory); }),
+              std::string(WindowsButton::kPaintText) + "\n" +
+                  std::string(WindowsCheckbox::kPaintText) + "\n");
+    EXPECT_EQ(CaptureOutput([&] { RenderUI(macFactory); }),
+              std::string(MacButton::kPaintText) + "\n" + std::string(MacCheckbox::kPaintText) +
+                  "\n");
+
+    RenderCommandBuffer commands;
+    EXPECT_EQ(CaptureOutput([&] {
+                  RenderUI(macFactory, commands);
+                  RenderUI(winFactory, commands);
+                  RenderUI(macFactory, commands);
+              }),
+              "");  // 记录阶段不输出
+    EXPECT_EQ(commands.Size(), 6u);
+    using Line = RenderCommandBuffer::LineId;
+    const Line windows_button = RenderCommandBuffer::LineOf<WindowsButton>();
+    const Line mac_checkbox = RenderCommandBuffer::LineOf<MacCheckbox>();
+    EXPECT_EQ(RenderCommandBuffer::RegisterLine("Render Mac Checkbox"), mac_checkbox);
+    auto counts = commands.Histogram();
+    ASSERT_GE(counts.size(), 4u);
+    EXPECT_EQ(counts[windows_button], 1u);
+    EXPECT_EQ(counts[mac_checkbox], 2u);
+
+    // 按编号（登记顺序）分组
+    std::vector<std::pair<Line, std::string>> groups = {
+        {windows_button, "Render Windows Button\n"},
+        {RenderCommandBuffer::LineOf<WindowsCheckbox>(), "Render Windows Checkbox\n"},
+        {RenderCommandBuffer::LineOf<MacButton>(), "Render Mac Button\nRender Mac Button\n"},
+        {mac_checkbox, "Render Mac Checkbox\nRender Mac Checkbox\n"},
+    };
+    std::sort(groups.begin(), groups.end());
+    std::string expected;
+    for (const auto& group : groups) {
+        expected += group.second;
+    }
+    EXPECT_EQ(commands.Render(), expected);
+    EXPECT_EQ(commands.Size(), 6u);  // Render() 不清空
+}
+
+// 后来新增的控件：登记自己的输出行，不需要修改 RenderCommandBuffer.h
+class LinuxButton final : public Button {
+public:
+    static constexpr std::string_view kPaintText = "Render Linux Button";
+    void Paint() override { std::cout << kPaintText << std::endl; }
+    void PaintTo(RenderCommandBuffer& commands) override {
+        commands.Append(RenderCommandBuffer::LineOf<LinuxButton>());
+    }
+};
+
+// 只实现了 Paint() 的控件：PaintTo 使用默认实现
+class PlainCheckbox final : public Checkbox {
+public:
+    void Paint() override { std::cout << "Render Plain Checkbox" << std::endl; }
+};
+
+// 测试运行时登记的新控件与默认的 PaintTo(RenderCommandBuffer&)：
+// 登记了输出行的控件批量输出；没有覆盖 PaintTo 的控件退化为立即绘制（通过基类或具体控件调用都可以）
+TEST(AbstractFactoryTest, RenderCommandBuffer_NewWidgetsAndDefaultPaint) {
+    RenderCommandBuffer commands;
+    LinuxButton linux_button;
+    PlainCheckbox plain;
+    Button& button = linux_button;
+    Checkbox& checkbox = plain;
+    EXPECT_EQ(CaptureOutput([&] {
+                  button.PaintTo(commands);
+                  linux_button.PaintTo(commands);
+                  checkbox.PaintTo(commands);
+                  plain.PaintTo(commands);
+              }),
+              "Render Plain Checkbox\nRender Plain Checkbox\n");
+    EXPECT_EQ(commands.Size(), 2u);
+    EXPECT_EQ(commands.Render(), "Render Linux Button\nRender Linux Button\n");
+}
+
+// 测试 Flush()：大批记录分段 writev，内容完整，写完后清空；写入失败时报告
+TEST(AbstractFactoryTest, RenderCommandBuffer_FlushWritesEverything) {
+    WindowsFactory winFactory;
+    MacFactory macFactory;
+    RenderCommandBuffer commands;
+    constexpr std::size_t kSets = 50000;  // 约 2 MB 输出，远多于一个重复文本块
+    for (std::size_t i = 0; i < kSets; ++i) {
+        RenderUI(i % 3 == 0 ? static_cast<const GUIFactory&>(macFactory) : winFactory, commands);
+    }
+    const std::string expected = commands.Render();
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    RenderCommandBuffer::FlushStats stats = commands.Flush(fileno(file));
+    EXPECT_TRUE(stats.ok);
+    EXPECT_EQ(stats.records, 2 * kSets);
+    EXPECT_EQ(stats.bytes, expected.size());
+    EXPECT_GE(stats.writes, 1u);
+    EXPECT_LT(stats.writes, 10u);
+    EXPECT_TRUE(commands.Empty());
+
+    std::string written(expected.size() + 1, '\0');
+    std::rewind(file);
+    written.resize(std::fread(&written[0], 1, written.size(), file));
+    std::fclose(file);
+    EXPECT_EQ(written, expected);
+
+    EXPECT_TRUE(commands.Flush().ok);  // 空缓冲区：不写任何内容
+    RenderUI(winFactory, commands);
+    stats = commands.Flush(-1);
+    EXPECT_FALSE(stats.ok);
+    EXPECT_TRUE(commands.Empty());
+}
+
+// 统计分配 / 释放次数的内存资源，实际分配交给上游
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// 测试 arena 版本的工厂方法：从 arena 分配正确的具体产品，monotonic arena 中销毁时不向上游归还内存
+TEST(AbstractFactoryTest, ArenaFactory_CreatesProductsInArena) {
+    CountingResource counting;
+    std::pmr::monotonic_buffer_resource arena(&counting);
+    MacFactory factory;
+    {
+        ArenaPtr<Button> button = factory.CreateButtonIn(arena);
+        ArenaPtr<Checkbox> checkbox = factory.CreateCheckboxIn(arena);
+        ASSERT_NE(button, nullptr);
+        ASSERT_NE(checkbox, nullptr);
+        EXPECT_NE(dynamic_cast<MacButton*>(button.get()), nullptr);
+        EXPECT_NE(dynamic_cast<MacCheckbox*>(checkbox.get()), nullptr);
+        EXPECT_EQ(CaptureOutput([&] { checkbox->Paint(); }), "Render Mac Checkbox\n");
+    }
+    EXPECT_EQ(counting.allocations, 1u);  // 两个控件来自 arena 向上游申请的同一块内存
+    EXPECT_EQ(counting.deallocations, 0u);
+    arena.release();
+    EXPECT_EQ(counting.deallocations, 1u);
+
+    // ArenaPtr 销毁时调用析构函数
+    struct Tracked {
+        int* destroyed;
+        Tracked() : destroyed(nullptr) {}
+        ~Tracked() { ++*destroyed; }
+    };
+    int destroyed = 0;
+    ArenaPtr<Tracked> tracked = MakeInArena<Tracked>(arena);
+    tracked->destroyed = &destroyed;
+    tracked.reset();
+    EXPECT_EQ(destroyed, 1);
+}
+
+// 测试非 monotonic 的资源：ArenaPtr 销毁时把内存按分配时的大小交还资源，不泄漏
+TEST(AbstractFactoryTest, ArenaFactory_ReturnsMemoryToResource) {
+    CountingResource counting;
+    WindowsFactory factory;
+    {
+        ArenaUI ui = BuildUI(factory, 10, counting);
+        EXPECT_NE(dynamic_cast<WindowsButton*>(ui.buttons[0].get()), nullptr);
+        EXPECT_EQ(counting.deallocations, 0u);
+    }
+    EXPECT_GT(counting.allocations, 20u);  // 20 个控件 + 两个容器
+    EXPECT_EQ(counting.deallocations, counting.allocations);
+}
+
+// 只实现堆版本工厂方法的工厂：arena 版本使用 GUIFactory 的默认实现
+class HeapOnlyFactory : public GUIFactory {
+public:
+    std::unique_ptr<Button> CreateButton() const override {
+        return std::make_unique<MacButton>();
+    }
+    std::unique_ptr<Checkbox> CreateCheckbox() const override {
+        return std::make_unique<WindowsCheckbox>();
+    }
+};
+
+// 测试 arena 版本的默认实现：退回到堆上创建，仍可用于 BuildUI，且不从 arena 分配控件
+TEST(AbstractFactoryTest, ArenaFactory_DefaultFallsBackToHeap) {
+    CountingResource counting;
+    HeapOnlyFactory factory;
+    {
+        ArenaUI ui = BuildUI(factory, 4, counting);
+        ASSERT_EQ(ui.buttons.size(), 4u);
+        EXPECT_NE(dynamic_cast<MacButton*>(ui.buttons[3].get()), nullptr);
+        EXPECT_EQ(CaptureOutput([&] { ui.checkboxes[0]->Paint(); }), "Render Windows Checkbox\n");
+    }
+    EXPECT_EQ(counting.allocations, 2u);  // 只有两个容器来自资源
+    EXPECT_EQ(counting.deallocations, 2u);
+
+    // arena 版本与堆版本不同名：通过派生类直接调用，不会被派生类的 CreateButton() 隐藏
+    ArenaPtr<Button> button = factory.CreateButtonIn(counting);
+    EXPECT_NE(dynamic_cast<MacButton*>(button.get()), nullptr);
+    EXPECT_EQ(counting.allocations, 2u);
+}
+
+// 测试 BuildUI：一帧的控件全部来自初始缓冲区，release() 后可以原地重建
+TEST(AbstractFactoryTest, ArenaFactory_BuildUIRebuildsEveryFrame) {
+    constexpr std::size_t kSets = 100;
+    alignas(std::max_align_t) static unsigned char buffer[64 * 1024];
+    // 上游是 null_memory_resource：一旦超出初始缓冲区就抛出 bad_alloc
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource());
+    WindowsFactory factory;
+    for (int frame = 0; frame < 3; ++frame) {
+        {
+            ArenaUI ui = BuildUI(factory, kSets, arena);
+            ASSERT_EQ(ui.buttons.size(), kSets);
+            ASSERT_EQ(ui.checkboxes.size(), kSets);
+            for (std::size_t i = 0; i < kSets; ++i) {
+                auto* address = reinterpret_cast<unsigned char*>(ui.buttons[i].get());
+                EXPECT_TRUE(address >= buffer && address < buffer + sizeof(buffer));
+            }
+            EXPECT_NE(dynamic_cast<WindowsCheckbox*>(ui.checkboxes[kSets - 1].get()), nullptr);
+        }
+        arena.release();
+    }
+}
+
+// 测试标量内核族：CRC32C 标准校验值与基本语义
+TEST(AbstractFactoryTest, KernelFactory_ScalarFamily) {
+    const KernelFactory* scalar = KernelFactoryFor(KernelIsa::kScalar);
+    ASSERT_NE(scalar, nullptr);
+    EXPECT_EQ(scalar->Isa(), KernelIsa::kScalar);
+
+    auto checksum = scalar->CreateChecksum();
+    EXPECT_EQ(checksum->Crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(checksum->Crc32c("", 0), 0u);
+    // 分段计算与一次计算结果相同
+    EXPECT_EQ(checksum->Crc32c("6789", 4, checksum->Crc32c("12345", 5)), 0xE3069283u);
+
+    const std::uint32_t words[] = {1, 2, 0xffffffffu, 4};
+    EXPECT_EQ(scalar->CreateSum()->Sum(words, 4), 7u + 0xffffffffull);
+
+    const std::uint8_t bytes[] = {5, 6, 7, 6};
+    auto search = scalar->CreateSearch();
+    EXPECT_EQ(search->Find(bytes, 4, 6), 1u);
+    EXPECT_EQ(search->Find(bytes, 4, 9), 4u);
+
+    std::uint8_t copied[4] = {};
+    scalar->CreateCopy()->Copy(copied, bytes, 4);
+    EXPECT_TRUE(std::equal(bytes, bytes + 4, copied));
+}
+
+// 测试主机支持的每个产品族：与标量族结果逐项一致
+TEST(AbstractFactoryTest, KernelFactory_SupportedFamiliesMatchScalar) {
+    const KernelFactory* scalar = KernelFactoryFor(KernelIsa::kScalar);
+    std::vector<std::uint8_t> bytes(1 << 16);
+    std::vector<std::uint32_t> words(1 << 14);
+    std::uint32_t seed = 7;
+    for (auto& b : bytes) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<std::uint8_t>(seed >> 24);
+    }
+    for (auto& w : words) {
+        seed = seed * 1664525u + 1013904223u;
+        w = seed;
+    }
+    bytes[40000] = 0;  // 确保要查找的 0 一定存在
+
+    for (KernelIsa isa : {KernelIsa::kSse42, KernelIsa::kAvx2, KernelIsa::kAvx512}) {
+        const KernelFactory* family = KernelFactoryFor(isa);
+        if (family == nullptr) {
+            EXPECT_FALSE(CpuFeatures::Host().Supports(isa));
+            continue;
+        }
+        SCOPED_TRACE(family->Name());
+        EXPECT_EQ(family->Isa(), isa);
+        EXPECT_TRUE(VerifyKernelFamily(*family));
+
+        EXPECT_EQ(family->CreateSum()->Sum(words.data(), words.size()),
+                  scalar->CreateSum()->Sum(words.data(), words.size()));
+        EXPECT_EQ(family->CreateChecksum()->Crc32c(bytes.data(), bytes.size()),
+                  scalar->CreateChecksum()->Crc32c(bytes.data(), bytes.size()));
+        for (std::uint8_t value : {0, 17, 255}) {
+            EXPECT_EQ(family->CreateSearch()->Find(bytes.data(), bytes.size(), value),
+                      scalar->CreateSearch()->Find(bytes.data(), bytes.size(), value));
+        }
+        std::vector<std::uint8_t> copied(bytes.size() + 1, 0xaa);
+        family->CreateCopy()->Copy(copied.data() + 1, bytes.data(), bytes.size() - 1);
+        EXPECT_TRUE(std::equal(bytes.begin(), bytes.end() - 1, copied.begin() + 1));
+        EXPECT_EQ(copied[0], 0xaa);
+        EXPECT_EQ(copied.back(), 0xaa);
+    }
+}
+
+// 测试启动时选择：选中主机支持的最高一档
+TEST(AbstractFactoryTest, KernelFactory_SelectsHighestSupportedFamily) {
+    const KernelFactory& selected = SelectKernelFactory();
+    EXPECT_EQ(&selected, &SelectKernelFactory());  // 只选择一次
+    EXPECT_TRUE(CpuFeatures::Host().Supports(selected.Isa()));
+    for (int isa = static_cast<int>(selected.Isa()) + 1; isa <= static_cast<int>(KernelIsa::kAvx512);
+         ++isa) {
+        EXPECT_FALSE(CpuFeatures::Host().Supports(static_cast<KernelIsa>(isa)));
+    }
+}
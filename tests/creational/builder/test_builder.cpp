@@ -1,5 +1,16 @@
 #include "../../../src/creational/builder/Builder.h"
+#include "../../../src/creational/builder/ComputerArchive.h"
+#include "../../../src/creational/builder/ParallelDirector.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 // 建造者模式测试套件
 
@@ -126,4 +137,261 @@ TEST(BuilderTest, BuilderResetSimulation) {
     
     // 验证两个对象是不同的实例
     EXPECT_NE(pc1.get(), pc2.get());
-}
\ No newline at end of file
+}
+// 测试组件字符串驻留：相同字符串同一个 id，id 0 为空字符串，Name 还原原文
+TEST(BuilderTest, ComponentTable_InternsOncePerString) {
+    const std::size_t before = ComponentTable::Size();
+    ComponentId a = ComponentTable::Intern("Test-only CPU");
+    ComponentId b = ComponentTable::Intern(std::string("Test-only ") + "CPU");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, 0);
+    EXPECT_EQ(ComponentTable::Name(a), "Test-only CPU");
+    EXPECT_LE(ComponentTable::Size(), before + 1);
+
+    EXPECT_EQ(ComponentTable::Intern(""), 0);
+    EXPECT_EQ(ComponentTable::Name(0), "");
+    EXPECT_EQ(ComponentTable::Name(0xFFFF), "");  // 未知 id
+}
+
+// 测试紧凑建造者与原有 Director::Construct 得到相同配置
+TEST(BuilderTest, CompactBuilder_MatchesDirectorConstruct) {
+    Director director;
+    GamingComputerBuilder gamingBuilder;
+    OfficeComputerBuilder officeBuilder;
+    director.Construct(gamingBuilder);
+    director.Construct(officeBuilder);
+    auto gamingPC = gamingBuilder.GetResult();
+    auto officePC = officeBuilder.GetResult();
+
+    CompactDirector compactDirector;
+    CompactGamingComputerBuilder compactGaming;
+    CompactOfficeComputerBuilder compactOffice;
+    CompactComputer gaming;
+    CompactComputer office;
+    compactDirector.Construct(compactGaming, gaming);
+    compactDirector.Construct(compactOffice, office);
+
+    Computer expanded = gaming.Expand();
+    EXPECT_EQ(expanded.cpu, gamingPC->cpu);
+    EXPECT_EQ(expanded.gpu, gamingPC->gpu);
+    EXPECT_EQ(expanded.ram, gamingPC->ram);
+    EXPECT_EQ(expanded.storage, gamingPC->storage);
+    expanded = office.Expand();
+    EXPECT_EQ(expanded.cpu, officePC->cpu);
+    EXPECT_EQ(expanded.gpu, officePC->gpu);
+    EXPECT_EQ(expanded.ram, officePC->ram);
+    EXPECT_EQ(expanded.storage, officePC->storage);
+    EXPECT_EQ(gamingPC->cpu, kGamingComponents.cpu);  // 两种建造者取自同一份组件名
+    EXPECT_EQ(officePC->storage, kOfficeComponents.storage);
+
+    // 建造者可以反复使用，同一配置得到相同的 id
+    CompactComputer again;
+    compactDirector.Construct(CompactGamingComputerBuilder(), again);
+    EXPECT_EQ(again.cpu, gaming.cpu);
+    EXPECT_EQ(again.storage, gaming.storage);
+    EXPECT_NE(gaming.cpu, office.cpu);
+}
+
+// 测试批量构建到调用方存储与 arena
+TEST(BuilderTest, CompactDirector_ConstructsIntoStorageAndArena) {
+    CompactDirector director;
+    CompactOfficeComputerBuilder builder;
+    CompactComputer expected;
+    director.Construct(builder, expected);
+
+    std::vector<CompactComputer> storage(1000);
+    director.ConstructMany(builder, storage.data(), storage.size());
+    for (const CompactComputer& computer : storage) {
+        EXPECT_EQ(computer.cpu, expected.cpu);
+        EXPECT_EQ(computer.gpu, expected.gpu);
+        EXPECT_EQ(computer.ram, expected.ram);
+        EXPECT_EQ(computer.storage, expected.storage);
+    }
+    director.ConstructMany(builder, nullptr, 0);  // 空范围：不访问 out
+
+    alignas(std::max_align_t) unsigned char buffer[8 * 1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource());
+    CompactComputer* computers = director.ConstructInArena(builder, 1000, arena);
+    ASSERT_NE(computers, nullptr);
+    auto* address = reinterpret_cast<unsigned char*>(computers);
+    EXPECT_TRUE(address >= buffer && address + 1000 * sizeof(CompactComputer) <= buffer + sizeof(buffer));
+    EXPECT_EQ(computers[999].ram, expected.ram);
+    EXPECT_EQ(computers[999].Expand().storage, "512GB SSD");
+    EXPECT_EQ(director.ConstructInArena(builder, 0, arena), nullptr);
+}
+
+// 测试并行指挥者：输出顺序与输入一致，结果与逐条顺序构建相同
+TEST(BuilderTest, ParallelDirector_OutputsInInputOrder) {
+    std::vector<ComputerSpec> specs(10000);
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+        specs[i].cpu = "Catalog CPU " + std::to_string(i % 37);
+        specs[i].gpu = "Catalog GPU " + std::to_string(i % 11);
+        specs[i].ram = std::to_string(8 << (i % 4)) + "GB";
+        specs[i].storage = i % 2 ? "1TB SSD" : "512GB SSD";
+    }
+
+    ParallelDirector parallel(4);
+    EXPECT_EQ(parallel.Threads(), 4u);
+    std::vector<CompactComputer> out(specs.size());
+    ParallelConstructStats stats = parallel.Construct(specs.data(), specs.size(), out.data());
+    EXPECT_EQ(stats.threads, 4u);
+
+    CompactDirector director;
+    SpecComputerBuilder builder;
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+        CompactComputer expected;
+        builder.Reset(specs[i]);
+        director.Construct(builder, expected);
+        ASSERT_EQ(out[i].cpu, expected.cpu) << i;
+        ASSERT_EQ(out[i].gpu, expected.gpu) << i;
+        ASSERT_EQ(out[i].ram, expected.ram) << i;
+        ASSERT_EQ(out[i].storage, expected.storage) << i;
+    }
+    EXPECT_EQ(out[37].Expand().cpu, "Catalog CPU 0");
+    EXPECT_EQ(out[9999].Expand().storage, "1TB SSD");
+
+    // 空目录与单线程
+    EXPECT_EQ(parallel.Construct(specs.data(), 0, out.data()).steals, 0u);
+    ParallelDirector single(1);
+    std::vector<CompactComputer> serial(specs.size());
+    single.Construct(specs.data(), specs.size(), serial.data());
+    EXPECT_EQ(serial[1234].cpu, out[1234].cpu);
+}
+
+// 测试 Run：每个下标恰好处理一次，每个线程只创建一个建造者，负载不均时发生窃取
+TEST(BuilderTest, ParallelDirector_StealsAndReusesBuilders) {
+    constexpr std::size_t kCount = 100000;
+    std::vector<std::atomic<int>> visits(kCount);
+    std::atomic<int> builders{0};
+    ParallelDirector parallel(4);
+
+    // 前四分之一（调用线程的初始区间）每条都让出 CPU，其余线程做完自己的部分后会来窃取
+    ParallelConstructStats stats = parallel.Run(
+        kCount, [&] { return builders.fetch_add(1) + 1; },
+        [&](int&, std::size_t i) {
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+            if (i < kCount / 4) {
+                std::this_thread::yield();
+            }
+        });
+    EXPECT_EQ(builders.load(), 4);
+    EXPECT_GT(stats.steals, 0u);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        ASSERT_EQ(visits[i].load(), 1) << i;
+    }
+}
+
+// 测试异常：第一个异常在所有线程停止后抛给调用方，之后仍可继续使用
+TEST(BuilderTest, ParallelDirector_PropagatesExceptions) {
+    ParallelDirector parallel(3);
+    EXPECT_THROW(parallel.Run(
+                     10000, [] { return 0; },
+                     [](int&, std::size_t i) {
+                         if (i == 5000) {
+                             throw std::runtime_error("bad spec");
+                         }
+                     }),
+                 std::runtime_error);
+
+    std::atomic<std::size_t> done{0};
+    parallel.Run(
+        1000, [] { return 0; }, [&](int&, std::size_t) { done.fetch_add(1); });
+    EXPECT_EQ(done.load(), 1000u);
+}
+
+// 测试二进制存档：Serialize / Attach 往返，字符串表去重，视图不复制字符串
+TEST(BuilderTest, ComputerArchive_RoundTripsInMemory) {
+    Director director;
+    GamingComputerBuilder gamingBuilder;
+    director.Construct(gamingBuilder);
+    Computer gaming = *gamingBuilder.GetResult();
+
+    CompactDirector compactDirector;
+    CompactComputer office;
+    compactDirector.Construct(CompactOfficeComputerBuilder(), office);
+
+    ComputerArchiveWriter writer;
+    for (int i = 0; i < 100; ++i) {
+        writer.Add(gaming);
+        writer.Add(office);
+    }
+    Computer custom;
+    custom.cpu = std::string(300, 'x');  // 超过 SSO 长度的组件名
+    writer.Add(custom);
+    EXPECT_EQ(writer.Size(), 201u);
+    const std::string image = writer.Serialize();
+    // 文件头 + 201 条记录 + 去重后的字符串表（9 种字符串，远小于逐条保存）
+    EXPECT_LT(image.size(), sizeof(ComputerArchiveHeader) + 201 * sizeof(ComputerRecord) + 512);
+
+    ComputerArchive archive;
+    ASSERT_TRUE(archive.Attach(image.data(), image.size())) << archive.Error();
+    ASSERT_EQ(archive.Size(), 201u);
+    ComputerView first = archive[0];
+    EXPECT_EQ(first.cpu, "High-end CPU");
+    EXPECT_EQ(first.storage, "1TB SSD");
+    EXPECT_EQ(archive[1].gpu, "Integrated GPU");
+    EXPECT_EQ(archive[199].ram, "16GB");
+    EXPECT_EQ(archive[200].cpu, custom.cpu);
+    EXPECT_EQ(archive[200].gpu, "");
+    // 零拷贝：视图指向映像内部，相同字符串指向同一处
+    EXPECT_GE(first.cpu.data(), image.data());
+    EXPECT_LT(first.cpu.data(), image.data() + image.size());
+    EXPECT_EQ(archive[2].cpu.data(), first.cpu.data());
+    Computer materialized = archive[1].Materialize();
+    EXPECT_EQ(materialized.storage, "512GB SSD");
+
+    ComputerArchiveWriter empty;
+    const std::string empty_image = empty.Serialize();
+    ASSERT_TRUE(archive.Attach(empty_image.data(), empty_image.size()));
+    EXPECT_EQ(archive.Size(), 0u);
+}
+
+// 测试 mmap 读取与格式校验：错误的魔数 / 版本 / 截断文件被拒绝，损坏的偏移得到空视图
+TEST(BuilderTest, ComputerArchive_MapsFilesAndRejectsCorruption) {
+    ComputerArchiveWriter writer;
+    CompactDirector director;
+    CompactComputer computer;
+    director.Construct(CompactGamingComputerBuilder(), computer);
+    for (int i = 0; i < 1000; ++i) {
+        writer.Add(computer);
+    }
+    const std::string path = testing::TempDir() + "builder_archive_test.bin";
+    ASSERT_TRUE(writer.WriteFile(path));
+
+    ComputerArchive archive;
+    ASSERT_TRUE(archive.Open(path)) << archive.Error();
+    EXPECT_TRUE(archive.IsOpen());
+    ASSERT_EQ(archive.Size(), 1000u);
+    EXPECT_EQ(archive[999].gpu, "High-end GPU");
+    ComputerArchive moved = std::move(archive);
+    EXPECT_FALSE(archive.IsOpen());
+    EXPECT_EQ(moved[0].cpu, "High-end CPU");
+    moved.Close();
+    std::remove(path.c_str());
+    EXPECT_FALSE(moved.Open(path));
+    EXPECT_FALSE(moved.Error().empty());
+
+    std::string image = writer.Serialize();
+    std::string bad = image;
+    bad[0] = 'X';
+    EXPECT_FALSE(archive.Attach(bad.data(), bad.size()));
+    EXPECT_EQ(archive.Error(), "not a computer archive");
+
+    bad = image;
+    const std::uint32_t future_version = kComputerArchiveVersion + 1;
+    std::memcpy(&bad[offsetof(ComputerArchiveHeader, version)], &future_version, sizeof(future_version));
+    EXPECT_FALSE(archive.Attach(bad.data(), bad.size()));
+    EXPECT_FALSE(archive.IsOpen());
+
+    EXPECT_FALSE(archive.Attach(image.data(), image.size() - 100));  // 截断：记录超出文件
+    EXPECT_FALSE(archive.Attach(image.data(), 10));
+
+    bad = image;
+    const std::uint32_t wild = 0x7FFFFFF0u;
+    std::memcpy(&bad[sizeof(ComputerArchiveHeader) + offsetof(ComputerRecord, ram)], &wild,
+                sizeof(wild));
+    ASSERT_TRUE(archive.Attach(bad.data(), bad.size()));
+    EXPECT_EQ(archive[0].ram, "");
+    EXPECT_EQ(archive[0].cpu, "High-end CPU");
+}
@@ -0,0 +1,60 @@
+#include "../../../src/creational/factory_method/ProductPlugin.h"
+
+#include <cstdint>
+#include <string_view>
+
+// 测试 / 基准用的产品插件（编译为共享库 factory_method_plugin）
+// ----------------------------------
+// 提供 "plugin.C" 与 "plugin.D" 两种产品。为了模拟真实插件带来的启动负担，库里带有一张
+// 需要在加载时由静态构造函数填充的表（kTableSize 个 64 位值，约 2 MiB）。
+
+namespace {
+
+constexpr std::size_t kTableSize = std::size_t{1} << 18;
+
+// 加载时（静态初始化阶段）逐项计算的查找表
+struct StartupTable {
+    StartupTable() {
+        std::uint64_t x = 0x9e3779b97f4a7c15ULL;
+        for (std::size_t i = 0; i < kTableSize; ++i) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            values[i] = x;
+        }
+    }
+
+    std::uint64_t values[kTableSize];
+};
+
+StartupTable g_table;
+
+class PluginProductC : public Product {
+public:
+    static constexpr std::string_view kTypeName = "plugin.C";
+    void Use() override { checksum_ += g_table.values[++uses_ & (kTableSize - 1)]; }
+
+private:
+    std::uint64_t uses_ = 0;
+    std::uint64_t checksum_ = 0;
+};
+
+class PluginProductD : public Product {
+public:
+    static constexpr std::string_view kTypeName = "plugin.D";
+    void Use() override { ++uses_; }
+
+private:
+    std::uint64_t uses_ = 0;
+};
+
+}  // namespace
+
+PRODUCT_PLUGIN_EXPORT const ProductPluginExports* GetProductPluginExports() {
+    static constexpr ProductPluginFactory factories[] = {
+        ProductPluginFactoryOf<PluginProductC>("plugin.C"),
+        ProductPluginFactoryOf<PluginProductD>("plugin.D"),
+    };
+    static constexpr ProductPluginExports exports{kProductPluginAbiVersion, 2, factories};
+    return &exports;
+}
@@ -1,7 +1,17 @@
 #include "../../../src/creational/factory_method/FactoryMethod.h"
+#include "../../../src/creational/factory_method/FactoryMetrics.h"
+#include "../../../src/creational/factory_method/ProductPlugin.h"
+#include "../../../src/creational/factory_method/StaticFactory.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <thread>
 #include <mutex>
+#include <stdexcept>
 #include <vector>
 #include <memory>
 
@@ -89,7 +99,7 @@ TEST(FactoryMethodTest, ProductRegistry_ThreadSafety) {
     InitProductRegistry();
     
     std::vector<std::thread> threads;
-    std::vector<std::unique_ptr<Product>> products(10);
+    std::vector<ProductPtr> products(10);
     
     for (int i = 0; i < 10; ++i) {
         threads.emplace_back([i, &products]() {
@@ -105,4 +115,667 @@ TEST(FactoryMethodTest, ProductRegistry_ThreadSafety) {
     for (const auto& product : products) {
         EXPECT_NE(product, nullptr);
     }
-}
\ No newline at end of file
+}
+// 测试冻结后的注册表：Create 走无锁快照，迟到的注册通过写时复制对后续查找可见
+TEST(FactoryMethodTest, ProductRegistry_FreezeAndLateRegistration) {
+    InitProductRegistry();
+    ProductRegistry::Freeze();
+    ProductRegistry::Freeze();  // 重复冻结无副作用
+    EXPECT_TRUE(ProductRegistry::IsFrozen());
+    EXPECT_NE(ProductRegistry::Create("A"), nullptr);
+    EXPECT_EQ(ProductRegistry::Create("Late0"), nullptr);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                auto product = ProductRegistry::Create("B");
+                if (product == nullptr || dynamic_cast<ConcreteProductB*>(product.get()) == nullptr) {
+                    failures.fetch_add(1);
+                }
+            }
+        });
+    }
+    // 读者持续查找的同时进行迟到注册
+    for (int i = 0; i < 50; ++i) {
+        ProductRegistry::Register("Late" + std::to_string(i), []() -> std::unique_ptr<Product> {
+            return std::make_unique<ConcreteProductA>();
+        });
+    }
+    stop.store(true);
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_NE(ProductRegistry::Create("Late" + std::to_string(i)), nullptr);
+    }
+}
+
+// 测试编译期哈希的类型键与整数句柄：与字符串查找得到同一个工厂
+TEST(FactoryMethodTest, ProductRegistry_TypeKeysAndHandles) {
+    static constexpr TypeKey kKeyA{"A"};
+    static_assert(kKeyA.hash == Fnv1a64("A"), "TypeKey hash must be computed at compile time");
+    static_assert(Fnv1a64("") == 14695981039346656037ull, "FNV-1a offset basis");
+
+    InitProductRegistry();
+    ProductHandle handle_a = ProductRegistry::Lookup(kKeyA);
+    ProductHandle handle_b = ProductRegistry::Lookup(std::string_view("B"));
+    ASSERT_TRUE(handle_a.IsValid());
+    ASSERT_TRUE(handle_b.IsValid());
+    EXPECT_NE(handle_a.index, handle_b.index);
+    EXPECT_FALSE(ProductRegistry::Lookup("NonExistent").IsValid());
+    EXPECT_EQ(ProductRegistry::Create(ProductHandle{}), nullptr);
+
+    EXPECT_NE(dynamic_cast<ConcreteProductA*>(ProductRegistry::Create(kKeyA).get()), nullptr);
+    EXPECT_NE(dynamic_cast<ConcreteProductA*>(ProductRegistry::Create(handle_a).get()), nullptr);
+    EXPECT_NE(dynamic_cast<ConcreteProductB*>(ProductRegistry::Create(handle_b).get()), nullptr);
+
+    // 重复注册覆盖工厂，但句柄不变
+    ProductHandle again = ProductRegistry::Register("A", []() -> std::unique_ptr<Product> {
+        return std::make_unique<ConcreteProductA>();
+    });
+    EXPECT_EQ(again.index, handle_a.index);
+}
+
+// 测试完美哈希：数千种类型全部可查，未注册的名字查不到，冻结后的句柄保持不变
+TEST(FactoryMethodTest, ProductRegistry_PerfectHashWithThousandsOfTypes) {
+    KeyTable<int> table;
+    const int count = 5000;
+    for (int i = 0; i < count; ++i) {
+        std::string name = "product_" + std::to_string(i);
+        EXPECT_EQ(table.Insert(name, Fnv1a64(name), i), static_cast<std::uint32_t>(i));
+    }
+    ASSERT_TRUE(table.BuildPerfectHash());
+    for (int i = 0; i < count; ++i) {
+        std::string name = "product_" + std::to_string(i);
+        std::uint32_t index = table.Find(Fnv1a64(name), name);
+        ASSERT_NE(index, KeyTable<int>::kNone);
+        EXPECT_EQ(table.At(index)->value, i);
+    }
+    EXPECT_EQ(table.Find(Fnv1a64("product_x"), "product_x"), KeyTable<int>::kNone);
+
+    InitProductRegistry();
+    ProductHandle handle_b = ProductRegistry::Lookup("B");
+    ProductRegistry::Freeze(ProductRegistry::KeyIndex::kPerfectHash);
+    EXPECT_TRUE(ProductRegistry::UsesPerfectHash());
+    EXPECT_EQ(ProductRegistry::Lookup("B").index, handle_b.index);
+    EXPECT_NE(ProductRegistry::Create("A"), nullptr);
+    EXPECT_EQ(ProductRegistry::Create("NonExistent"), nullptr);
+
+    // 冻结后迟到注册：新快照重新构建完美哈希
+    ProductRegistry::Register("LatePerfect", []() -> std::unique_ptr<Product> {
+        return std::make_unique<ConcreteProductB>();
+    });
+    EXPECT_TRUE(ProductRegistry::UsesPerfectHash());
+    EXPECT_NE(ProductRegistry::Create("LatePerfect"), nullptr);
+}
+
+// 对象池测试使用的产品：记录存活实例数，确认删除器会调用析构函数
+class PoolProbeProduct : public Product {
+public:
+    explicit PoolProbeProduct(bool fail = false) {
+        if (fail) {
+            throw std::runtime_error("construction failed");
+        }
+        ++alive;
+    }
+    ~PoolProbeProduct() override { --alive; }
+    void Use() override {}
+
+    inline static int alive = 0;
+};
+
+// 测试对象池：销毁后的内存被复用，命中/未命中/高水位统计正确，构造失败时内存归还给池
+TEST(FactoryMethodTest, ObjectPool_RecyclesBlocksAndTracksStats) {
+    auto& pool = ObjectPool<PoolProbeProduct>::Instance();
+    std::vector<ProductPtr> products;
+    std::vector<Product*> addresses;
+    for (int i = 0; i < 4; ++i) {
+        products.push_back(MakePooledProduct<PoolProbeProduct>());
+        addresses.push_back(products.back().get());
+        EXPECT_TRUE(products.back().get_deleter().IsPooled());
+    }
+    EXPECT_EQ(PoolProbeProduct::alive, 4);
+    PoolStats stats = pool.Stats();
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.Live(), 4u);
+    EXPECT_EQ(stats.high_water, 4u);
+
+    products.clear();
+    EXPECT_EQ(PoolProbeProduct::alive, 0);
+    for (int i = 0; i < 4; ++i) {
+        products.push_back(MakePooledProduct<PoolProbeProduct>());
+        EXPECT_NE(std::find(addresses.begin(), addresses.end(), products.back().get()),
+                  addresses.end());
+    }
+    stats = pool.Stats();
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_EQ(stats.owned, 4u);
+    EXPECT_EQ(stats.high_water, 4u);
+
+    products.clear();
+    EXPECT_THROW(MakePooledProduct<PoolProbeProduct>(true), std::runtime_error);
+    stats = pool.Stats();
+    EXPECT_EQ(stats.Live(), 0u);
+    EXPECT_EQ(stats.owned, 4u);  // 构造失败的那块内存来自池，已经还回去
+    EXPECT_EQ(PoolProbeProduct::alive, 0);
+}
+
+// 测试跨线程归还：一个线程创建、另一个线程销毁，线程退出后缓存回到全局链表供其他线程复用
+TEST(FactoryMethodTest, ObjectPool_CrossThreadRelease) {
+    auto& pool = ObjectPool<ConcreteProductB>::Instance();
+    const std::size_t count = 1000;  // 超过线程缓存上限，覆盖批量归还路径
+    std::vector<ProductPtr> products(count);
+    std::thread producer([&products] {
+        PooledCreator<ConcreteProductB> creator;
+        for (auto& product : products) {
+            product = creator.CreateProduct();
+        }
+    });
+    producer.join();
+    PoolStats before = pool.Stats();
+    products.clear();  // 在主线程归还
+    PoolStats after = pool.Stats();
+    EXPECT_EQ(after.releases - before.releases, count);
+    EXPECT_EQ(after.Live(), 0u);
+    EXPECT_GE(after.high_water, count);
+
+    std::thread consumer([&pool, count] {
+        PoolStats start = pool.Stats();
+        std::vector<ProductPtr> again;
+        for (std::size_t i = 0; i < count; ++i) {
+            again.push_back(MakePooledProduct<ConcreteProductB>());
+        }
+        // 主线程缓存最多留下 kCacheLimit 块，其余都经全局链表复用
+        EXPECT_LE(pool.Stats().misses - start.misses, ObjectPool<ConcreteProductB>::kCacheLimit);
+    });
+    consumer.join();
+
+    std::size_t owned = pool.Stats().owned;
+    EXPECT_EQ(pool.Trim(), owned);
+    EXPECT_EQ(pool.Stats().owned, 0u);
+}
+
+// 测试 ProductPtr：普通 make_unique 的结果可以直接转换，删除器退化为 delete；
+// 内置的具体工厂与 RegisterType 注册的类型从对象池分配
+TEST(FactoryMethodTest, ProductPtr_AcceptsPlainUniquePtr) {
+    ProductPtr plain = std::make_unique<ConcreteProductA>();
+    ASSERT_NE(plain, nullptr);
+    EXPECT_FALSE(plain.get_deleter().IsPooled());
+    EXPECT_TRUE(ConcreteCreatorA().CreateProduct().get_deleter().IsPooled());
+    EXPECT_TRUE(ConcreteCreatorB().CreateProduct().get_deleter().IsPooled());
+
+    PooledCreator<ConcreteProductA> creator;
+    ProductPtr pooled = creator.CreateProduct();
+    ASSERT_NE(pooled, nullptr);
+    EXPECT_TRUE(pooled.get_deleter().IsPooled());
+
+    ProductRegistry::RegisterType<ConcreteProductB>("PooledTypeB");
+    ProductPtr registered = ProductRegistry::Create("PooledTypeB");
+    ASSERT_NE(registered, nullptr);
+    EXPECT_TRUE(registered.get_deleter().IsPooled());
+}
+
+// 批量创建测试使用的产品：记录存活实例数与 Use() 次数，可指定第几次构造时抛出异常
+class BatchProbeProduct : public Product {
+public:
+    BatchProbeProduct() {
+        if (++constructed == throw_at) {
+            throw std::runtime_error("construction failed");
+        }
+        ++alive;
+    }
+    ~BatchProbeProduct() override { --alive; }
+    void Use() override { ++uses; }
+
+    int uses = 0;
+    inline static int alive = 0;
+    inline static int constructed = 0;
+    inline static int throw_at = -1;
+};
+
+// 测试批量创建：具体工厂返回连续存储的批次，遍历与 UseAll 访问到每一个产品
+TEST(FactoryMethodTest, CreateBatch_ContiguousStorage) {
+    ConcreteCreatorA creator;
+    const Creator& base = creator;
+    ProductBatch batch = base.CreateBatch(64);
+    ASSERT_EQ(batch.size(), 64u);
+    EXPECT_TRUE(batch.IsContiguous());
+    for (std::size_t i = 0; i + 1 < batch.size(); ++i) {
+        EXPECT_EQ(reinterpret_cast<char*>(&batch[i + 1]) - reinterpret_cast<char*>(&batch[i]),
+                  static_cast<std::ptrdiff_t>(sizeof(ConcreteProductA)));
+    }
+    std::size_t visited = 0;
+    for (Product& product : batch) {
+        EXPECT_NE(dynamic_cast<ConcreteProductA*>(&product), nullptr);
+        ++visited;
+    }
+    EXPECT_EQ(visited, batch.size());
+
+    ProductBatch probes = ProductBatch::Create<BatchProbeProduct>(10);
+    EXPECT_EQ(BatchProbeProduct::alive, 10);
+    probes.UseAll();
+    for (Product& product : probes) {
+        product.Use();
+    }
+    for (std::size_t i = 0; i < probes.size(); ++i) {
+        EXPECT_EQ(static_cast<BatchProbeProduct&>(probes[i]).uses, 2);
+    }
+    ProductBatch moved = std::move(probes);
+    EXPECT_TRUE(probes.empty());
+    EXPECT_EQ(moved.size(), 10u);
+    moved = ProductBatch();
+    EXPECT_EQ(BatchProbeProduct::alive, 0);
+
+    // 第 5 次构造抛出异常：已构造的 4 个对象全部析构
+    BatchProbeProduct::constructed = 0;
+    BatchProbeProduct::throw_at = 5;
+    EXPECT_THROW(ProductBatch::Create<BatchProbeProduct>(8), std::runtime_error);
+    BatchProbeProduct::throw_at = -1;
+    EXPECT_EQ(BatchProbeProduct::alive, 0);
+}
+
+// 测试注册表批量创建：按类型注册的产品连续存储，只有工厂函数的产品退化为逐个创建
+TEST(FactoryMethodTest, ProductRegistry_CreateMany) {
+    InitProductRegistry();
+    ProductBatch batch = ProductRegistry::CreateMany("B", 16);
+    ASSERT_EQ(batch.size(), 16u);
+    EXPECT_TRUE(batch.IsContiguous());
+    EXPECT_NE(dynamic_cast<ConcreteProductB*>(&batch[15]), nullptr);
+
+    ProductRegistry::Register("BatchPlain", [] { return MakePooledProduct<BatchProbeProduct>(); });
+    ProductBatch plain = ProductRegistry::CreateMany(ProductRegistry::Lookup("BatchPlain"), 6);
+    ASSERT_EQ(plain.size(), 6u);
+    EXPECT_FALSE(plain.IsContiguous());
+    EXPECT_EQ(BatchProbeProduct::alive, 6);
+    plain.UseAll();
+    for (Product& product : plain) {
+        EXPECT_EQ(static_cast<BatchProbeProduct&>(product).uses, 1);
+    }
+    plain = ProductBatch();
+    EXPECT_EQ(BatchProbeProduct::alive, 0);
+
+    EXPECT_TRUE(ProductRegistry::CreateMany("NonExistent", 4).empty());
+}
+
+// 测试批量创建的长度溢出：n * sizeof(T) 回绕时抛出 bad_array_new_length，而不是分配过小的内存
+TEST(FactoryMethodTest, ProductBatch_RejectsOverflowingCount) {
+    InitProductRegistry();
+    const std::size_t huge = static_cast<std::size_t>(-1) / 2 + 1;
+    EXPECT_THROW(ProductBatch::Create<ConcreteProductA>(huge), std::bad_array_new_length);
+    EXPECT_THROW(ProductRegistry::CreateMany("B", huge), std::bad_array_new_length);
+}
+
+// 测试默认的 Creator::CreateBatch：未覆盖时逐个调用 CreateProduct
+TEST(FactoryMethodTest, CreateBatch_DefaultFallsBackToSingleCreation) {
+    class ProbeCreator : public Creator {
+    public:
+        ProductPtr CreateProduct() const override { return MakePooledProduct<BatchProbeProduct>(); }
+    };
+    ProbeCreator creator;
+    ProductBatch batch = creator.CreateBatch(3);
+    EXPECT_EQ(batch.size(), 3u);
+    EXPECT_FALSE(batch.IsContiguous());
+    EXPECT_EQ(BatchProbeProduct::alive, 3);
+}
+
+// 测试编译期封闭集合工厂：按标签、下标、名字创建，名字查找可在编译期求值
+TEST(FactoryMethodTest, StaticFactory_CreateAndVisit) {
+    static_assert(ProductVariantFactory::Find("A") == 0);
+    static_assert(ProductVariantFactory::Find("B") == 1);
+    static_assert(ProductVariantFactory::Find("C") == ProductVariantFactory::kNotFound);
+    static_assert(ProductVariantFactory::Find("") == ProductVariantFactory::kNotFound);
+
+    auto a = ProductVariantFactory::Create<ConcreteProductA>();
+    EXPECT_TRUE(std::holds_alternative<ConcreteProductA>(a));
+    EXPECT_EQ(ProductVariantFactory::IndexOf(a), 0u);
+
+    auto b = ProductVariantFactory::Create("B");
+    EXPECT_TRUE(std::holds_alternative<ConcreteProductB>(b));
+    EXPECT_EQ(ProductVariantFactory::IndexOf(ProductVariantFactory::Create(std::size_t{1})), 1u);
+    EXPECT_NO_THROW(ProductVariantFactory::Use(b));
+
+    auto missing = ProductVariantFactory::Create("NonExistent");
+    EXPECT_FALSE(ProductVariantFactory::IsValid(missing));
+    EXPECT_EQ(ProductVariantFactory::IndexOf(missing), ProductVariantFactory::kNotFound);
+    EXPECT_NO_THROW(ProductVariantFactory::Use(missing));  // monostate：什么也不做
+    EXPECT_FALSE(ProductVariantFactory::IsValid(ProductVariantFactory::Create(std::size_t{2})));
+}
+
+// StaticFactory 测试使用的产品：不继承 Product，只需要 Use()
+struct VariantLeft {
+    static constexpr std::string_view kTypeName = "left";
+    void Use() { ++uses; }
+    int uses = 0;
+};
+
+// 没有 kTypeName 成员，通过特化 ProductTypeName 提供名字
+struct VariantRight {
+    explicit VariantRight(int start = 100) : uses(start) {}
+    void Use() { uses += 2; }
+    int uses;
+};
+
+template <>
+struct ProductTypeName<VariantRight> {
+    static constexpr std::string_view value = "right";
+};
+
+// 测试 StaticFactory 的分派：Use() 调用到具体类型的实现，产品状态保存在 variant 中
+TEST(FactoryMethodTest, StaticFactory_DispatchesToConcreteUse) {
+    using Factory = StaticFactory<VariantLeft, VariantRight>;
+    static_assert(Factory::Find("right") == 1);
+
+    auto left = Factory::Create("left");
+    auto right = Factory::Create<VariantRight>(10);
+    Factory::Use(left);
+    Factory::Use(left);
+    Factory::Use(right);
+    EXPECT_EQ(std::get<VariantLeft>(left).uses, 2);
+    EXPECT_EQ(std::get<VariantRight>(right).uses, 12);
+    EXPECT_EQ(std::get<VariantRight>(Factory::Create("right")).uses, 100);
+}
+
+// 埋点测试使用的产品（独立的类型名，计数不受其他测试影响）
+class MetricsProbeProduct : public Product {
+public:
+    static constexpr std::string_view kTypeName = "metrics.probe";
+    void Use() override {}
+};
+
+class MetricsExportProduct : public Product {
+public:
+    static constexpr std::string_view kTypeName = "metrics.export";
+    void Use() override {}
+};
+
+const FactoryMetrics::TypeStats* FindTypeStats(const std::vector<FactoryMetrics::TypeStats>& all,
+                                               std::string_view type) {
+    for (const auto& stats : all) {
+        if (stats.type == type) {
+            return &stats;
+        }
+    }
+    return nullptr;
+}
+
+// 测试埋点：关闭时不记录；开启后按注册名统计创建数与耗时、按产品类型统计存活数，多线程分片正确汇总
+TEST(FactoryMethodTest, FactoryMetrics_CountsLiveAndLatency) {
+    auto& metrics = FactoryMetrics::Instance();
+    const ProductHandle probe = ProductRegistry::RegisterType<MetricsProbeProduct>("metrics.probe");
+    metrics.Disable();
+    ProductRegistry::Create(probe);
+    const auto* before = FindTypeStats(metrics.Snapshot(), "metrics.probe");
+    EXPECT_TRUE(before == nullptr || before->created == 0);
+
+    metrics.Enable();
+    FactoryMetrics::SetSamplePeriod(1);  // 每次创建都计时
+    std::vector<ProductPtr> kept;
+    for (int i = 0; i < 10; ++i) {
+        kept.push_back(ProductRegistry::Create(probe));
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([probe] {
+            for (int i = 0; i < 1000; ++i) {
+                ProductRegistry::Create(probe);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    {
+        ProductBatch batch = ProductRegistry::CreateMany(probe, 50);
+        auto all = metrics.Snapshot();
+        const auto* stats = FindTypeStats(all, "metrics.probe");
+        ASSERT_NE(stats, nullptr);
+        EXPECT_EQ(stats->created, 4060u);
+        EXPECT_EQ(stats->live, 60);
+    }
+    kept.clear();
+    auto all = metrics.Snapshot();
+    const auto* stats = FindTypeStats(all, "metrics.probe");
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->destroyed, 4060u);
+    EXPECT_EQ(stats->live, 0);
+    EXPECT_EQ(stats->samples, 4011u);  // 批量创建记一个样本
+    EXPECT_GT(stats->max_ns, 0.0);
+    EXPECT_LE(stats->p50_ns, stats->p99_ns);
+    std::uint64_t bucketed = 0;
+    for (const auto& bucket : stats->buckets) {
+        bucketed += bucket.second;
+    }
+    EXPECT_EQ(bucketed, stats->samples);
+
+    // 返回 make_unique 的工厂函数：按注册名计数与计时，不经过对象池，没有存活数
+    ProductRegistry::Register("metrics.unique", [] { return std::make_unique<MetricsProbeProduct>(); });
+    ProductRegistry::Create("metrics.unique");
+    const auto* unique = FindTypeStats(metrics.Snapshot(), "metrics.unique");
+    ASSERT_NE(unique, nullptr);
+    EXPECT_EQ(unique->created, 1u);
+    EXPECT_EQ(unique->samples, 1u);
+    EXPECT_EQ(unique->live, 0);
+
+    // 对象池工厂按所创建产品的名字统计
+    PooledCreator<ConcreteProductA> creator;
+    const auto* a_before = FindTypeStats(metrics.Snapshot(), "A");
+    const std::uint64_t a0 = a_before != nullptr ? a_before->created : 0;
+    creator.Create();
+    const auto* a = FindTypeStats(metrics.Snapshot(), "A");
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a->created, a0 + 1);
+
+    // 抽样计时：创建数仍然精确，计时样本约为 1/period
+    FactoryMetrics::SetSamplePeriod(16);
+    const std::uint64_t samples_before = FindTypeStats(metrics.Snapshot(), "metrics.probe")->samples;
+    for (int i = 0; i < 1600; ++i) {
+        ProductRegistry::Create(probe);
+    }
+    stats = FindTypeStats(metrics.Snapshot(), "metrics.probe");
+    EXPECT_EQ(stats->created, 4060u + 1600u);
+    EXPECT_EQ(stats->samples - samples_before, 100u);
+    metrics.Disable();
+}
+
+// 自定义工厂：返回 make_unique，以自己的名字计入埋点
+class MetricsUniqueCreator : public Creator {
+public:
+    ProductPtr CreateProduct() const override { return std::make_unique<MetricsProbeProduct>(); }
+
+protected:
+    ProductTraceTag& TraceTag() const override {
+        static ProductTraceTag tag{"metrics.creator"};
+        return tag;
+    }
+};
+
+// 测试埋点覆盖默认的创建路径：注册表按名字 / 句柄创建、内置与自定义的具体工厂
+TEST(FactoryMethodTest, FactoryMetrics_CoversRegistryAndCreators) {
+    auto& metrics = FactoryMetrics::Instance();
+    InitProductRegistry();
+    FactoryMetrics::SetSamplePeriod(1);  // 与其他埋点测试一样每次计时，不改变后续测试的抽样相位
+    metrics.Enable();
+    auto created = [&metrics](std::string_view type) -> std::int64_t {
+        const auto* stats = FindTypeStats(metrics.Snapshot(), type);
+        return stats != nullptr ? static_cast<std::int64_t>(stats->created) : 0;
+    };
+    auto live = [&metrics](std::string_view type) -> std::int64_t {
+        const auto* stats = FindTypeStats(metrics.Snapshot(), type);
+        return stats != nullptr ? stats->live : 0;
+    };
+    const std::int64_t a0 = created("A");
+    const std::int64_t b0 = created("B");
+    const std::int64_t a_live0 = live("A");
+    const std::int64_t custom0 = created("metrics.creator");
+    {
+        ProductPtr by_name = ProductRegistry::Create("A");
+        ProductPtr by_handle = ProductRegistry::Create(ProductRegistry::Lookup("A"));
+        ASSERT_NE(by_name, nullptr);
+        ASSERT_NE(by_handle, nullptr);
+        EXPECT_EQ(created("A") - a0, 2);
+        EXPECT_EQ(live("A") - a_live0, 2);
+
+        ConcreteCreatorB creator;
+        ProductPtr from_creator = creator.Create();
+        creator.AnOperation();
+        EXPECT_EQ(created("B") - b0, 2);
+
+        MetricsUniqueCreator custom;
+        custom.AnOperation();
+        EXPECT_EQ(created("metrics.creator") - custom0, 1);
+    }
+    EXPECT_EQ(live("A"), a_live0);  // 销毁同样被记录
+    metrics.Disable();
+    FactoryMetrics::SetSamplePeriod(16);
+}
+
+// 测试导出：JSON 与 Prometheus 文本格式，写入本地文件
+TEST(FactoryMethodTest, FactoryMetrics_Export) {
+    auto& metrics = FactoryMetrics::Instance();
+    const ProductHandle handle =
+        ProductRegistry::RegisterType<MetricsExportProduct>("metrics.export");
+    FactoryMetrics::SetSamplePeriod(1);
+    metrics.Enable();
+    ProductPtr product = ProductRegistry::Create(handle);
+    metrics.Disable();
+    FactoryMetrics::SetSamplePeriod(16);
+
+    std::string json = metrics.ToJson();
+    EXPECT_NE(json.find("\"type\":\"metrics.export\""), std::string::npos);
+    EXPECT_NE(json.find("\"live\":1"), std::string::npos);
+
+    std::string prom = metrics.ToPrometheus();
+    EXPECT_NE(prom.find("# TYPE factory_products_created_total counter"), std::string::npos);
+    EXPECT_NE(prom.find("factory_products_created_total{type=\"metrics.export\"} 1"),
+              std::string::npos);
+    EXPECT_NE(prom.find("factory_products_live{type=\"metrics.export\"} 1"), std::string::npos);
+    EXPECT_NE(prom.find("factory_create_duration_seconds_bucket{type=\"metrics.export\",le=\"+Inf\"} 1"),
+              std::string::npos);
+    EXPECT_NE(prom.find("factory_create_duration_seconds_count{type=\"metrics.export\"} 1"),
+              std::string::npos);
+
+    const std::string path = ::testing::TempDir() + "factory_metrics.prom";
+    ASSERT_TRUE(metrics.WritePrometheus(path));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), metrics.ToPrometheus());
+    std::remove(path.c_str());
+}
+
+// 测试直方图分桶：桶号单调、上界覆盖样本，相邻桶的相对宽度不超过 1/8
+TEST(FactoryMethodTest, FactoryMetrics_HistogramBuckets) {
+    std::size_t previous = 0;
+    for (std::uint64_t v = 0; v < (1u << 20); v += 1 + v / 64) {
+        std::size_t bucket = FactoryMetrics::BucketOf(v);
+        EXPECT_GE(bucket, previous);
+        EXPECT_LT(v, FactoryMetrics::BucketUpper(bucket));
+        if (bucket >= FactoryMetrics::kSubBuckets) {
+            std::uint64_t upper = FactoryMetrics::BucketUpper(bucket);
+            std::uint64_t lower = FactoryMetrics::BucketUpper(bucket - 1);
+            EXPECT_LE(v, upper);
+            EXPECT_GE(v, lower);
+            EXPECT_LE(static_cast<double>(upper - lower) / static_cast<double>(lower), 0.125 + 1e-9);
+        }
+        previous = bucket;
+    }
+    EXPECT_EQ(FactoryMetrics::BucketOf(~0ull), FactoryMetrics::kBuckets - 1);
+}
+
+// 测试插件延迟注册：注册时不加载共享库，第一次创建时加载，之后与普通注册的类型一样创建
+TEST(FactoryMethodTest, ProductRegistry_LazyPlugin) {
+    const std::string path = FACTORY_METHOD_PLUGIN_PATH;
+    PluginLibrary& library = PluginLibrary::Get(path);
+    const ProductHandle c = RegisterProductPlugin("plugin.C", path);
+    const ProductHandle d = RegisterProductPlugin("plugin.D", path);
+    ASSERT_TRUE(c.IsValid());
+    ASSERT_TRUE(d.IsValid());
+    EXPECT_FALSE(library.IsLoaded());
+
+    // 插件与宿主共享埋点单例：插件中创建的产品也按类型计数
+    auto& metrics = FactoryMetrics::Instance();
+    metrics.Enable();
+    ProductPtr product = ProductRegistry::Create(c);
+    metrics.Disable();
+    ASSERT_NE(product, nullptr);
+    EXPECT_TRUE(library.IsLoaded());
+    product->Use();
+    const auto* stats = FindTypeStats(metrics.Snapshot(), "plugin.C");
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->live, 1);
+
+    // 冻结后：已解析的条目换成直接的工厂函数，未解析的仍在首次创建时解析
+    ProductRegistry::Freeze();
+    EXPECT_EQ(ProductRegistry::Lookup("plugin.C").index, c.index);
+    EXPECT_NE(ProductRegistry::Create("plugin.C"), nullptr);
+    ProductBatch batch = ProductRegistry::CreateMany(d, 8);
+    EXPECT_EQ(batch.size(), 8u);
+    EXPECT_TRUE(batch.IsContiguous());
+    EXPECT_NE(ProductRegistry::Create(d), nullptr);
+
+    // 库中没有的类型、无法加载的库：与未注册的类型一样返回空
+    RegisterProductPlugin("plugin.unknown", path);
+    EXPECT_EQ(ProductRegistry::Create("plugin.unknown"), nullptr);
+    const std::string missing = "/nonexistent/factory_method_missing_plugin.so";
+    RegisterProductPlugin("plugin.missing", missing);
+    EXPECT_EQ(ProductRegistry::Create("plugin.missing"), nullptr);
+    EXPECT_EQ(ProductRegistry::CreateMany("plugin.missing", 4).size(), 0u);
+    EXPECT_FALSE(PluginLibrary::Get(missing).IsLoaded());
+    EXPECT_FALSE(PluginLibrary::Get(missing).Error().empty());
+}
+
+// 测试延迟注册的解析不持有注册表的锁：resolve() 中可以注册别的类型，其他线程也能同时创建
+// （单进程运行全部测试时注册表可能已被前面的测试冻结，此时走的是无锁路径）
+TEST(FactoryMethodTest, ProductRegistry_DeferredResolveOutsideLock) {
+    InitProductRegistry();
+    std::atomic<bool> other_created{false};
+    ProductRegistry::RegisterDeferred("deferred.Reentrant", [&other_created] {
+        ProductRegistry::RegisterType<ConcreteProductB>("deferred.Extra");
+        std::thread other([&other_created] {
+            other_created.store(ProductRegistry::Create("A") != nullptr);
+        });
+        other.join();
+        return ProductRegistry::Factories{[] { return MakePooledProduct<ConcreteProductA>(); },
+                                          nullptr};
+    });
+
+    ProductPtr product = ProductRegistry::Create("deferred.Reentrant");
+    ASSERT_NE(product, nullptr);
+    EXPECT_NE(dynamic_cast<ConcreteProductA*>(product.get()), nullptr);
+    EXPECT_TRUE(other_created.load());
+    EXPECT_NE(ProductRegistry::Create("deferred.Extra"), nullptr);
+    // 解析之后换成直接的工厂函数，不再经过 binding
+    EXPECT_EQ(ProductRegistry::CreateMany("deferred.Reentrant", 3).size(), 3u);
+}
+
+// 测试延迟条目在首次创建完成前被重新注册（这里由 resolve() 内部注册）：换成直接的工厂函数时
+// 不覆盖较新的注册
+TEST(FactoryMethodTest, ProductRegistry_DeferredKeepsLaterRegistration) {
+    const ProductHandle handle = ProductRegistry::RegisterDeferred("deferred.Replaced", [] {
+        ProductRegistry::RegisterType<ConcreteProductB>("deferred.Replaced");
+        return ProductRegistry::Factories{[] { return MakePooledProduct<ConcreteProductA>(); },
+                                          nullptr};
+    });
+
+    // 本次创建使用解析结果，之后按名字 / 句柄创建的都是较新注册的 B
+    EXPECT_NE(dynamic_cast<ConcreteProductA*>(ProductRegistry::Create(handle).get()), nullptr);
+    EXPECT_NE(dynamic_cast<ConcreteProductB*>(ProductRegistry::Create("deferred.Replaced").get()),
+              nullptr);
+    EXPECT_NE(dynamic_cast<ConcreteProductB*>(ProductRegistry::Create(handle).get()), nullptr);
+    EXPECT_EQ(ProductRegistry::Lookup("deferred.Replaced").index, handle.index);
+}
+
+// 测试立即加载插件：注册库中导出的全部类型
+TEST(FactoryMethodTest, ProductRegistry_LoadPlugin) {
+    EXPECT_EQ(LoadProductPlugin(FACTORY_METHOD_PLUGIN_PATH), 2u);
+    EXPECT_TRUE(PluginLibrary::Get(FACTORY_METHOD_PLUGIN_PATH).IsLoaded());
+    EXPECT_NE(ProductRegistry::Create("plugin.D"), nullptr);
+    EXPECT_EQ(LoadProductPlugin("/nonexistent/factory_method_missing_plugin.so"), 0u);
+}
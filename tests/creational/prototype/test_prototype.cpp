@@ -1,5 +1,14 @@
 #include "../../../src/creational/prototype/Prototype.h"
+#include "../../../src/creational/prototype/PrototypePool.h"
 #include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 // 原型模式测试套件
 
@@ -81,4 +90,371 @@ TEST(PrototypeTest, Prototype_ShowMethod) {
     
     auto cloned = prototype->Clone();
     EXPECT_NO_THROW(cloned->Show());
-}
\ No newline at end of file
+}
+// 测试写时复制原型：克隆共享状态块，第一次修改时才复制，修改互不影响
+TEST(PrototypeTest, CowPrototype_SharesUntilFirstWrite) {
+    const std::string long_name(100, 'n');  // 超过 SSO 长度
+    CowConcretePrototype original(long_name, 1);
+    auto clone = original.Clone();
+    auto& copy = static_cast<CowConcretePrototype&>(*clone);
+
+    EXPECT_TRUE(copy.SharesStateWith(original));
+    EXPECT_EQ(copy.Name().data(), original.Name().data());  // 没有复制字符串
+    EXPECT_EQ(copy.Value(), 1);
+
+    copy.SetValue(2);
+    EXPECT_FALSE(copy.SharesStateWith(original));
+    EXPECT_EQ(copy.Value(), 2);
+    EXPECT_EQ(original.Value(), 1);
+    EXPECT_EQ(copy.Name(), long_name);
+    EXPECT_NE(copy.Name().data(), original.Name().data());
+
+    // 已独占时再次修改不再复制
+    const char* before = copy.Name().data();
+    copy.SetValue(3);
+    EXPECT_EQ(copy.Name().data(), before);
+
+    // 克隆的克隆同样共享；原对象修改时，原对象复制，克隆保持原值
+    auto second = copy.Clone();
+    auto& second_copy = static_cast<CowConcretePrototype&>(*second);
+    EXPECT_TRUE(second_copy.SharesStateWith(copy));
+    copy.SetName("renamed");
+    EXPECT_EQ(second_copy.Name(), long_name);
+    EXPECT_EQ(copy.Name(), "renamed");
+}
+
+// 测试 CowPtr：引用计数、赋值与销毁
+TEST(PrototypeTest, CowPtr_CountsReferences) {
+    CowPtr<std::string> a(std::string("shared"));
+    EXPECT_FALSE(a.IsShared());
+    {
+        CowPtr<std::string> b = a;
+        EXPECT_TRUE(a.IsShared());
+        EXPECT_TRUE(b.SharesWith(a));
+        CowPtr<std::string> c(std::string("other"));
+        c = b;
+        EXPECT_EQ(*c, "shared");
+        c.Mutable() += "!";
+        EXPECT_EQ(*c, "shared!");
+        EXPECT_EQ(*a, "shared");
+        CowPtr<std::string> d = std::move(b);
+        EXPECT_TRUE(d.SharesWith(a));
+        EXPECT_TRUE(b.SharesWith(a));  // 移动等同于拷贝，b 仍然有效
+        EXPECT_EQ(*b, "shared");
+        c = std::move(d);
+        EXPECT_TRUE(d.SharesWith(a));
+        EXPECT_TRUE(c.SharesWith(a));
+        CowPtr<std::string>& self = a;
+        a = self;  // 自赋值
+        EXPECT_TRUE(a.IsShared());
+    }
+    EXPECT_FALSE(a.IsShared());  // 其余句柄已销毁
+}
+
+// 测试被移动后的写时复制原型：仍可克隆、读取、显示与修改，不影响移动的目标
+TEST(PrototypeTest, CowPrototype_UsableAfterMove) {
+    CowConcretePrototype source("moved", 7);
+    CowConcretePrototype target(std::move(source));
+    EXPECT_EQ(target.Name(), "moved");
+
+    auto clone = source.Clone();
+    EXPECT_EQ(static_cast<CowConcretePrototype&>(*clone).Value(), 7);
+    EXPECT_EQ(source.Name(), "moved");
+    std::ostringstream out;
+    std::streambuf* console = std::cout.rdbuf(out.rdbuf());
+    source.Show();
+    std::cout.rdbuf(console);
+    EXPECT_EQ(out.str(), "ConcretePrototype{name=moved, value=7}\n");
+
+    CowConcretePrototype assigned("other", 1);
+    assigned = std::move(target);
+    target.SetValue(8);
+    EXPECT_EQ(target.Value(), 8);
+    EXPECT_EQ(assigned.Value(), 7);
+    EXPECT_EQ(source.Value(), 7);
+}
+
+// 测试写时复制原型与深拷贝原型的输出一致
+TEST(PrototypeTest, CowPrototype_ShowMatchesDeepCopy) {
+    ConcretePrototype deep("origin", 42);
+    CowConcretePrototype cow("origin", 42);
+    std::ostringstream deep_out;
+    std::ostringstream cow_out;
+    std::streambuf* console = std::cout.rdbuf(deep_out.rdbuf());
+    deep.Clone()->Show();
+    std::cout.rdbuf(cow_out.rdbuf());
+    cow.Clone()->Show();
+    std::cout.rdbuf(console);
+    EXPECT_EQ(deep_out.str(), cow_out.str());
+    EXPECT_EQ(cow_out.str(), "ConcretePrototype{name=origin, value=42}\n");
+}
+
+namespace {
+
+struct PointPayload {
+    double x;
+    double y;
+    int tag;
+};
+
+class PointPrototype final : public TrivialPrototype<PointPrototype, PointPayload> {
+public:
+    using TrivialPrototype::TrivialPrototype;
+    explicit PointPrototype(const PointPayload& payload) : TrivialPrototype(payload) {}
+    void Show() const override { std::cout << "Point{" << Data().x << ", " << Data().y << "}\n"; }
+};
+
+// 没有继承基类构造函数：批量克隆逐个拷贝构造
+class PlainPointPrototype final : public TrivialPrototype<PlainPointPrototype, PointPayload> {
+public:
+    explicit PlainPointPrototype(const PointPayload& payload) : TrivialPrototype(payload) {}
+    void Show() const override {}
+};
+
+// 只实现 Clone() 与 Show() 的原型：批量克隆使用 Prototype 的默认实现
+class LegacyPrototype final : public Prototype {
+public:
+    explicit LegacyPrototype(int value) : value(value) {}
+    std::unique_ptr<Prototype> Clone() const override {
+        return std::make_unique<LegacyPrototype>(*this);
+    }
+    void Show() const override {}
+
+    int value;
+};
+
+// 第 fail_at 次拷贝时抛出异常，统计存活对象数
+class ThrowingPrototype final : public Prototype {
+public:
+    static inline int live = 0;
+    static inline int copies = 0;
+    static inline int fail_at = -1;
+
+    ThrowingPrototype() { ++live; }
+    ThrowingPrototype(const ThrowingPrototype&) {
+        if (copies++ == fail_at) {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+    ~ThrowingPrototype() override { --live; }
+
+    std::unique_ptr<Prototype> Clone() const override {
+        return std::make_unique<ThrowingPrototype>(*this);
+    }
+    void Show() const override {}
+    std::size_t CloneSize() const override { return sizeof(ThrowingPrototype); }
+    std::size_t CloneAlign() const override { return alignof(ThrowingPrototype); }
+    Prototype* CloneInto(void* storage, std::size_t n) const override {
+        return CloneCopiesInto(*this, storage, n);
+    }
+};
+
+}  // namespace
+
+// 测试 CloneN：克隆连续存放、彼此独立，析构后释放
+TEST(PrototypeTest, CloneN_ContiguousIndependentClones) {
+    std::unique_ptr<Prototype> prototype =
+        std::make_unique<ConcretePrototype>(std::string(40, 'n'), 7);
+    PrototypeBatch batch = prototype->CloneN(5);
+    ASSERT_EQ(batch.Size(), 5u);
+    EXPECT_EQ(batch.Stride(), sizeof(ConcretePrototype));
+    for (std::size_t i = 0; i < batch.Size(); ++i) {
+        auto& clone = static_cast<ConcretePrototype&>(batch[i]);
+        EXPECT_EQ(clone.Name(), std::string(40, 'n'));
+        EXPECT_EQ(clone.Value(), 7);
+        if (i > 0) {
+            auto* prev = reinterpret_cast<const char*>(&batch[i - 1]);
+            auto* curr = reinterpret_cast<const char*>(&batch[i]);
+            EXPECT_EQ(curr - prev, static_cast<std::ptrdiff_t>(batch.Stride()));
+        }
+    }
+    static_cast<ConcretePrototype&>(batch[2]).SetValue(9);
+    EXPECT_EQ(static_cast<ConcretePrototype&>(batch[1]).Value(), 7);
+    EXPECT_EQ(static_cast<ConcretePrototype&>(*prototype).Value(), 7);
+
+    PrototypeBatch moved = std::move(batch);
+    EXPECT_TRUE(batch.Empty());
+    EXPECT_EQ(moved.Size(), 5u);
+    EXPECT_TRUE(prototype->CloneN(0).Empty());
+
+    // 写时复制原型的批量克隆共享同一个状态块
+    CowConcretePrototype cow("cow", 1);
+    PrototypeBatch cows = cow.CloneN(3);
+    for (std::size_t i = 0; i < cows.Size(); ++i) {
+        EXPECT_TRUE(static_cast<CowConcretePrototype&>(cows[i]).SharesStateWith(cow));
+    }
+}
+
+// 测试状态可平凡复制的原型：载荷逐个 memcpy 进每个克隆，结果与 Clone() 一致
+TEST(PrototypeTest, CloneN_TrivialPayload) {
+    PointPrototype origin(PointPayload{1.5, -2.0, 3});
+    for (std::size_t n : {1u, 3u, 1000u, 5000u}) {
+        PrototypeBatch batch = origin.CloneN(n);
+        ASSERT_EQ(batch.Size(), n);
+        for (std::size_t i = 0; i < batch.Size(); ++i) {
+            const auto& point = static_cast<const PointPrototype&>(batch[i]);
+            ASSERT_EQ(point.Data().x, 1.5);
+            ASSERT_EQ(point.Data().y, -2.0);
+            ASSERT_EQ(point.Data().tag, 3);
+            ASSERT_NE(dynamic_cast<const PointPrototype*>(&batch[i]), nullptr);
+        }
+    }
+    PrototypeBatch batch = origin.CloneN(1000);
+    static_cast<PointPrototype&>(batch[10]).MutableData().tag = 4;
+    EXPECT_EQ(static_cast<const PointPrototype&>(batch[11]).Data().tag, 3);
+    EXPECT_EQ(origin.Data().tag, 3);
+
+    // 没有继承空壳构造函数的派生类走逐个拷贝构造
+    PlainPointPrototype plain(PointPayload{0.5, 4.0, 9});
+    PrototypeBatch plains = plain.CloneN(7);
+    for (std::size_t i = 0; i < plains.Size(); ++i) {
+        ASSERT_EQ(static_cast<const PlainPointPrototype&>(plains[i]).Data().tag, 9);
+    }
+}
+
+// 测试只实现 Clone() 的原型：CloneN 退回到逐个 Clone()，CloneInto 明确拒绝
+TEST(PrototypeTest, CloneN_FallsBackToClone) {
+    LegacyPrototype origin(5);
+    EXPECT_EQ(origin.CloneSize(), 0u);
+    PrototypeBatch batch = origin.CloneN(4);
+    ASSERT_EQ(batch.Size(), 4u);
+    EXPECT_EQ(batch.Stride(), 0u);
+    for (std::size_t i = 0; i < batch.Size(); ++i) {
+        EXPECT_EQ(static_cast<LegacyPrototype&>(batch[i]).value, 5);
+    }
+    static_cast<LegacyPrototype&>(batch[0]).value = 6;
+    EXPECT_EQ(static_cast<LegacyPrototype&>(batch[1]).value, 5);
+    PrototypeBatch moved = std::move(batch);
+    EXPECT_EQ(moved.Size(), 4u);
+    EXPECT_TRUE(batch.Empty());
+
+    alignas(std::max_align_t) unsigned char storage[64];
+    EXPECT_THROW(origin.CloneInto(storage, 1), std::logic_error);
+}
+
+// 测试 CloneInto：中途拷贝失败时已构造的克隆被析构，CloneN 释放内存并重新抛出
+TEST(PrototypeTest, CloneInto_RollsBackOnThrow) {
+    {
+        ThrowingPrototype prototype;
+        ThrowingPrototype::copies = 0;
+        ThrowingPrototype::fail_at = 3;
+        EXPECT_THROW(prototype.CloneN(8), std::runtime_error);
+        EXPECT_EQ(ThrowingPrototype::live, 1);
+
+        ThrowingPrototype::fail_at = -1;
+        {
+            PrototypeBatch batch = prototype.CloneN(8);
+            EXPECT_EQ(ThrowingPrototype::live, 9);
+        }
+        EXPECT_EQ(ThrowingPrototype::live, 1);
+    }
+    EXPECT_EQ(ThrowingPrototype::live, 0);
+}
+
+namespace {
+
+// 轮询等待 condition 成立（后台线程补充），最多约 5 秒
+template <typename Condition>
+bool WaitFor(Condition condition) {
+    for (int i = 0; i < 5000 && !condition(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+}  // namespace
+
+// 测试原型池：注册时预热，Acquire 从池中取出与原型相同的克隆
+TEST(PrototypeTest, PrototypePool_PrewarmsAndServesClones) {
+    PrototypePool pool;
+    const std::size_t id =
+        pool.Register("order", std::make_unique<ConcretePrototype>("order", 5), 8);
+    EXPECT_EQ(pool.Size(), 1u);
+    EXPECT_EQ(pool.Find("order"), id);
+    EXPECT_EQ(pool.Find("missing"), PrototypePool::npos);
+    EXPECT_EQ(pool.GetStats(id).ready, 8u);
+
+    std::unique_ptr<Prototype> clone = pool.Acquire(id);
+    ASSERT_NE(clone, nullptr);
+    auto& order = static_cast<ConcretePrototype&>(*clone);
+    EXPECT_EQ(order.Name(), "order");
+    EXPECT_EQ(order.Value(), 5);
+    EXPECT_EQ(pool.GetStats(id).hits, 1u);
+    EXPECT_EQ(pool.GetStats(id).misses, 0u);
+
+    EXPECT_THROW(pool.Register("order", std::make_unique<ConcretePrototype>("x", 1), 4),
+                 std::invalid_argument);
+    EXPECT_THROW(pool.Register("empty", nullptr, 4), std::invalid_argument);
+    EXPECT_THROW(pool.Register("zero", std::make_unique<ConcretePrototype>("x", 1), 0),
+                 std::invalid_argument);
+}
+
+// 测试原型池：取空后退回到直接克隆，后台线程把池子补满
+TEST(PrototypeTest, PrototypePool_ReplenishesInBackground) {
+    PrototypePool pool;
+    const std::size_t id = pool.Register(
+        "burst", std::make_unique<ConcretePrototype>(std::string(40, 'b'), 9), 16, 8);
+
+    std::vector<std::unique_ptr<Prototype>> taken;
+    for (int i = 0; i < 40; ++i) {
+        taken.push_back(pool.Acquire(id));
+        ASSERT_EQ(static_cast<ConcretePrototype&>(*taken.back()).Value(), 9);
+    }
+    PrototypePool::Stats stats = pool.GetStats(id);
+    EXPECT_EQ(stats.hits + stats.misses, 40u);
+    EXPECT_GE(stats.hits, 16u);
+
+    // 前 16 次至少取走了 16 个，停止取用后池中数量最终不低于低水位 8：后台至少补充了 8 个
+    EXPECT_TRUE(WaitFor([&] { return pool.GetStats(id).ready >= 8; }));
+    EXPECT_GE(pool.GetStats(id).refilled, 8u);
+
+    // 池中只剩低水位以下时，后台会补满
+    while (pool.GetStats(id).ready >= 8) {
+        taken.push_back(pool.Acquire(id));
+    }
+    EXPECT_TRUE(WaitFor([&] { return pool.GetStats(id).ready == 16; }));
+}
+
+// 测试原型池：多线程并发取用，同一个克隆不会被取出两次
+TEST(PrototypeTest, PrototypePool_ConcurrentAcquire) {
+    PrototypePool pool;
+    const std::size_t small =
+        pool.Register("small", std::make_unique<ConcretePrototype>("s", 1), 32);
+    const std::size_t large =
+        pool.Register("large", std::make_unique<ConcretePrototype>(std::string(64, 'l'), 2), 64);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    std::vector<std::vector<std::unique_ptr<Prototype>>> taken(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                const std::size_t id = (i + t) % 2 == 0 ? small : large;
+                taken[t].push_back(pool.Acquire(id));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<const Prototype*> distinct;
+    for (const auto& list : taken) {
+        for (const auto& object : list) {
+            const int value = static_cast<const ConcretePrototype&>(*object).Value();
+            EXPECT_TRUE(value == 1 || value == 2);
+            distinct.insert(object.get());
+        }
+    }
+    EXPECT_EQ(distinct.size(), static_cast<std::size_t>(kThreads * kPerThread));
+    const PrototypePool::Stats a = pool.GetStats(small);
+    const PrototypePool::Stats b = pool.GetStats(large);
+    EXPECT_EQ(a.hits + a.misses + b.hits + b.misses,
+              static_cast<std::size_t>(kThreads * kPerThread));
+    // 只在低于低水位（默认容量的一半）时补充，停止取用后池中数量最终不低于低水位
+    EXPECT_TRUE(WaitFor([&] {
+        return pool.GetStats(small).ready >= 16 && pool.GetStats(large).ready >= 32;
+    }));
+}
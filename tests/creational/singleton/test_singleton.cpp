@@ -1,9 +1,23 @@
 #include "../../../src/creational/singleton/Singletons.h"  // 更新头文件路径
+#include "../../../src/creational/singleton/RcuSingleton.h"
+#include "../../../src/creational/singleton/ServiceRegistry.h"
+#include "../../../src/creational/singleton/ShardedSingleton.h"
+#include "../../../src/creational/singleton/SingletonTemplate.h"
 #include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
 #include <thread>
 #include <mutex>
+#include <stdexcept>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
 // 测试懒汉式单例（不安全版本）
 TEST(SingletonTest, LazySingletonUnsafe) {
     auto* instance1 = LazySingletonUnsafe::Instance();
@@ -70,6 +84,25 @@ TEST(SingletonTest, MeyersSingleton) {
     instance2.Log("Test message from instance2");
 }
 
+// 测试常量初始化单例：编译期可构造，多线程下共享同一实例与状态
+TEST(SingletonTest, ConstinitSingleton) {
+    static_assert(IsConstantInitializable<ConstinitSingleton>::value,
+                  "ConstinitSingleton must stay constant-initializable");
+    auto& instance1 = ConstinitSingleton::Instance();
+    auto& instance2 = ConstinitSingleton::Instance();
+    EXPECT_EQ(&instance1, &instance2);
+
+    std::uint64_t before = instance1.LogCount();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() { ConstinitSingleton::Instance().Log("Test message"); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(instance2.LogCount(), before + 4);
+}
+
 // 测试原子操作单例
 TEST(SingletonTest, AtomicSingleton) {
     auto instance1 = AtomicSingleton::Instance();
@@ -81,6 +114,76 @@ TEST(SingletonTest, AtomicSingleton) {
     instance2->Log("Test message from instance2");
 }
 
+// 测试原子操作单例：所有引用释放后实例销毁，再次访问时重建
+TEST(SingletonTest, AtomicSingleton_DiesWhenUnused) {
+    AtomicSingleton::Instance();
+    EXPECT_FALSE(AtomicSingleton::Alive());
+
+    auto instance = AtomicSingleton::Instance();
+    ASSERT_NE(instance, nullptr);
+    EXPECT_TRUE(AtomicSingleton::Alive());
+    EXPECT_EQ(AtomicSingleton::Instance().get(), instance.get());
+
+    instance.reset();
+    EXPECT_FALSE(AtomicSingleton::Alive());
+}
+
+// 测试原子操作单例：多个线程持有引用时共享同一实例，线程租约不会延长实例寿命
+TEST(SingletonTest, AtomicSingleton_SharedAcrossThreads) {
+    auto main_ref = AtomicSingleton::Instance();
+
+    const int num_threads = 8;
+    std::vector<std::shared_ptr<AtomicSingleton>> handed_out(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([i, &handed_out]() {
+            for (int k = 0; k < 1000; ++k) {
+                auto tmp = AtomicSingleton::Instance();
+            }
+            // 返回值交给其他线程持有：租约所在线程退出后引用仍然有效
+            handed_out[i] = AtomicSingleton::Instance();
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (const auto& ref : handed_out) {
+        EXPECT_EQ(ref.get(), main_ref.get());
+    }
+
+    // 主线程释放后，其他线程交出的引用仍让实例存活，重新获取得到的还是同一实例
+    auto* original = main_ref.get();
+    main_ref.reset();
+    EXPECT_TRUE(AtomicSingleton::Alive());
+    EXPECT_EQ(AtomicSingleton::Instance().get(), original);
+
+    handed_out.clear();
+    EXPECT_FALSE(AtomicSingleton::Alive());
+}
+
+// 测试原子操作单例：同一线程先 one-shot 调用、再持有引用，返回的都是同一实例且不延长寿命
+TEST(SingletonTest, AtomicSingleton_OneShotThenHeld) {
+    auto main_ref = AtomicSingleton::Instance();
+    AtomicSingleton* original = main_ref.get();
+    std::thread t([original]() {
+        // one-shot：取用后立即丢弃，慢速路径改为直接返回全局强引用
+        for (int i = 0; i < 200; ++i) {
+            EXPECT_EQ(AtomicSingleton::Instance().get(), original);
+        }
+        // 改为持有引用后仍然正确（每隔一段时间会重新建租约）
+        auto held = AtomicSingleton::Instance();
+        for (int i = 0; i < 200; ++i) {
+            EXPECT_EQ(AtomicSingleton::Instance().get(), original);
+        }
+        EXPECT_EQ(held.get(), original);
+    });
+    t.join();
+
+    main_ref.reset();
+    EXPECT_FALSE(AtomicSingleton::Alive());
+}
+
 // 线程安全测试
 TEST(SingletonTest, ThreadSafety) {
     const int num_threads = 10;
@@ -110,6 +213,570 @@ TEST(SingletonTest, ThreadSafety) {
     }
 }
 
+// 通用单例模板使用的测试类型：构造函数私有，只允许 SingletonAccess 构造
+class TemplateConfig {
+    friend class SingletonAccess;
+    TemplateConfig() = default;
+
+public:
+    int value = 0;
+};
+
+class ConstantConfig {
+    friend class SingletonAccess;
+    constexpr ConstantConfig() = default;
+
+public:
+    int value = 7;
+};
+
+class NonConstantConfig {
+    friend class SingletonAccess;
+    NonConstantConfig() : value(1) {}
+
+public:
+    int value;
+};
+
+static_assert(IsConstantInitializable<ConstantConfig>::value, "constexpr ctor should qualify");
+static_assert(!IsConstantInitializable<NonConstantConfig>::value, "runtime ctor must be rejected");
+static_assert(!IsConstantInitializable<std::string>::value, "non-literal type must be rejected");
+
+using MeyersConfig = Singleton<TemplateConfig, MeyersInit>;
+using CallOnceConfig = Singleton<TemplateConfig, CallOnceInit>;
+using DCLConfig = Singleton<TemplateConfig, DCLInit>;
+using AtExitConfig = Singleton<TemplateConfig, MeyersInit, DestroyAtExitLifetime>;
+using EagerConfig = Singleton<ConstantConfig, EagerInit>;
+using WeakConfig = Singleton<TemplateConfig, WeakRefInit>;
+
+// 测试通用单例模板：每种初始化策略都只产生一个实例
+TEST(SingletonTest, Template_EachPolicyReturnsSameInstance) {
+    EXPECT_EQ(&MeyersConfig::Instance(), &MeyersConfig::Instance());
+    EXPECT_EQ(&CallOnceConfig::Instance(), &CallOnceConfig::Instance());
+    EXPECT_EQ(&DCLConfig::Instance(), &DCLConfig::Instance());
+    EXPECT_EQ(&AtExitConfig::Instance(), &AtExitConfig::Instance());
+    EXPECT_EQ(&EagerConfig::Instance(), &EagerConfig::Instance());
+
+    // 不同策略是相互独立的单例
+    EXPECT_NE(&CallOnceConfig::Instance(), &DCLConfig::Instance());
+}
+
+// 测试常量初始化的饿汉式策略：实例在任何动态初始化之前就已就绪
+TEST(SingletonTest, Template_EagerInitIsConstantInitialized) {
+    auto& config = EagerConfig::Instance();
+    EXPECT_EQ(config.value, 7);
+    config.value = 8;
+    EXPECT_EQ(EagerConfig::Instance().value, 8);
+}
+
+// 测试线程局部缓存指针与策略返回同一实例
+TEST(SingletonTest, Template_CachedInstanceMatchesInstance) {
+    auto* expected = &DCLConfig::Instance();
+    EXPECT_EQ(&DCLConfig::CachedInstance(), expected);
+
+    TemplateConfig* from_thread = nullptr;
+    std::thread t([&from_thread]() { from_thread = &DCLConfig::CachedInstance(); });
+    t.join();
+    EXPECT_EQ(from_thread, expected);
+}
+
+// 测试弱引用策略：无人使用时销毁，按需重建
+TEST(SingletonTest, Template_WeakRefInitDiesWhenUnused) {
+    auto first = WeakConfig::Instance();
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(WeakConfig::Policy::Alive());
+    EXPECT_EQ(WeakConfig::Instance().get(), first.get());
+
+    first.reset();
+    EXPECT_FALSE(WeakConfig::Policy::Alive());
+    EXPECT_NE(WeakConfig::Instance(), nullptr);
+}
+
+// 并发首次访问测试使用的类型：统计构造次数
+struct ConstructionProbe {
+    friend class SingletonAccess;
+    ConstructionProbe() { constructed.fetch_add(1); }
+    inline static std::atomic<int> constructed{0};
+};
+
+// 测试通用单例模板在并发首次访问下只创建一个实例
+TEST(SingletonTest, Template_ConcurrentFirstAccess) {
+    using Probe = ConstructionProbe;
+    using ProbeSingleton = Singleton<Probe, CallOnceInit>;
+
+    const int num_threads = 8;
+    std::vector<std::thread> threads;
+    std::vector<Probe*> instances(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([i, &instances]() { instances[i] = &ProbeSingleton::Instance(); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(Probe::constructed.load(), 1);
+    for (auto* p : instances) {
+        EXPECT_EQ(p, instances[0]);
+    }
+}
+
+// 分片单例测试使用的 Tag 与自定义 Reducer
+struct ShardedSumTag {};
+struct ShardedMinMaxTag {};
+struct ShardedResetTag {};
+
+struct BitOrReducer {
+    static constexpr unsigned Identity() { return 0u; }
+    constexpr unsigned operator()(unsigned a, unsigned b) const { return a | b; }
+};
+
+// 测试分片单例：多线程累加后合并结果准确
+TEST(SingletonTest, ShardedSingleton_SumAcrossThreads) {
+    using Counter = ShardedSingleton<std::uint64_t, SumReducer<std::uint64_t>, ShardedSumTag>;
+    EXPECT_EQ(&Counter::Instance(), &Counter::Instance());
+    EXPECT_GE(Counter::Instance().ShardCount(), 1u);
+
+    const int num_threads = 8;
+    const int per_thread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < per_thread; ++i) {
+                Counter::Instance().Update(1);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(Counter::Instance().Read(), static_cast<std::uint64_t>(num_threads * per_thread));
+}
+
+// 测试分片单例：最小值/最大值/自定义合并
+TEST(SingletonTest, ShardedSingleton_MinMaxAndCustomReducer) {
+    using Low = ShardedSingleton<int, MinReducer<int>, ShardedMinMaxTag>;
+    using High = ShardedSingleton<int, MaxReducer<int>, ShardedMinMaxTag>;
+    using Flags = ShardedSingleton<unsigned, BitOrReducer, ShardedMinMaxTag>;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t]() {
+            for (int v = -100 * t; v <= 100 * t; ++v) {
+                Low::Instance().Update(v);
+                High::Instance().Update(v);
+            }
+            Flags::Instance().Update(1u << t);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(Low::Instance().Read(), -300);
+    EXPECT_EQ(High::Instance().Read(), 300);
+    EXPECT_EQ(Flags::Instance().Read(), 0xFu);
+}
+
+// 测试分片单例：Reset 之后恢复为单位元，且不同 Tag 互不影响
+TEST(SingletonTest, ShardedSingleton_ResetAndTagIsolation) {
+    using A = ShardedSingleton<long, SumReducer<long>, ShardedResetTag>;
+    using B = ShardedSingleton<long, SumReducer<long>, ShardedSumTag>;
+    A::Instance().Update(5);
+    B::Instance().Update(7);
+    EXPECT_EQ(A::Instance().Read(), 5);
+
+    A::Instance().Reset();
+    EXPECT_EQ(A::Instance().Read(), 0);
+    EXPECT_EQ(B::Instance().Read(), 7);
+}
+
+// RCU 单例测试用的配置：析构时把字段写成毒值，读者若看到毒值说明读到了已回收的版本
+struct RcuTestConfig {
+    std::uint64_t version = 0;
+    std::uint64_t checksum = 1;  // 恒等于 version * 2 + 1
+    std::string name = "v0";
+
+    ~RcuTestConfig() {
+        destroyed.fetch_add(1, std::memory_order_relaxed);
+        version = 0xDEADDEAD;
+        checksum = 0;
+    }
+
+    static std::atomic<int> destroyed;
+};
+std::atomic<int> RcuTestConfig::destroyed{0};
+
+struct RcuStressTag {};
+struct RcuBasicTag {};
+
+// 测试 RCU 单例：更新后新读者看到新版本，旧快照在 guard 存活期间保持不变，之后被回收
+TEST(SingletonTest, RcuSingleton_UpdateAndReclaim) {
+    using Config = RcuSingleton<RcuTestConfig, RcuBasicTag>;
+    auto& rcu = Config::Instance();
+    EXPECT_EQ(&rcu, &Config::Instance());
+    EXPECT_EQ(rcu.Read()->name, "v0");
+
+    int destroyed_before = RcuTestConfig::destroyed.load();
+    {
+        auto old = rcu.Read();
+        auto next = std::make_unique<RcuTestConfig>();
+        next->version = 1;
+        next->checksum = 3;
+        next->name = "v1";
+        rcu.Update(std::move(next));
+
+        // 旧快照仍被当前线程持有，不能回收
+        EXPECT_EQ(old->name, "v0");
+        EXPECT_EQ(rcu.PendingReclaim(), 1u);
+        {
+            auto nested = rcu.Read();
+            EXPECT_EQ(nested->name, "v1");
+        }
+        EXPECT_EQ(RcuTestConfig::destroyed.load(), destroyed_before);
+    }
+    rcu.Synchronize();
+    EXPECT_EQ(rcu.PendingReclaim(), 0u);
+    EXPECT_EQ(RcuTestConfig::destroyed.load(), destroyed_before + 1);
+
+    rcu.Modify([](RcuTestConfig& c) {
+        c.version = 2;
+        c.checksum = 5;
+        c.name = "v2";
+    });
+    EXPECT_EQ(rcu.Read()->name, "v2");
+    EXPECT_EQ(rcu.Version(), 2u);
+}
+
+// 压力测试：读者持续读取的同时写者每秒替换数千次，读者永远看不到已回收或不一致的版本
+TEST(SingletonTest, RcuSingleton_ReadersDuringContinuousSwaps) {
+    using Config = RcuSingleton<RcuTestConfig, RcuStressTag>;
+    auto& rcu = Config::Instance();
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    std::atomic<std::uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            std::uint64_t last = 0;
+            std::uint64_t local_reads = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto cfg = rcu.Read();
+                std::uint64_t v = cfg->version;
+                if (cfg->checksum != v * 2 + 1 || v < last ||
+                    cfg->name != "v" + std::to_string(v)) {
+                    bad.fetch_add(1, std::memory_order_relaxed);
+                }
+                last = v;
+                ++local_reads;
+            }
+            reads.fetch_add(local_reads, std::memory_order_relaxed);
+        });
+    }
+
+    // 写者在 300ms 内不间断地替换配置
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(300);
+    std::uint64_t swaps = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::uint64_t v = ++swaps;
+        auto next = std::make_unique<RcuTestConfig>();
+        next->version = v;
+        next->checksum = v * 2 + 1;
+        next->name = "v" + std::to_string(v);
+        rcu.Update(std::move(next));
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stop.store(true);
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(bad.load(), 0);
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_GT(static_cast<double>(swaps) / seconds, 1000.0);
+    rcu.Synchronize();
+    EXPECT_EQ(rcu.PendingReclaim(), 0u);
+    EXPECT_EQ(rcu.Read()->version, swaps);
+}
+
+// 服务注册表测试用的服务：记录构造时依赖是否已就绪
+struct StartupService {
+    explicit StartupService(int v) : value(v) {}
+    int value;
+};
+
+ServiceRegistry::Factory<StartupService> SleepingService(int value, int sleep_ms) {
+    return [value, sleep_ms](ServiceRegistry&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+        return std::make_unique<StartupService>(value);
+    };
+}
+
+// 测试服务注册表：依赖先于下游构造，工厂函数中可以取得依赖
+TEST(SingletonTest, ServiceRegistry_DependencyOrder) {
+    ServiceRegistry registry;
+    EXPECT_TRUE(registry.Register<StartupService>("config", {}, SleepingService(1, 5)));
+    EXPECT_TRUE(registry.Register<StartupService>("db", {"config"}, [](ServiceRegistry& r) {
+        StartupService* config = r.Get<StartupService>("config");
+        return std::make_unique<StartupService>(config != nullptr ? config->value + 10 : -1);
+    }));
+    EXPECT_TRUE(registry.Register<StartupService>("cache", {"db", "config"}, [](ServiceRegistry& r) {
+        StartupService* db = r.Get<StartupService>("db");
+        return std::make_unique<StartupService>(db != nullptr ? db->value + 100 : -1);
+    }));
+    EXPECT_FALSE(registry.Register<StartupService>("db", {}, SleepingService(0, 0)));
+
+    StartupReport report = registry.Start(4);
+    ASSERT_TRUE(report.ok) << report.error;
+    EXPECT_EQ(registry.Get<StartupService>("db")->value, 11);
+    EXPECT_EQ(registry.Get<StartupService>("cache")->value, 111);
+    EXPECT_EQ(registry.Get<int>("cache"), nullptr);      // 类型不符
+    EXPECT_EQ(registry.Get<StartupService>("x"), nullptr);  // 未注册
+    EXPECT_LE(report.services[0].end_ms, report.services[1].start_ms);
+    EXPECT_LE(report.services[1].end_ms, report.services[2].start_ms);
+    EXPECT_FALSE(registry.Start().ok);  // 只能启动一次
+}
+
+// 测试服务注册表：互不依赖的服务并发构造，关键路径是最长的依赖链
+TEST(SingletonTest, ServiceRegistry_ParallelStartupAndCriticalPath) {
+    ServiceRegistry registry;
+    registry.Register<StartupService>("a", {}, SleepingService(1, 40));
+    registry.Register<StartupService>("b", {}, SleepingService(2, 40));
+    registry.Register<StartupService>("c", {}, SleepingService(3, 40));
+    registry.Register<StartupService>("d", {"a"}, SleepingService(4, 40));
+    registry.Register<StartupService>("e", {"b", "c"}, SleepingService(5, 5));
+
+    StartupReport report = registry.Start(3);
+    ASSERT_TRUE(report.ok) << report.error;
+    EXPECT_GE(report.total_init_ms, 160.0);
+    EXPECT_LT(report.wall_ms, report.total_init_ms);  // 并发构造，比串行快
+    EXPECT_GE(report.wall_ms, report.critical_path_ms);
+    EXPECT_EQ(report.critical_path, (std::vector<std::string>{"a", "d"}));
+    EXPECT_TRUE(report.services[3].on_critical_path);
+    EXPECT_FALSE(report.services[4].on_critical_path);
+    EXPECT_NE(report.ToString().find("critical path: a -> d"), std::string::npos);
+}
+
+// 测试服务注册表：未知依赖与依赖环在报告中返回错误，不构造任何服务
+TEST(SingletonTest, ServiceRegistry_ReportsGraphErrors) {
+    ServiceRegistry missing;
+    missing.Register<StartupService>("a", {"nope"}, SleepingService(1, 0));
+    StartupReport report = missing.Start(2);
+    EXPECT_FALSE(report.ok);
+    EXPECT_NE(report.error.find("unknown service 'nope'"), std::string::npos);
+    EXPECT_EQ(missing.Get<StartupService>("a"), nullptr);
+
+    // 校验失败不算启动：补充缺失的依赖后可以再次 Start()
+    EXPECT_TRUE(missing.Register<StartupService>("nope", {}, SleepingService(2, 0)));
+    report = missing.Start(2);
+    EXPECT_TRUE(report.ok) << report.error;
+    ASSERT_NE(missing.Get<StartupService>("a"), nullptr);
+    EXPECT_FALSE(missing.Register<StartupService>("late", {}, SleepingService(3, 0)));
+    EXPECT_FALSE(missing.Start(2).ok);
+
+    ServiceRegistry cyclic;
+    cyclic.Register<StartupService>("root", {}, SleepingService(0, 0));
+    cyclic.Register<StartupService>("x", {"root", "z"}, SleepingService(1, 0));
+    cyclic.Register<StartupService>("y", {"x"}, SleepingService(2, 0));
+    cyclic.Register<StartupService>("z", {"y"}, SleepingService(3, 0));
+    report = cyclic.Start(2);
+    EXPECT_FALSE(report.ok);
+    EXPECT_NE(report.error.find("cycle"), std::string::npos);
+    EXPECT_EQ(report.error.find("'root'"), std::string::npos);
+    EXPECT_NE(report.error.find("'x'"), std::string::npos);
+    EXPECT_EQ(cyclic.Get<StartupService>("root"), nullptr);
+}
+
+// 测试服务注册表：工厂函数抛异常时下游被跳过，其余服务照常构造
+TEST(SingletonTest, ServiceRegistry_FailurePropagatesToDependents) {
+    ServiceRegistry registry;
+    registry.Register<StartupService>("ok", {}, SleepingService(1, 0));
+    registry.Register<StartupService>("bad", {}, [](ServiceRegistry&) -> std::unique_ptr<StartupService> {
+        throw std::runtime_error("disk not mounted");
+    });
+    registry.Register<StartupService>("downstream", {"bad", "ok"}, SleepingService(2, 0));
+
+    StartupReport report = registry.Start(2);
+    EXPECT_FALSE(report.ok);
+    EXPECT_NE(report.error.find("disk not mounted"), std::string::npos);
+    EXPECT_NE(registry.Get<StartupService>("ok"), nullptr);
+    EXPECT_EQ(registry.Get<StartupService>("downstream"), nullptr);
+    EXPECT_FALSE(report.services[2].constructed);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// 异步日志测试辅助：把 AsyncLogger 的输出重定向到管道，由后台线程读出全部内容
+class AsyncLogCapture {
+public:
+    // drain_now = false 时暂不读取管道：管道写满后后台线程阻塞，环形缓冲区必然被填满
+    explicit AsyncLogCapture(bool drain_now = true) {
+        if (pipe(fds_) != 0) {
+            fds_[0] = fds_[1] = -1;
+            return;
+        }
+        if (drain_now) {
+            StartDraining();
+        }
+        AsyncLogger::Instance().SetOutputFd(fds_[1]);
+    }
+
+    void StartDraining() {
+        reader_ = std::thread([this]() {
+            char buf[4096];
+            ssize_t n;
+            while ((n = read(fds_[0], buf, sizeof(buf))) > 0) {
+                captured_.append(buf, static_cast<std::size_t>(n));
+            }
+        });
+    }
+
+    // 排空日志、恢复标准输出并返回捕获到的全部文本
+    std::string Finish() {
+        if (!reader_.joinable()) {
+            StartDraining();
+        }
+        AsyncLogger::Instance().Flush();
+        AsyncLogger::Instance().SetOutputFd(STDOUT_FILENO);
+        close(fds_[1]);
+        reader_.join();
+        close(fds_[0]);
+        return captured_;
+    }
+
+private:
+    int fds_[2];
+    std::thread reader_;
+    std::string captured_;
+};
+
+static std::size_t CountOccurrences(const std::string& text, const std::string& needle) {
+    std::size_t count = 0;
+    for (auto pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// 测试异步日志后端：多线程提交的每条记录都完整写出
+TEST(SingletonTest, AsyncLogger_DeliversAllRecords) {
+    AsyncLogger::Instance().SetOverflowPolicy(OverflowPolicy::kBlock);
+    AsyncLogCapture capture;
+
+    const int num_threads = 4;
+    const int per_thread = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                AsyncLogger::Instance().Log("[Test] ", "thread " + std::to_string(t) + " record");
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::string output = capture.Finish();
+    EXPECT_EQ(CountOccurrences(output, "\n"), static_cast<std::size_t>(num_threads * per_thread));
+    for (int t = 0; t < num_threads; ++t) {
+        EXPECT_EQ(CountOccurrences(output, "[Test] thread " + std::to_string(t) + " record\n"),
+                  static_cast<std::size_t>(per_thread));
+    }
+}
+
+// 测试单例 Log() 切换到异步后端
+TEST(SingletonTest, AsyncLogger_BackendForSingletonLog) {
+    AsyncLogCapture capture;
+    SetSingletonLogBackend(LogBackend::kAsync);
+    MeyersSingleton::Instance().Log("routed through AsyncLogger");
+    HungrySingleton::Instance().Log("also async");
+    SetSingletonLogBackend(LogBackend::kStdout);
+
+    std::string output = capture.Finish();
+    EXPECT_NE(output.find("[Meyers] routed through AsyncLogger\n"), std::string::npos);
+    EXPECT_NE(output.find("[Hungry] also async\n"), std::string::npos);
+}
+
+// 测试溢出策略：队列写满后 kCount 丢弃并计数，kDrop 直接丢弃
+TEST(SingletonTest, AsyncLogger_OverflowPolicies) {
+    auto& logger = AsyncLogger::Instance();
+    AsyncLogCapture capture(false);
+    auto before = logger.GetStats();
+
+    // 管道暂不读取，一次性提交远超队列容量的记录
+    const std::size_t burst = AsyncLogger::kCapacity * 8;
+    std::size_t accepted = 0;
+    logger.SetOverflowPolicy(OverflowPolicy::kCount);
+    for (std::size_t i = 0; i < burst; ++i) {
+        accepted += logger.Log("[Burst] ", "counted overflow record") ? 1 : 0;
+    }
+    logger.SetOverflowPolicy(OverflowPolicy::kDrop);
+    for (std::size_t i = 0; i < burst; ++i) {
+        accepted += logger.Log("[Burst] ", "silent overflow record") ? 1 : 0;
+    }
+    logger.SetOverflowPolicy(OverflowPolicy::kBlock);
+
+    std::string output = capture.Finish();
+    auto after = logger.GetStats();
+    EXPECT_LT(accepted, 2 * burst);
+    EXPECT_GT(after.dropped, before.dropped);
+    EXPECT_EQ(CountOccurrences(output, "[Burst] "), accepted);
+    EXPECT_NE(output.find("[AsyncLogger] dropped "), std::string::npos);
+}
+
+// 测试 kCount 丢弃提示：多线程同时溢出，Flush() 返回时所有丢弃都已写成提示行，合计数与统计一致
+TEST(SingletonTest, AsyncLogger_FlushReportsEveryCountedDrop) {
+    auto& logger = AsyncLogger::Instance();
+    AsyncLogCapture capture;
+    const std::uint64_t before = logger.GetStats().dropped;
+
+    logger.SetOverflowPolicy(OverflowPolicy::kCount);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&logger]() {
+            for (std::size_t i = 0; i < AsyncLogger::kCapacity * 2; ++i) {
+                logger.Log("[Drop] ", "counted overflow record");
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    logger.SetOverflowPolicy(OverflowPolicy::kBlock);
+
+    std::string output = capture.Finish();
+    const std::uint64_t dropped = logger.GetStats().dropped - before;
+    const std::string note = "[AsyncLogger] dropped ";
+    std::uint64_t reported = 0;
+    for (auto pos = output.find(note); pos != std::string::npos; pos = output.find(note, pos + 1)) {
+        reported += std::stoull(output.substr(pos + note.size()));
+    }
+    EXPECT_EQ(reported, dropped);
+}
+
+// 测试空闲挂起：写完记录后后台线程挂起，空闲期间不再醒来，新记录会唤醒它并照常写出
+TEST(SingletonTest, AsyncLogger_ParksWhenIdleAndWakesOnLog) {
+    auto& logger = AsyncLogger::Instance();
+    AsyncLogCapture capture;
+    const std::uint64_t before = logger.GetStats().parks;
+    logger.Log("[Idle] ", "before park");  // 处理完这条之后必然再挂起一次
+    for (int i = 0; i < 1000 && logger.GetStats().parks == before; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const std::uint64_t parked = logger.GetStats().parks;
+    EXPECT_GT(parked, before);
+
+    // 没有新记录时一直挂起，不会周期性醒来
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(logger.GetStats().parks, parked);
+
+    logger.Log("[Idle] ", "after park");
+    std::string output = capture.Finish();
+    EXPECT_NE(output.find("[Idle] before park\n"), std::string::npos);
+    EXPECT_NE(output.find("[Idle] after park\n"), std::string::npos);
+}
+#endif
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();